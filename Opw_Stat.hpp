@@ -1,12 +1,12 @@
-//*************************************************************************************
-//  OPW_STAT.HPP
-//      This file contains the definition of the CWindowState class, which implements
-//      a transition-logic state that displays an operator window.  It's a "wrapper"
-//      for the operator window within a transition logic environment.
-//
-//  Version
-//      5-26-95   JR  Original version
-//*************************************************************************************
-
-
-
+//*************************************************************************************
+//  OPW_STAT.HPP
+//      This file contains the definition of the CWindowState class, which implements
+//      a transition-logic state that displays an operator window.  It's a "wrapper"
+//      for the operator window within a transition logic environment.
+//
+//  Version
+//      5-26-95   JR  Original version
+//*************************************************************************************
+
+
+
@@ -0,0 +1,410 @@
+//*************************************************************************************
+//  TR4_arry.cpp
+//      This file contains the implementation of task arrays, which run many instances
+//      of one transition logic machine in a single task.
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//*************************************************************************************
+
+#include <string.h>
+#include <TranRun4.hpp>
+
+
+//=====================================================================================
+//  Class: CArrayState
+//      One state of a task array's machine.
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+//  Constructor: CArrayState
+//      Save the name.  The state gets its number when it's added to a task array.
+
+CArrayState::CArrayState (const char* aName)
+    {
+    if ((Name = new char[strlen (aName) + 1]) != NULL)
+        strcpy (Name, aName);
+
+    StateNumber = -1;
+    pParent = NULL;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Destructor: ~CArrayState
+
+CArrayState::~CArrayState (void)
+    {
+    DELETE_ARRAY Name;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Functions: Entry, Action, and TransitionTest
+//      The default state functions do nothing, and no instance leaves the state.
+
+void CArrayState::Entry (const int*, int)
+    {
+    }
+
+void CArrayState::Action (const int*, int)
+    {
+    }
+
+void CArrayState::TransitionTest (const int*, int aCount, int* aNext)
+    {
+    for (int Index = 0; Index < aCount; Index++)
+        aNext[Index] = ARRAY_NO_TRANSITION;
+    }
+
+
+//=====================================================================================
+//  Class: CTaskArray
+//      Runs many instances of one machine, a state at a time.
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+//  Constructors: CTaskArray
+//      There's one constructor for each kind of task, taking the same arguments as
+//      the CTask constructor for that kind, then the number of instances.
+
+CTaskArray::CTaskArray (const char* aName, TaskType aType, int aInstances)
+    : CTask (aName, aType)
+    {
+    Configure (aInstances);
+    }
+
+CTaskArray::CTaskArray (const char* aName, TaskType aType, real_time aTimeInt,
+                        int aInstances)
+    : CTask (aName, aType, aTimeInt)
+    {
+    Configure (aInstances);
+    }
+
+CTaskArray::CTaskArray (const char* aName, TaskType aType, int aPriority,
+                        int aInstances)
+    : CTask (aName, aType, aPriority)
+    {
+    Configure (aInstances);
+    }
+
+CTaskArray::CTaskArray (const char* aName, TaskType aType, int aPriority,
+                        real_time aTimeInt, int aInstances)
+    : CTask (aName, aType, aPriority, aTimeInt)
+    {
+    Configure (aInstances);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Configure
+//      Allocate the per-instance arrays.  No instance has a state until the task
+//      first runs, when those which weren't given their own initial state are put in
+//      the task array's initial state.
+
+void CTaskArray::Configure (int aInstances)
+    {
+    int Index;                              //  Counts through instances
+
+    if (aInstances < 1)
+        TR_Exit ("Task array \"%s\" has no instances", GetName ());
+
+    NumInstances = (aInstances > 0) ? aInstances : 1;
+    States = NULL;
+    NumStates = 0;
+    ArraySize = 0;
+    InitialState = -1;
+    Start = NULL;
+    FirstRun = TRUE;
+    Transitions = 0L;
+
+    Current = new int[NumInstances];
+    Entering = new boolean[NumInstances];
+    Order = new int[NumInstances];
+    EnterList = new int[NumInstances];
+    NextState = new int[NumInstances];
+    if ((Current == NULL) || (Entering == NULL) || (Order == NULL)
+        || (EnterList == NULL) || (NextState == NULL))
+        {
+        TR_Exit ("Unable to allocate memory for task array \"%s\"", GetName ());
+        return;
+        }
+
+    for (Index = 0; Index < NumInstances; Index++)
+        {
+        Current[Index] = -1;
+        Entering[Index] = TRUE;
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Destructor: ~CTaskArray
+//      Delete the states along with the per-instance arrays, as a task deletes its
+//      states.
+
+CTaskArray::~CTaskArray (void)
+    {
+    for (int Index = 0; Index < NumStates; Index++)
+        delete States[Index];
+
+    DELETE_ARRAY States;
+    DELETE_ARRAY Start;
+    DELETE_ARRAY Current;
+    DELETE_ARRAY Entering;
+    DELETE_ARRAY Order;
+    DELETE_ARRAY EnterList;
+    DELETE_ARRAY NextState;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: AddState
+//      Add a state to the machine and return its number.  States are numbered from
+//      zero in the order in which they're added.  The first state added is the initial
+//      state unless another is chosen with SetInitialState().
+
+int CTaskArray::AddState (CArrayState* aState)
+    {
+    int Index;                              //  Counts through states
+
+    if (aState->pParent != NULL)
+        {
+        TR_Exit ("State \"%s\" added to more than one task array", aState->GetName ());
+        return (-1);
+        }
+
+    //  If the table is full, make a new one twice as big and copy the states into it.
+    //  The table of where each state's instances start grows along with it
+    if (NumStates >= ArraySize)
+        {
+        int NewSize = (ArraySize < 16) ? 16 : (ArraySize * 2);
+        CArrayState** NewStates = new CArrayState*[NewSize];
+        int* NewStart = new int[NewSize + 1];
+        if ((NewStates == NULL) || (NewStart == NULL))
+            {
+            TR_Exit ("Unable to allocate memory for %d states in task array \"%s\"",
+                     NewSize, GetName ());
+            return (-1);
+            }
+        for (Index = 0; Index < NumStates; Index++)
+            NewStates[Index] = States[Index];
+        DELETE_ARRAY States;
+        DELETE_ARRAY Start;
+        States = NewStates;
+        Start = NewStart;
+        ArraySize = NewSize;
+        }
+
+    aState->StateNumber = NumStates;
+    aState->pParent = this;
+    States[NumStates] = aState;
+
+    if (InitialState < 0)
+        InitialState = NumStates;
+
+    return (NumStates++);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: GetArrayState
+//      Return a pointer to the state with the given number, or NULL if there's none.
+
+CArrayState* CTaskArray::GetArrayState (int aState)
+    {
+    if ((aState < 0) || (aState >= NumStates))
+        return (NULL);
+
+    return (States[aState]);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Functions: SetInitialState
+//      Set the state in which all instances start, or the state in which one instance
+//      starts.  These must be called before the task first runs.
+
+void CTaskArray::SetInitialState (int aState)
+    {
+    if ((aState < 0) || (aState >= NumStates))
+        TR_Exit ("Task array \"%s\" has no state number %d", GetName (), aState);
+    else
+        InitialState = aState;
+    }
+
+void CTaskArray::SetInitialState (int aInstance, int aState)
+    {
+    if ((aInstance < 0) || (aInstance >= NumInstances))
+        TR_Exit ("Task array \"%s\" has no instance number %d", GetName (), aInstance);
+    else if ((aState < 0) || (aState >= NumStates))
+        TR_Exit ("Task array \"%s\" has no state number %d", GetName (), aState);
+    else
+        Current[aInstance] = aState;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: SetState
+//      Make one instance go to the given state, as though its TransitionTest() had
+//      called for it.  Its new state's Entry() function runs the next time the task
+//      array runs.  This may be used by other tasks, e.g. to break one machine down.
+
+void CTaskArray::SetState (int aInstance, int aState)
+    {
+    if ((aInstance < 0) || (aInstance >= NumInstances))
+        TR_Exit ("Task array \"%s\" has no instance number %d", GetName (), aInstance);
+    else if ((aState < 0) || (aState >= NumStates))
+        TR_Exit ("Task array \"%s\" has no state number %d", GetName (), aState);
+    else
+        {
+        if (FirstRun == FALSE)
+            Transitions++;
+        Current[aInstance] = aState;
+        Entering[aInstance] = TRUE;
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: CountInState
+//      Return how many instances are now in the given state.
+
+int CTaskArray::CountInState (int aState)
+    {
+    int Count = 0;                          //  Number of instances found in the state
+
+    for (int Index = 0; Index < NumInstances; Index++)
+        if (Current[Index] == aState)
+            Count++;
+
+    return (Count);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: SortInstances
+//      Sort the instances by their current states, with a counting sort.  The
+//      instances in each state are listed in Order from Start[state] up to (but not
+//      including) Start[state + 1], and their numbers go up in order.
+
+void CTaskArray::SortInstances (void)
+    {
+    int Index;                              //  Counts through instances
+    int StateNum;                           //  and through states
+    int Total;
+
+    for (StateNum = 0; StateNum <= NumStates; StateNum++)
+        Start[StateNum] = 0;
+    for (Index = 0; Index < NumInstances; Index++)
+        Start[Current[Index] + 1]++;
+    for (StateNum = 0, Total = 0; StateNum <= NumStates; StateNum++)
+        {
+        Total += Start[StateNum];
+        Start[StateNum] = Total;
+        }
+
+    //  Start[state] now tells where the state's instances begin.  Place each instance
+    //  at Start[its state] and move that on by one; afterwards each Start[state] tells
+    //  where the next state's instances begin, so shift them all back one place
+    for (Index = 0; Index < NumInstances; Index++)
+        Order[Start[Current[Index]]++] = Index;
+    for (StateNum = NumStates; StateNum > 0; StateNum--)
+        Start[StateNum] = Start[StateNum - 1];
+    Start[0] = 0;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Run
+//      Run all the instances through one scan.  For each state which has instances in
+//      it, Entry() runs for those which are entering it, Action() for all of them,
+//      then TransitionTest(); those which are to leave go to their next states, whose
+//      Entry() functions run the next time.  An instance which moves to another state
+//      isn't run again in the same scan.  The task then idles until its next run.
+
+void CTaskArray::Run (void)
+    {
+    int StateNum;                           //  Counts through states
+    int Index;                              //  and through instances in each state
+    int* pList;                             //  List of instances in one state
+    int Count;                              //  Number of instances in the list
+    int Entries;                            //  Number of those entering the state
+
+    //  The first time, put all the instances which haven't got a state yet into the
+    //  initial state
+    if (FirstRun == TRUE)
+        {
+        FirstRun = FALSE;
+
+        if (InitialState < 0)
+            {
+            TR_Exit ("No states specified for task array \"%s\"", GetName ());
+            return;
+            }
+        for (Index = 0; Index < NumInstances; Index++)
+            if (Current[Index] < 0)
+                Current[Index] = InitialState;
+        }
+
+    SortInstances ();
+
+    for (StateNum = 0; StateNum < NumStates; StateNum++)
+        {
+        pList = Order + Start[StateNum];
+        if ((Count = Start[StateNum + 1] - Start[StateNum]) == 0)
+            continue;
+
+        //  Find the instances which are entering this state and run Entry() for them
+        for (Index = 0, Entries = 0; Index < Count; Index++)
+            if (Entering[pList[Index]] == TRUE)
+                {
+                Entering[pList[Index]] = FALSE;
+                EnterList[Entries++] = pList[Index];
+                }
+        if (Entries > 0)
+            States[StateNum]->Entry (EnterList, Entries);
+
+        States[StateNum]->Action (pList, Count);
+
+        //  Run the transition test and move the instances which are leaving
+        for (Index = 0; Index < Count; Index++)
+            NextState[Index] = ARRAY_NO_TRANSITION;
+        States[StateNum]->TransitionTest (pList, Count, NextState);
+
+        for (Index = 0; Index < Count; Index++)
+            {
+            if (NextState[Index] == ARRAY_NO_TRANSITION)
+                continue;
+
+            if ((NextState[Index] < 0) || (NextState[Index] >= NumStates))
+                {
+                TR_Exit ("State \"%s\" of task array \"%s\" gave invalid next state %d",
+                         States[StateNum]->GetName (), GetName (), NextState[Index]);
+                return;
+                }
+            Current[pList[Index]] = NextState[Index];
+            Entering[pList[Index]] = TRUE;
+            Transitions++;
+            }
+        }
+
+    Idle ();
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: CheckpointData
+//      Save or restore the state of each instance.  A user's class which overrides
+//      this function to save its own arrays should call this one too.
+
+void CTaskArray::CheckpointData (CCheckpoint* aCheckpoint)
+    {
+    aCheckpoint->Count (NumInstances, "task array instances");
+    aCheckpoint->Count (NumStates, "task array states");
+    aCheckpoint->Data (&FirstRun, sizeof (boolean));
+    aCheckpoint->Data (&Transitions, sizeof (long));
+    aCheckpoint->Data (Current, NumInstances * sizeof (int));
+    aCheckpoint->Data (Entering, NumInstances * sizeof (boolean));
+    }
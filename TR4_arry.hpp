@@ -0,0 +1,137 @@
+//*************************************************************************************
+//  TR4_arry.hpp
+//      This is the header for task arrays, which run many copies of the same
+//      transition logic machine in one task.  A simulation of a fleet of identical
+//      machines could make one task per machine, each with its own state objects,
+//      but with thousands of machines each sweep would be thousands of task and state
+//      function calls.  A task array holds any number of "instances" of one machine
+//      instead.  The current state of every instance is kept in one array, and the
+//      user's class keeps each instance's data in arrays too, one array per variable,
+//      indexed by instance number.
+//
+//      The machine's states are CArrayState objects.  Each time the task array runs,
+//      the instances are sorted by their current states, and each state's Entry(),
+//      Action(), and TransitionTest() functions are called once with the list of all
+//      the instances which are in that state.  The state functions loop over the
+//      list; since the instance numbers in each list go up in order, and instances in
+//      the same state tend to stay together, these loops go through the data arrays
+//      in order and an optimizing compiler can often use vector instructions for them.
+//      TransitionTest() fills in the next state number of each instance in its list,
+//      or ARRAY_NO_TRANSITION for those which stay where they are.
+//
+//      Transitions of individual instances aren't written to the transition logic
+//      trace or the journal, as there would be far too many of them; a task array
+//      counts them instead.
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//*************************************************************************************
+
+#ifndef TR4_ARRY_HPP
+    #define  TR4_ARRY_HPP                   //  Variable to prevent multiple inclusions
+
+//  A state's TransitionTest() gives this as the next state of an instance which isn't
+//  making a transition
+#define  ARRAY_NO_TRANSITION  -1
+
+class CTaskArray;                           //  States belong to task arrays
+
+
+//=====================================================================================
+//  Class: CArrayState
+//      This is one state of a task array's machine.  The user derives a class from it
+//      and overrides the functions which the state needs.  Each is given a list of
+//      instance numbers and the length of the list.
+//=====================================================================================
+
+class CArrayState
+    {
+    private:
+        char* Name;                         //  Name of the state
+        int StateNumber;                    //  Number of the state in its task array
+        CTaskArray* pParent;                //  Task array to which the state belongs
+
+    public:
+        CArrayState (const char*);          //  Constructor is given the state's name
+        virtual ~CArrayState (void);
+
+        //  Functions which run instances entering and in the state, and find out which
+        //  instances are to leave it.  TransitionTest() fills in the next state number
+        //  for each instance in the list, in the same order
+        virtual void Entry (const int*, int);
+        virtual void Action (const int*, int);
+        virtual void TransitionTest (const int*, int, int*);
+
+        const char* GetName (void)          //  Get a pointer to the state's name
+            { return (Name); }
+        int GetStateNumber (void)           //  Find the number of this state
+            { return (StateNumber); }
+        CTaskArray* GetParent (void)        //  Find the task array which runs this
+            { return (pParent); }           //    state
+
+    friend class CTaskArray;
+    };
+
+
+//=====================================================================================
+//  Class: CTaskArray
+//      A task which runs many instances of one transition logic machine.  States are
+//      numbered from zero in the order in which they're added.  Every instance starts
+//      in the initial state, unless it's given its own initial state.
+//=====================================================================================
+
+class CTaskArray : public CTask
+    {
+    private:
+        int NumInstances;                   //  How many instances the task runs
+        CArrayState** States;               //  Table of the machine's states
+        int NumStates;                      //  How many states are in the table
+        int ArraySize;                      //  How many fit before the table must grow
+        int InitialState;                   //  State in which instances start
+        int* Current;                       //  Current state of each instance
+        boolean* Entering;                  //  TRUE if an instance is entering its
+                                            //    state and must run its Entry()
+        int* Order;                         //  Instances sorted by current state
+        int* Start;                         //  Where each state's instances begin in
+                                            //    the sorted list
+        int* EnterList;                     //  Instances which are entering a state
+        int* NextState;                     //  Next states from TransitionTest()
+        boolean FirstRun;                   //  TRUE until the task has first run
+        long Transitions;                   //  Count of all instances' transitions
+
+        void Configure (int);               //  Constructors call this to set up
+        void SortInstances (void);          //  Sort instances by current state
+
+    public:
+        CTaskArray (const char*, TaskType,  //  Constructor for continuous task arrays
+                    int);
+        CTaskArray (const char*, TaskType,  //  Constructor for timer interrupt task
+                    real_time, int);        //    arrays
+        CTaskArray (const char*, TaskType,  //  Constructor for event task arrays
+                    int, int);
+        CTaskArray (const char*, TaskType,  //  Constructor for sample time and
+                    int, real_time, int);   //    preemptible task arrays
+        virtual ~CTaskArray (void);
+
+        int AddState (CArrayState*);        //  Add a state and return its number
+        void SetInitialState (int);         //  Set initial state of all instances
+        void SetInitialState (int, int);    //  Set initial state of one instance
+        void SetState (int, int);           //  Make one instance go to a state
+
+        void Run (void);                    //  Run all instances through one scan
+        void CheckpointData (CCheckpoint*); //  Save or restore the instances' states
+
+        int GetNumInstances (void)          //  Find how many instances there are
+            { return (NumInstances); }
+        int GetNumStates (void)             //  Find how many states the machine has
+            { return (NumStates); }
+        CArrayState* GetArrayState (int);   //  Get a state by its number
+        int GetState (int aInstance)        //  Find the current state of an instance
+            { return (Current[aInstance]); }
+        int CountInState (int);             //  Find how many instances are in a state
+        long GetTransitions (void)          //  Find how many transitions have been
+            { return (Transitions); }       //    made by all the instances together
+    };
+
+#endif      //  End of multiple-inclusion protection
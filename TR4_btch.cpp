@@ -0,0 +1,300 @@
+//*************************************************************************************
+//  TR4_btch.cpp
+//      This file contains the implementation of the batch runner, which does a set of
+//      independent simulations with different parameters, several at a time, and
+//      gathers their results into one file.
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//*************************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <TranRun4.hpp>
+
+
+//=====================================================================================
+//  Class: CBatchRunner
+//      Runs a table of simulations on a pool of threads.
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+//  Constructor: CBatchRunner
+//      The constructor saves the user's run function and the number of parameters
+//      which each run is to be given.  The table of runs starts out empty.
+
+CBatchRunner::CBatchRunner (TR_BatchFunction aFunction, int aNumParams)
+    {
+    if (aFunction == NULL)
+        TR_Exit ("Batch runner needs a function to run");
+    if (aNumParams < 0)
+        TR_Exit ("Batch runner can't have %d parameters", aNumParams);
+
+    RunFunction = aFunction;
+    NumParams = aNumParams;
+    Runs = NULL;
+    NumRuns = 0;
+    ArraySize = 0;
+    NumThreads = BATCH_THREADS;
+    NextRun = 0;
+    pLock = new CMutex ();
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Destructor: ~CBatchRunner
+//      Delete each run's parameters and results logger, then the table itself.
+
+CBatchRunner::~CBatchRunner (void)
+    {
+    for (int Index = 0; Index < NumRuns; Index++)
+        {
+        DELETE_ARRAY Runs[Index].Params;
+        delete Runs[Index].pResults;
+        }
+    DELETE_ARRAY Runs;
+    delete pLock;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: AddRun
+//      This function adds one run to the table.  The parameters are copied, so the
+//      caller's array may be reused.  The run's number is returned; runs are numbered
+//      from zero in the order in which they were added.
+
+int CBatchRunner::AddRun (const double* aParams)
+    {
+    int Index;                              //  Counts through parameters and runs
+
+
+    //  If the table is full, make a new one twice as big and copy the runs into it
+    if (NumRuns >= ArraySize)
+        {
+        int NewSize = (ArraySize < 16) ? 16 : (ArraySize * 2);
+        TR_BatchRun* NewRuns = new TR_BatchRun[NewSize];
+        if (NewRuns == NULL)
+            TR_Exit ("Unable to allocate memory for %d batch runs", NewSize);
+        for (Index = 0; Index < NumRuns; Index++)
+            NewRuns[Index] = Runs[Index];
+        DELETE_ARRAY Runs;
+        Runs = NewRuns;
+        ArraySize = NewSize;
+        }
+
+    Runs[NumRuns].Params = new double[NumParams > 0 ? NumParams : 1];
+    for (Index = 0; Index < NumParams; Index++)
+        Runs[NumRuns].Params[Index] = aParams[Index];
+    Runs[NumRuns].pResults = NULL;
+    Runs[NumRuns].ReturnValue = 0;
+    Runs[NumRuns].Done = FALSE;
+
+    return (NumRuns++);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: AddRuns
+//      Add a whole table of runs at once.  The table is an array of doubles with one
+//      row for each run, each row holding that run's parameters.
+
+void CBatchRunner::AddRuns (int aHowMany, const double* aTable)
+    {
+    for (int Row = 0; Row < aHowMany; Row++)
+        AddRun (aTable + (Row * NumParams));
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: SetThreads
+//      Set the number of runs which will be done at the same time.  This should
+//      usually be the number of processors in the computer.
+
+void CBatchRunner::SetThreads (int aThreads)
+    {
+    if (aThreads < 1)
+        TR_Exit ("Batch runner needs at least one thread, not %d", aThreads);
+
+    NumThreads = aThreads;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: DoRun
+//      This function does one run in whatever thread calls it.  A new scheduler
+//      context is made for the run, so the run's TheMaster, TheTimer, and MainProcess
+//      are its own; the context is deleted (along with the run's processes and tasks)
+//      when the run function returns.  The results logger is kept.
+
+void CBatchRunner::DoRun (int aRun)
+    {
+    CSchedulerContext* pOldContext = GetCurrentContext ();
+    CSchedulerContext* pContext;
+    TR_BatchRun* pRun = Runs + aRun;
+
+    if ((pRun->pResults = new CDataLogger (LOG_EXPANDING, BATCH_LOG_SIZE)) == NULL)
+        TR_Exit ("Unable to create results logger for batch run %d", aRun);
+
+    pContext = new CSchedulerContext ();
+    pRun->ReturnValue = RunFunction (aRun, pRun->Params, pRun->pResults);
+    delete pContext;
+
+    //  Deleting the context left this thread with none; give back the old one
+    if (pOldContext != NULL)
+        pOldContext->MakeCurrent ();
+    pRun->Done = TRUE;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: WorkerMain
+//      This is the function which runs in each thread of the pool.  It keeps taking
+//      the next run which nobody has started yet until there are none left.
+
+void CBatchRunner::WorkerMain (void* aRunner)
+    {
+    CBatchRunner* pRunner = (CBatchRunner*)aRunner;
+    int MyRun;
+
+    for (;;)
+        {
+        pRunner->pLock->Lock ();
+        MyRun = pRunner->NextRun;
+        if (MyRun < pRunner->NumRuns)
+            pRunner->NextRun++;
+        pRunner->pLock->Unlock ();
+
+        if (MyRun >= pRunner->NumRuns)
+            break;
+        pRunner->DoRun (MyRun);
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Run
+//      This function does all the runs which haven't been done yet, and returns when
+//      they're finished.  It starts up a pool of threads (never more than there are
+//      runs to do) which share out the runs between them.  With one thread, or if
+//      there are no threads on this system, the runs are done one after another in
+//      the calling thread.
+
+void CBatchRunner::Run (void)
+    {
+    CThread** Workers;                      //  Array of threads in the pool
+    int HowMany;                            //  Number of threads to be used
+    int Index;
+
+    //  Find the first run which hasn't been done; more runs may have been added
+    //  since the last time Run() was called
+    for (NextRun = 0; (NextRun < NumRuns) && (Runs[NextRun].Done == TRUE); NextRun++);
+
+    HowMany = NumRuns - NextRun;
+    if (HowMany > NumThreads)
+        HowMany = NumThreads;
+
+    #if defined (TR_NO_THREADS)
+        HowMany = 1;
+    #endif
+
+    if (HowMany <= 1)
+        {
+        WorkerMain ((void*)this);
+        return;
+        }
+
+    Workers = new CThread*[HowMany];
+    for (Index = 0; Index < HowMany; Index++)
+        {
+        Workers[Index] = new CThread (WorkerMain, (void*)this);
+        Workers[Index]->Start ();
+        }
+    for (Index = 0; Index < HowMany; Index++)
+        {
+        Workers[Index]->Join ();
+        delete Workers[Index];
+        }
+    DELETE_ARRAY Workers;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Functions: GetResults and GetReturnValue
+//      These functions return the results logger of the given run (NULL if the run
+//      hasn't been done) and the value its function returned.
+
+CDataLogger* CBatchRunner::GetResults (int aRun)
+    {
+    if ((aRun < 0) || (aRun >= NumRuns))
+        TR_Exit ("There is no batch run number %d", aRun);
+
+    return (Runs[aRun].pResults);
+    }
+
+int CBatchRunner::GetReturnValue (int aRun)
+    {
+    if ((aRun < 0) || (aRun >= NumRuns))
+        TR_Exit ("There is no batch run number %d", aRun);
+
+    return (Runs[aRun].ReturnValue);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: WriteResults
+//      This function writes the results of all the runs into one file, in order of
+//      run number.  Each line of each run's results logger becomes a line in the file
+//      which begins with the run number and the run's parameters; the columns are
+//      separated with commas, so the file can be read by a spreadsheet or by Matlab.
+
+void CBatchRunner::WriteResults (const char* aFileName)
+    {
+    FILE* aFile;                            //  File to which results are written
+    CDataLogger* pLogger;                   //  Logger holding each run's results
+    CLogArray* pCol;                        //  Each column of data in that logger
+    unsigned Line;                          //  Counts through lines of data
+    int Index, Param;                       //  Count through runs and parameters
+
+
+    if ((aFile = fopen (aFileName, "w")) == NULL)
+        TR_Exit ("Can't open batch results file %s", aFileName);
+
+    //  Write a line of headers so a person can tell which column is which
+    fprintf (aFile, "Run");
+    for (Param = 0; Param < NumParams; Param++)
+        fprintf (aFile, ",Param %d", Param + 1);
+    for (Index = 0; (Index < NumRuns) && (Runs[Index].pResults == NULL); Index++);
+    if (Index < NumRuns)
+        {
+        Param = 0;
+        for (pCol = (CLogArray*)Runs[Index].pResults->GetHead (); pCol != NULL;
+             pCol = (CLogArray*)Runs[Index].pResults->GetNext ())
+            fprintf (aFile, ",Data %d", ++Param);
+        }
+    fprintf (aFile, "\n");
+
+    //  For each run, write each line of its results after its number and parameters
+    for (Index = 0; Index < NumRuns; Index++)
+        {
+        if ((pLogger = Runs[Index].pResults) == NULL)
+            continue;
+
+        for (pCol = (CLogArray*)pLogger->GetHead (); pCol != NULL;
+             pCol = (CLogArray*)pLogger->GetNext ())
+            pCol->ResetRead ();
+
+        for (Line = 0; Line < pLogger->GetNumLines (); Line++)
+            {
+            fprintf (aFile, "%d", Index);
+            for (Param = 0; Param < NumParams; Param++)
+                fprintf (aFile, ",%lg", Runs[Index].Params[Param]);
+            for (pCol = (CLogArray*)pLogger->GetHead (); pCol != NULL;
+                 pCol = (CLogArray*)pLogger->GetNext ())
+                fprintf (aFile, ",%s", pCol->GetData ());
+            fprintf (aFile, "\n");
+            }
+        }
+
+    fclose (aFile);
+    }
@@ -0,0 +1,93 @@
+//*************************************************************************************
+//  TR4_btch.hpp
+//      This is the header for the batch runner, which runs a whole set of simulations
+//      with different parameters.  Each simulation (a "run") gets its own scheduler
+//      context and its own results logger; several runs go on at the same time, each
+//      in a thread from a small pool.  When they're all done, the results are written
+//      to one file, each line marked with the number and parameters of its run.
+//
+//      Batch runs are meant for the simulated-time modes, TR_TIME_SIM in particular.
+//      The user's run function is just like UserMain():  it creates processes, tasks,
+//      and states, sets the tick and stop times, and calls TheMaster->Go().  It's also
+//      given its run number, its row of parameters, and a data logger in which to save
+//      results; it must call DefineData() for that logger before saving anything in it.
+//      To explore several branches from a point partway through a long simulation,
+//      save a checkpoint there once; then have the run function set up its tasks and
+//      call TheMaster->Restore() before Go(), so each run starts from that point.
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//*************************************************************************************
+
+#ifndef TR4_BTCH_HPP
+    #define  TR4_BTCH_HPP                   //  Variable to prevent multiple inclusions
+
+//  This is the type of the user's function which sets up and runs one simulation.  It
+//  gets the run number, that run's parameters, and a logger for the results, and it
+//  returns a value just as UserMain() does
+typedef int (*TR_BatchFunction)(int, const double*, CDataLogger*);
+
+//  Each run's results logger starts out with room for this many lines; it grows
+#define  BATCH_LOG_SIZE      256
+
+//  Unless the user says otherwise, this many runs are done at the same time
+#define  BATCH_THREADS       4
+
+
+//-------------------------------------------------------------------------------------
+//  Structure:  TR_BatchRun
+//      Here's what the batch runner keeps for each run:  the run's parameters, the
+//      logger which holds its results, and the value which its function returned.
+
+struct TR_BatchRun
+    {
+    double* Params;                         //  Parameters given to this run
+    CDataLogger* pResults;                  //  Logger holding the run's results
+    int ReturnValue;                        //  Value returned by the run function
+    boolean Done;                           //  TRUE once the run has finished
+    };
+
+
+//=====================================================================================
+//  Class: CBatchRunner
+//      The batch runner holds a table of parameters, one row per run.  Run() runs
+//      them all, handing each free thread the next run which hasn't been started;
+//      WriteResults() then writes the results of all the runs, in run order, to a
+//      file.  Since each run has a context of its own, the results don't depend on
+//      how many threads were used or which run finished first.
+//=====================================================================================
+
+class CBatchRunner
+    {
+    private:
+        TR_BatchFunction RunFunction;       //  User's function to run a simulation
+        int NumParams;                      //  Number of parameters in each run
+        TR_BatchRun* Runs;                  //  Array of runs to be done
+        int NumRuns;                        //  How many runs are in the array
+        int ArraySize;                      //  How many will fit before it must grow
+        int NumThreads;                     //  How many runs go at the same time
+        int NextRun;                        //  Next run for a free thread to do
+        CMutex* pLock;                      //  Protects NextRun while threads run
+
+        void DoRun (int);                   //  Do one run in the calling thread
+        static void WorkerMain (void*);     //  Function which runs in each thread
+
+    public:
+        CBatchRunner (TR_BatchFunction,     //  Constructor is given the function and
+                      int);                 //    number of parameters in each run
+        ~CBatchRunner (void);
+
+        int AddRun (const double*);         //  Add one run with given parameters
+        void AddRuns (int, const double*);  //  Add a table of runs, one per row
+        void SetThreads (int);              //  Set number of runs done at once
+        void Run (void);                    //  Do all the runs which haven't been
+
+        int GetNumRuns (void)               //  Find how many runs there are
+            { return (NumRuns); }
+        CDataLogger* GetResults (int);      //  Get the results logger for a run
+        int GetReturnValue (int);           //  Get value a run's function returned
+        void WriteResults (const char*);    //  Write all results to one file
+    };
+
+#endif      //  End of multiple-inclusion protection
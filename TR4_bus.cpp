@@ -0,0 +1,481 @@
+//*************************************************************************************
+//  TR4_bus.cpp
+//      This is the implementation of the publish/subscribe data bus used in the
+//      TranRun4 scheduler.  Topics are created by the master scheduler (see the
+//      AddTopic() and FindTopic() methods of CMaster) so that a producer and its
+//      consumers can find the same topic by name, whichever process they're in.
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//*************************************************************************************
+
+#include <stdlib.h>
+#include <string.h>
+#include <TranRun4.hpp>
+
+
+//=====================================================================================
+//  Class: CTopic
+//      A topic keeps a ring of preallocated slots.  The producer writes directly into
+//      a slot which no subscriber is holding and which doesn't contain the latest
+//      sample; subscribers read directly out of the slots.  Samples are identified by
+//      sequence numbers which begin at 1; a sequence number of 0 marks an empty slot
+//      or one which the producer is busy writing.
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+//  Constructors:  CTopic
+//      These constructors create a topic with the given name and sample size.  The
+//      first one uses a default number of slots; the second lets the user choose.
+
+CTopic::CTopic (const char* aName, unsigned aSize) : CBasicList ()
+    {
+    Configure (aName, aSize, BUS_DEFAULT_SLOTS);
+    }
+
+CTopic::CTopic (const char* aName, unsigned aSize, int aSlots) : CBasicList ()
+    {
+    Configure (aName, aSize, aSlots);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  Configure
+//      The constructors call this function to save the topic's name and allocate all
+//      the memory the topic will ever need.  Nothing is allocated while running.
+
+void CTopic::Configure (const char* aName, unsigned aSize, int aSlots)
+    {
+    //  A topic needs room for the latest sample plus one being written, at least
+    if ((aSize == 0) || (aSlots < 2))
+        TR_Exit ("Topic \"%s\" needs a nonzero size and 2 or more slots", aName);
+
+    //  Make some space and save the name of this object
+    if ((Name = new char[strlen (aName) + 1]) != NULL)
+        strcpy (Name, aName);
+
+    SampleSize = aSize;
+    NumSlots = aSlots;
+
+    //  Allocate one block for all the slots and arrays for the slots' bookkeeping
+    SlotData = new char[SampleSize * NumSlots];
+    RefCount = new int[NumSlots];
+    SlotSequence = new unsigned long[NumSlots];
+    if ((SlotData == NULL) || (RefCount == NULL) || (SlotSequence == NULL))
+        TR_Exit ("Unable to allocate memory for topic \"%s\"", aName);
+
+    for (int Slot = 0; Slot < NumSlots; Slot++)
+        {
+        RefCount[Slot] = 0;                 //  Nobody is reading any slot, and no
+        SlotSequence[Slot] = 0L;            //  slot holds a sample yet
+        }
+
+    PublishCount = 0L;                      //  Nothing has been published
+    LatestSlot = -1;                        //  so there's no latest sample
+    WriteSlot = -1;                         //  and the producer isn't writing one
+    NextWriteSlot = 0;
+
+    //  In parallel simulation, each pending sample holds a slot, so there can't be
+    //  more pending samples than slots
+    #if defined (TR_TIME_EXTSIM)
+        pLock = new CMutex ();
+        PendingSlots = new int[NumSlots];
+        NumPending = 0;
+    #endif
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Destructor:  ~CTopic
+//      This destructor deletes the subscriber objects and frees the slot memory.
+
+CTopic::~CTopic (void)
+    {
+    for (CSubscriber* pCur = (CSubscriber*)GetHead (); pCur != NULL;
+         pCur = (CSubscriber*)GetNext ())
+        delete pCur;
+
+    DELETE_ARRAY SlotData;
+    DELETE_ARRAY RefCount;
+    DELETE_ARRAY SlotSequence;
+    DELETE_ARRAY Name;
+    #if defined (TR_TIME_EXTSIM)
+        DELETE_ARRAY PendingSlots;
+        delete pLock;
+    #endif
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Functions:  LockSlots and UnlockSlots
+//      The slots' reference counts and sequence numbers are changed only between
+//      calls to these functions.  Normally that means with interrupts disabled, so
+//      a pre-empting task can't see them half changed; in parallel simulation mode,
+//      it means holding the topic's mutex, as other processes run in other threads.
+
+void CTopic::LockSlots (void)
+    {
+    #if defined (TR_TIME_EXTSIM)
+        pLock->Lock ();
+    #else
+        DisableInterrupts ();
+    #endif
+    }
+
+void CTopic::UnlockSlots (void)
+    {
+    #if defined (TR_TIME_EXTSIM)
+        pLock->Unlock ();
+    #else
+        EnableInterrupts ();
+    #endif
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  BeginPublish
+//      The producer calls this function to get a pointer to a slot into which it can
+//      write a new sample.  The slot chosen is one which no subscriber holds and
+//      which doesn't contain the latest sample, so readers are never disturbed.  If
+//      every slot is held (the ring is too small for the number of readers), NULL is
+//      returned and the producer should skip this sample.
+
+void* CTopic::BeginPublish (void)
+    {
+    int Slot;                               //  Index of slot being checked
+
+    //  If the producer is already holding a slot, just give it the same one again
+    if (WriteSlot >= 0)
+        return ((void*)(SlotData + (WriteSlot * SampleSize)));
+
+    //  Search the ring for a free slot, beginning after the one last written
+    LockSlots ();
+    for (int Count = 0; Count < NumSlots; Count++)
+        {
+        Slot = (NextWriteSlot + Count) % NumSlots;
+        if ((RefCount[Slot] == 0) && (Slot != LatestSlot))
+            {
+            WriteSlot = Slot;
+            SlotSequence[Slot] = 0L;        //  Readers mustn't see a half-written slot
+            NextWriteSlot = (Slot + 1) % NumSlots;
+            break;
+            }
+        }
+    UnlockSlots ();
+
+    if (WriteSlot < 0)
+        return (NULL);
+
+    return ((void*)(SlotData + (WriteSlot * SampleSize)));
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  EndPublish
+//      After writing a sample into the slot given by BeginPublish(), the producer
+//      calls this function.  The sample gets the next sequence number and becomes the
+//      latest sample.  Any subscribing event tasks are then triggered.
+
+void CTopic::EndPublish (void)
+    {
+    if (WriteSlot < 0)                      //  If BeginPublish() wasn't called or
+        return;                             //  failed, there's nothing to publish
+
+    //  In parallel simulation, save the slot in the pending list to be committed at
+    //  the end of the time window.  The pending sample holds its slot the way a
+    //  reader would, so the producer won't pick that slot to write in again
+    #if defined (TR_TIME_EXTSIM)
+        LockSlots ();
+        RefCount[WriteSlot]++;
+        PendingSlots[NumPending++] = WriteSlot;
+        UnlockSlots ();
+    #else
+        MakeLatest (WriteSlot);
+    #endif
+
+    WriteSlot = -1;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  MakeLatest
+//      This function gives the sample in a slot the next sequence number, making it
+//      the latest sample, and triggers any subscribing event tasks.
+
+void CTopic::MakeLatest (int aSlot)
+    {
+    LockSlots ();
+    SlotSequence[aSlot] = ++PublishCount;
+    LatestSlot = aSlot;
+    UnlockSlots ();
+
+    //  Let subscribing tasks know there's new data.  TriggerEvent() does nothing to
+    //  tasks which aren't event tasks or which already have an event pending
+    for (CSubscriber* pCur = (CSubscriber*)GetHead (); pCur != NULL;
+         pCur = (CSubscriber*)GetNext ())
+        {
+        if (pCur->GetTask () != NULL)
+            pCur->GetTask ()->TriggerEvent ();
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  CommitPending
+//      In parallel simulation mode, the master calls this function at the end of each
+//      time window, when no process threads are running.  The samples published
+//      during the window become visible in the order in which they were published.
+
+#if defined (TR_TIME_EXTSIM)
+void CTopic::CommitPending (void)
+    {
+    for (int Index = 0; Index < NumPending; Index++)
+        {
+        RefCount[PendingSlots[Index]]--;
+        MakeLatest (PendingSlots[Index]);
+        }
+    NumPending = 0;
+    }
+#endif
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  Publish
+//      This convenience function copies a sample from the caller's buffer into a free
+//      slot and publishes it.  It returns FALSE if all went well and TRUE if no free
+//      slot could be found, following the convention used by CTask::TriggerEvent().
+
+boolean CTopic::Publish (const void* aData)
+    {
+    void* pSlot;                            //  Slot into which the data goes
+
+    if ((pSlot = BeginPublish ()) == NULL)
+        return (TRUE);
+
+    memcpy (pSlot, aData, SampleSize);
+    EndPublish ();
+    return (FALSE);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Functions:  Subscribe and Unsubscribe
+//      Subscribe() creates a new reader for this topic.  If a task is given, that
+//      task will be triggered whenever a sample is published; this is only useful for
+//      event tasks.  The topic owns its subscribers; Unsubscribe() deletes one.
+
+CSubscriber* CTopic::Subscribe (void)
+    {
+    return (Subscribe ((CTask*)NULL));
+    }
+
+CSubscriber* CTopic::Subscribe (CTask* aTask)
+    {
+    CSubscriber* pNew = new CSubscriber (this, aTask);
+
+    CBasicList::Insert ((void*)pNew);
+    return (pNew);
+    }
+
+void CTopic::Unsubscribe (CSubscriber* aSub)
+    {
+    CBasicList::Remove ((void*)aSub);
+    delete aSub;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  DumpStatus
+//      This function writes a few lines about the topic and its subscribers to the
+//      given file.  It's intended for diagnostic use, like the tasks' DumpStatus().
+
+void CTopic::DumpStatus (FILE* aFile)
+    {
+    int Holders = 0;                        //  Number of slots held by readers
+
+    for (int Slot = 0; Slot < NumSlots; Slot++)
+        if (RefCount[Slot] > 0)  Holders++;
+
+    fprintf (aFile, "        Topic: %-18s  Size: %-6u  Slots: %d (%d held)\n",
+             Name, SampleSize, NumSlots, Holders);
+    fprintf (aFile, "        Published: %lu  Subscribers: %d\n",
+             PublishCount, HowMany ());
+
+    CSubscriber* pCur;
+    for (pCur = (CSubscriber*)GetHead (); pCur != NULL;
+         pCur = (CSubscriber*)GetNext ())
+        {
+        fprintf (aFile, "            Task: %-18s  Missed: %lu\n",
+                 (pCur->GetTask () == NULL) ? "-" : pCur->GetTask ()->GetName (),
+                 pCur->GetMissedCount ());
+        }
+    fprintf (aFile, "\n");
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  Checkpoint
+//      This function saves or restores the topic's slots, their bookkeeping, and each
+//      subscriber's place in the topic.  Subscribers are saved in the order in which
+//      they subscribed, so the program restoring the checkpoint must subscribe to the
+//      topics in the same order as the one which saved it.
+
+void CTopic::Checkpoint (CCheckpoint* aCheckpoint)
+    {
+    CSubscriber* pCur;                      //  Each subscriber to this topic
+
+    aCheckpoint->Name (Name);
+    aCheckpoint->Count ((int)SampleSize, "bytes per sample");
+    aCheckpoint->Count (NumSlots, "slots");
+    aCheckpoint->Data (SlotData, SampleSize * NumSlots);
+    aCheckpoint->Data (RefCount, NumSlots * sizeof (int));
+    aCheckpoint->Data (SlotSequence, NumSlots * sizeof (unsigned long));
+    aCheckpoint->Data (&PublishCount, sizeof (unsigned long));
+    aCheckpoint->Data (&LatestSlot, sizeof (int));
+    aCheckpoint->Data (&WriteSlot, sizeof (int));
+    aCheckpoint->Data (&NextWriteSlot, sizeof (int));
+
+    aCheckpoint->Count (HowMany (), "subscribers");
+    for (pCur = (CSubscriber*)GetHead (); pCur != NULL;
+         pCur = (CSubscriber*)GetNext ())
+        pCur->Checkpoint (aCheckpoint);
+    }
+
+
+//=====================================================================================
+//  Class: CSubscriber
+//      A subscriber reads samples from a topic in place.  It can either jump to the
+//      newest sample (the usual case for control loops, which only care about the
+//      latest measurement) or step through the samples in order, in which case it
+//      keeps count of any samples which were overwritten before it got to them.
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+//  Constructor:  CSubscriber
+//      The subscriber starts out with its cursor pointing at the latest sample, if
+//      there is one, so that a new reader doesn't count old samples as missed ones.
+
+CSubscriber::CSubscriber (CTopic* aTopic, CTask* aTask)
+    {
+    pTopic = aTopic;
+    pTask = aTask;
+    HeldSlot = -1;
+    MissedCount = 0L;
+    ReadCursor = (aTopic->PublishCount > 0L) ? aTopic->PublishCount : 1L;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Destructor:  ~CSubscriber
+//      If the subscriber is holding a slot, let it go so the producer can reuse it.
+
+CSubscriber::~CSubscriber (void)
+    {
+    Release ();
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  Read
+//      This function returns a pointer to the newest sample in the topic if that
+//      sample hasn't been read by this subscriber yet; otherwise it returns NULL.
+//      Older unread samples are skipped.  The slot is held until Release() is called
+//      or another sample is read, so the data can be used without copying it.
+
+const void* CSubscriber::Read (void)
+    {
+    int Slot;                               //  Slot containing the newest sample
+
+    Release ();                             //  Let go of the previous sample
+
+    pTopic->LockSlots ();
+    Slot = pTopic->LatestSlot;
+    if ((Slot < 0) || (pTopic->SlotSequence[Slot] < ReadCursor))
+        {
+        pTopic->UnlockSlots ();
+        return (NULL);
+        }
+    pTopic->RefCount[Slot]++;
+    ReadCursor = pTopic->SlotSequence[Slot] + 1L;
+    HeldSlot = Slot;
+    pTopic->UnlockSlots ();
+
+    return ((const void*)(pTopic->SlotData + (Slot * pTopic->SampleSize)));
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  ReadNext
+//      This function returns a pointer to the oldest sample which this subscriber
+//      hasn't read yet, or NULL if it's up to date.  If the producer has overwritten
+//      samples before we got to them, they're added to the missed-sample count.
+
+const void* CSubscriber::ReadNext (void)
+    {
+    int Best = -1;                          //  Slot with oldest unread sample
+    unsigned long Sequence;                 //  Sequence number of sample in a slot
+
+    Release ();
+
+    pTopic->LockSlots ();
+    for (int Slot = 0; Slot < pTopic->NumSlots; Slot++)
+        {
+        Sequence = pTopic->SlotSequence[Slot];
+        if ((Sequence != 0L) && (Sequence >= ReadCursor)
+            && ((Best < 0) || (Sequence < pTopic->SlotSequence[Best])))
+            Best = Slot;
+        }
+    if (Best < 0)
+        {
+        pTopic->UnlockSlots ();
+        return (NULL);
+        }
+
+    Sequence = pTopic->SlotSequence[Best];
+    MissedCount += Sequence - ReadCursor;
+    ReadCursor = Sequence + 1L;
+    pTopic->RefCount[Best]++;
+    HeldSlot = Best;
+    pTopic->UnlockSlots ();
+
+    return ((const void*)(pTopic->SlotData + (Best * pTopic->SampleSize)));
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  Release
+//      This function lets go of the slot which the subscriber was reading, if any.
+
+void CSubscriber::Release (void)
+    {
+    if (HeldSlot >= 0)
+        {
+        pTopic->LockSlots ();
+        pTopic->RefCount[HeldSlot]--;
+        pTopic->UnlockSlots ();
+        HeldSlot = -1;
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  NewDataAvailable
+//      Returns TRUE if a sample has been published which this subscriber hasn't read.
+
+boolean CSubscriber::NewDataAvailable (void)
+    {
+    return ((pTopic->PublishCount >= ReadCursor) ? TRUE : FALSE);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  Checkpoint
+//      Save or restore the subscriber's place in its topic.
+
+void CSubscriber::Checkpoint (CCheckpoint* aCheckpoint)
+    {
+    aCheckpoint->Data (&ReadCursor, sizeof (unsigned long));
+    aCheckpoint->Data (&MissedCount, sizeof (unsigned long));
+    aCheckpoint->Data (&HeldSlot, sizeof (int));
+    }
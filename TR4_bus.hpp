@@ -0,0 +1,134 @@
+//*************************************************************************************
+//  TR4_bus.hpp
+//      This is the header for the publish/subscribe data bus used in the TranRun4
+//      scheduler.  A topic holds a small ring of preallocated slots; a producer
+//      writes a sample directly into a free slot and any number of subscribers, in
+//      any process, read the sample in place instead of each getting its own copy.
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//*************************************************************************************
+
+#ifndef TR4_BUS_HPP
+    #define  TR4_BUS_HPP                    //  Variable to prevent multiple inclusions
+
+//  This is the number of slots in a topic's ring if the user doesn't specify any.
+//  There must be enough slots that the producer can find a free one while each of
+//  the subscribers is holding a sample and one more sample is the latest published
+#define  BUS_DEFAULT_SLOTS   8
+
+//  Forward declarations; subscribers and topics refer to each other and to tasks
+class CTask;
+class CTopic;
+
+
+//=====================================================================================
+//  Class: CSubscriber
+//      A subscriber is one reader of a topic.  It keeps its own read cursor, which is
+//      the sequence number of the next sample it hasn't yet seen, and it may hold one
+//      slot at a time.  While a slot is held the producer won't write over it, so
+//      the pointer returned by Read() or ReadNext() stays valid until Release() or
+//      the next call to a read function.
+//=====================================================================================
+
+class CSubscriber
+    {
+    private:
+        CTopic* pTopic;                     //  Topic to which we're subscribed
+        CTask* pTask;                       //  Task triggered on publish, or NULL
+        unsigned long ReadCursor;           //  Sequence number of next unread sample
+        unsigned long MissedCount;          //  Samples overwritten before we read them
+        int HeldSlot;                       //  Slot we're reading now; -1 means none
+
+    public:
+        CSubscriber (CTopic*, CTask*);      //  Constructor is called by the topic
+        ~CSubscriber (void);                //  Destructor releases any held slot
+
+        const void* Read (void);            //  Get newest sample, skipping old ones
+        const void* ReadNext (void);        //  Get the oldest sample not yet read
+        void Release (void);                //  Let the producer reuse the held slot
+        boolean NewDataAvailable (void);    //  TRUE if there's a sample not yet read
+        void Checkpoint (CCheckpoint*);     //  Save or restore place in the topic
+        unsigned long GetMissedCount (void) //  Function returns number of samples
+            { return (MissedCount); }       //    which were lost to a slow reader
+        CTask* GetTask (void)               //  Returns pointer to the task which is
+            { return (pTask); }             //    triggered by publication, if any
+    };
+
+
+//=====================================================================================
+//  Class: CTopic
+//      A topic is a named channel on the bus with a fixed sample size.  Its memory is
+//      allocated once, when the topic is created, as one block holding all the slots.
+//      Each slot has a reference count of the subscribers which are reading it and a
+//      sequence number telling which sample it holds.  Bookkeeping is done with
+//      interrupts disabled, but the copying of data into and out of slots is not,
+//      so publishing a large sample doesn't hold off pre-emption.
+//
+//      In parallel simulation mode (TR_TIME_EXTSIM), processes run in different
+//      threads, so the bookkeeping is protected by a mutex instead.  A published
+//      sample is also held back until the end of the current time window, when the
+//      master commits it; this way what each subscriber sees doesn't depend on how
+//      fast the threads happened to run, and every run gives the same results.
+//=====================================================================================
+
+class CTopic : public CBasicList
+    {
+    private:
+        char* Name;                         //  Name of this topic
+        unsigned SampleSize;                //  Size of one sample in bytes
+        int NumSlots;                       //  Number of slots in the ring
+        char* SlotData;                     //  Block of memory holding all the slots
+        int* RefCount;                      //  Number of readers holding each slot
+        unsigned long* SlotSequence;        //  Sequence number of sample in each slot
+        unsigned long PublishCount;         //  Number of samples published so far
+        int LatestSlot;                     //  Slot holding newest sample, or -1
+        int WriteSlot;                      //  Slot reserved by producer, or -1
+        int NextWriteSlot;                  //  Where the search for a free slot starts
+        #if defined (TR_TIME_EXTSIM)
+            CMutex* pLock;                  //  Protects bookkeeping between threads
+            int* PendingSlots;              //  Slots published during this window
+            int NumPending;                 //  How many slots are waiting to commit
+        #endif
+
+        void Configure (const char*, unsigned, int);
+        void LockSlots (void);              //  Begin and end a section in which the
+        void UnlockSlots (void);            //    slots' bookkeeping may be changed
+        void MakeLatest (int);              //  Make a slot's sample the newest one
+
+    public:
+        CTopic (const char*, unsigned);     //  Constructor with default ring size
+        CTopic (const char*, unsigned, int);//  Constructor given number of slots
+        ~CTopic (void);                     //  Destructor deletes the subscribers
+
+        //  Producer side:  BeginPublish() returns a pointer to a free slot into which
+        //  the sample is written; EndPublish() makes it visible to all subscribers and
+        //  triggers their event tasks.  Publish() does both, copying from a buffer.
+        void* BeginPublish (void);
+        void EndPublish (void);
+        boolean Publish (const void*);
+
+        //  Subscriber side:  Create a reader for this topic.  If a task is given, it
+        //  will be triggered each time a sample is published (if it's an event task)
+        CSubscriber* Subscribe (void);
+        CSubscriber* Subscribe (CTask*);
+        void Unsubscribe (CSubscriber*);
+
+        const char* GetName (void)          //  Function returns a pointer to the
+            { return (Name); }              //    name of this topic
+        unsigned GetSampleSize (void)       //  Function returns the size in bytes
+            { return (SampleSize); }        //    of each sample in the topic
+        unsigned long GetPublishCount (void)//  Returns the number of samples which
+            { return (PublishCount); }      //    have been published to this topic
+        void DumpStatus (FILE*);            //  Write status of topic for diagnostics
+        void Checkpoint (CCheckpoint*);     //  Save or restore samples and readers
+        #if defined (TR_TIME_EXTSIM)
+            void CommitPending (void);      //  Publish samples held to window's end
+        #endif
+
+    //  Subscribers need to find and hold the slots in which samples are kept
+    friend class CSubscriber;
+    };
+
+#endif      //  End of multiple-inclusion protection
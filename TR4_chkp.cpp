@@ -0,0 +1,211 @@
+//*************************************************************************************
+//  TR4_chkp.cpp
+//      This file contains the implementation of the checkpoint class, which saves the
+//      state of a simulation to a file and restores it again later.
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//*************************************************************************************
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <TranRun4.hpp>
+
+
+//-------------------------------------------------------------------------------------
+//  Checkpoint File Header
+//      Each checkpoint file begins with these four characters, then one byte each
+//      giving the sizes of a real_time, a long, an int, and an unsigned.  The data is
+//      saved in binary, so a checkpoint can only be restored by a program which was
+//      compiled with the same sizes.
+
+static const char CheckpointTag[] = "TR4C";
+
+
+//=====================================================================================
+//  Class: CCheckpoint
+//      Saves and restores the items which make up a checkpoint.
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+//  Constructor: CCheckpoint
+//      Open the checkpoint file for writing or reading.  When saving, the header is
+//      written; when restoring, it's checked.
+
+CCheckpoint::CCheckpoint (const char* aFileName, CheckpointMode aMode)
+    {
+    char Header[8];                         //  Tag and data sizes at top of file
+
+    Mode = aMode;
+    Failed = FALSE;
+    if ((FileName = new char[strlen (aFileName) + 1]) != NULL)
+        strcpy (FileName, aFileName);
+
+    if (Mode == CHECKPOINT_SAVE)
+        CheckpointFile = fopen (aFileName, "wb");
+    else
+        CheckpointFile = fopen (aFileName, "rb");
+    if (CheckpointFile == NULL)
+        {
+        Fail ("Can't open checkpoint file %s", aFileName);
+        return;
+        }
+
+    memcpy (Header, CheckpointTag, 4);
+    Header[4] = (char)sizeof (real_time);
+    Header[5] = (char)sizeof (long);
+    Header[6] = (char)sizeof (int);
+    Header[7] = (char)sizeof (unsigned);
+    if (Mode == CHECKPOINT_SAVE)
+        Data (Header, 8);
+    else
+        {
+        Data (Header, 8);                   //  This reads over the sizes we put in
+        if (memcmp (Header, CheckpointTag, 4) != 0)
+            Fail ("File %s is not a scheduler checkpoint", aFileName);
+        else if ((Header[4] != (char)sizeof (real_time))
+                 || (Header[5] != (char)sizeof (long))
+                 || (Header[6] != (char)sizeof (int))
+                 || (Header[7] != (char)sizeof (unsigned)))
+            Fail ("Checkpoint %s was made by a program with different data sizes",
+                  aFileName);
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Destructor: ~CCheckpoint
+//      Close the checkpoint file.
+
+CCheckpoint::~CCheckpoint (void)
+    {
+    if (CheckpointFile != NULL)
+        fclose (CheckpointFile);
+    DELETE_ARRAY FileName;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Fail
+//      When something goes wrong, this function passes the complaint to TR_Exit(),
+//      then closes the file so nothing more is written or read.  The master checks
+//      HasFailed() so that it won't run tasks which were only partly restored.
+
+void CCheckpoint::Fail (const char* aFormat, ...)
+    {
+    va_list Arguments;                      //  The arguments after the format
+    char Message[256];                      //  Complaint with arguments filled in
+
+    va_start (Arguments, aFormat);
+    vsprintf (Message, aFormat, Arguments);
+    va_end (Arguments);
+    TR_Exit ("%s", Message);
+
+    if (CheckpointFile != NULL)
+        fclose (CheckpointFile);
+    CheckpointFile = NULL;
+    Failed = TRUE;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Data
+//      Write a block of memory to the file, or read the block back from the file into
+//      the same place.  If the file runs out while restoring, the checkpoint must have
+//      been made by a different program (or never finished), so we stop.
+
+void CCheckpoint::Data (void* aData, unsigned aSize)
+    {
+    if ((CheckpointFile == NULL) || (aSize == 0))
+        return;
+
+    if (Mode == CHECKPOINT_SAVE)
+        {
+        if (fwrite (aData, 1, aSize, CheckpointFile) != aSize)
+            Fail ("Unable to write checkpoint file %s", FileName);
+        }
+    else
+        {
+        if (fread (aData, 1, aSize, CheckpointFile) != aSize)
+            Fail ("Checkpoint file %s ends too soon", FileName);
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Name
+//      Save the name of a process, task, state, or topic.  When restoring, the name
+//      which was saved must be the same as that of the object into which the data
+//      is going to be read, or the checkpoint doesn't belong to this program.
+
+void CCheckpoint::Name (const char* aName)
+    {
+    char SavedName[128];                    //  Name read back from the file
+    int Length;                             //  Length of the name, without the '\0'
+    int SavedLength;                        //  Length of the name in the file
+
+    if (Failed == TRUE)
+        return;
+
+    //  Very long names are cut short; the first part is enough to check them
+    Length = strlen (aName);
+    if (Length >= (int)sizeof (SavedName))
+        Length = sizeof (SavedName) - 1;
+
+    SavedLength = Length;
+    Data (&SavedLength, sizeof (int));
+    if (Mode == CHECKPOINT_SAVE)
+        Data ((void*)aName, Length);
+    else
+        {
+        if ((SavedLength < 0) || (SavedLength >= (int)sizeof (SavedName)))
+            Fail ("Checkpoint file %s is damaged", FileName);
+        Data (SavedName, SavedLength);
+        SavedName[SavedLength] = '\0';
+        if ((SavedLength != Length) || (strncmp (SavedName, aName, Length) != 0))
+            Fail ("Checkpoint %s has \"%s\" where this program has \"%s\"",
+                  FileName, SavedName, aName);
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Count
+//      Save the number of items in a list, or make sure that the list in this
+//      program has the same number of items as the one which was saved.
+
+void CCheckpoint::Count (int aCount, const char* aWhat)
+    {
+    int SavedCount = aCount;                //  Number which was saved in the file
+
+    Data (&SavedCount, sizeof (int));
+    if ((Mode == CHECKPOINT_RESTORE) && (Failed == FALSE) && (SavedCount != aCount))
+        Fail ("Checkpoint %s has %d %s where this program has %d",
+              FileName, SavedCount, aWhat, aCount);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Logger
+//      Save all the data in a data logger, or load it back into the logger.  The
+//      logger must have been set up with DefineData() in the same way as the one
+//      which was saved.
+
+void CCheckpoint::Logger (CDataLogger* aLogger)
+    {
+    boolean Result;                         //  TRUE if the data was saved or loaded
+
+    if (CheckpointFile == NULL)
+        return;
+
+    if (Mode == CHECKPOINT_SAVE)
+        Result = aLogger->SaveContents (CheckpointFile);
+    else
+        Result = aLogger->LoadContents (CheckpointFile);
+
+    if (Result == FALSE)
+        Fail ("Unable to %s data logger in checkpoint %s",
+              (Mode == CHECKPOINT_SAVE) ? "save" : "restore", FileName);
+    }
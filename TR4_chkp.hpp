@@ -0,0 +1,73 @@
+//*************************************************************************************
+//  TR4_chkp.hpp
+//      This is the header for checkpoints.  A checkpoint is a file holding everything
+//      a simulation would need to carry on from where it was:  the time, the status
+//      of each task, the state each task is in, the data on the bus, the profilers'
+//      data, and the transition trace.  A long simulation can be saved partway, then
+//      restored again and again to try different things from that point on, without
+//      having to run the first part over each time.
+//
+//      A checkpoint can only be restored into a program which has set up the same
+//      processes, tasks, states, and topics, in the same order, as the program which
+//      saved it; the names are checked as they're read.  Tasks and states which keep
+//      data of their own (positions, velocities, counters, data loggers...) should
+//      override CheckpointData() and pass each item to the checkpoint:
+//
+//          void CPlantTask::CheckpointData (CCheckpoint* aCheckpoint)
+//              {
+//              aCheckpoint->Data (&Position, sizeof (Position));
+//              aCheckpoint->Data (&Velocity, sizeof (Velocity));
+//              aCheckpoint->Logger (PlantLogger);
+//              }
+//
+//      The same function is called to save and to restore, so the items are always
+//      read back in the order in which they were written.
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//*************************************************************************************
+
+#ifndef TR4_CHKP_HPP
+    #define  TR4_CHKP_HPP                   //  Variable to prevent multiple inclusions
+
+//  A checkpoint object is either saving to a file or restoring from one
+enum CheckpointMode {CHECKPOINT_SAVE, CHECKPOINT_RESTORE};
+
+
+//=====================================================================================
+//  Class: CCheckpoint
+//      This class holds the checkpoint file while it's being written or read.  Its
+//      functions each write an item when saving and read it back when restoring; if
+//      the file can't be read or doesn't match the program, they call TR_Exit().
+//=====================================================================================
+
+class CCheckpoint
+    {
+    private:
+        FILE* CheckpointFile;               //  File holding the checkpoint
+        CheckpointMode Mode;                //  Saving or restoring
+        char* FileName;                     //  Name of the file, for error messages
+        boolean Failed;                     //  TRUE if something has gone wrong
+
+        void Fail (const char*, ...);       //  Complain, then stop using the file
+
+    public:
+        CCheckpoint (const char*,           //  Open a checkpoint file for saving or
+                     CheckpointMode);       //    restoring
+        ~CCheckpoint (void);                //  Close it again
+
+        CheckpointMode GetMode (void)       //  Find out whether the checkpoint is
+            { return (Mode); }              //    being saved or restored
+        boolean Restoring (void)            //  Returns TRUE when items are being
+            { return (Mode == CHECKPOINT_RESTORE); }    //  read back from the file
+        boolean HasFailed (void)            //  Returns TRUE if the file couldn't be
+            { return (Failed); }            //    written, read, or didn't match
+
+        void Data (void*, unsigned);        //  Save or restore a block of memory
+        void Name (const char*);            //  Save a name, or check it's the same
+        void Count (int, const char*);      //  Save a count, or check it's the same
+        void Logger (CDataLogger*);         //  Save or restore a data logger's data
+    };
+
+#endif      //  End of multiple-inclusion protection
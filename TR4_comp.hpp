@@ -1,100 +1,117 @@
-//*************************************************************************************
-//  TR3_COMP.HPP
-//      In this file are macros and such to permit the scheduler, which was written
-//      for Visual C++ version 1.5, to be compiled for other (better) compilers.
-//
-//  Note about DisableInterrupts() and EnableInterrupts()
-//       If we're compiling in a mode that uses interrupts, define the ...Interrupts()
-//       functions to be compatible with the compiler.  If not using interrupts, define
-//       them as inline null functions which won't do anything.  The user can thus put
-//       ...Interrupts() in his code and it will have no effect in non-interrupt modes
-//
-//  Copyright (c) 1994-1997 by D.M.Auslander and J.R.Ridgely
-//      May be used and distributed for any non-commercial purposes as long as this
-//      copyright notice is included.
-//       3-16-95  JR   Original file
-//       5-20-95  JR   Changed from CTL_COMP to TR3_COMP for use with Tranlog 3
-//       5-20-95  JR   Primary compiler for Tranlog3 is Borland C++ 4.5
-//      12-01-96  JR   Added stuff for compatibility with BC++ 5.0
-//*************************************************************************************
-
-#ifndef TR3_COMP_HPP
-    #define  TR3_COMP_HPP                   //  Variable to prevent multiple inclusions
-
-
-//-------------------------------------------------------------------------------------
-//  Some Common Stuff
-//      The macros which control mutual exclusion protection for real-time tasks (used
-//      only when interrupt-driven multithreading is active) are the same for all of
-//      the compilers, except
-
-#if defined (TR_THREAD_MULTI) || defined (TR_THREAD_TIMER) || defined (TR_TIME_INT)
-    #define USES_INTERRUPTS
-#endif
-
-#if !defined (USES_INTERRUPTS)
-    #define  EnableInterrupts()
-    #define  DisableInterrupts()
-#endif
-
-
-//-------------------------------------------------------------------------------------
-//  Default - Borland C++ Version 4.5x and 5.0 
-//      These macros allow the program to be compiled under Borland C++ Version 4 - 5,
-//      which is currently our compiler of choice.
-
-#if (__BORLANDC__ >= 0x460)
-    #define  DELETE_ARRAY           delete []
-#endif
-#if (__BORLANDC__ >= 0x460) && defined (USES_INTERRUPTS)
-    #define  ISR_POINTER(X)         void interrupt (*X)(...)
-    #define  ISR_FUNCTIONDEF(X)     void interrupt X(...)
-#endif
-#if (__BORLANDC__ >= 0x460) && !defined (USES_INTERRUPTS)
-    #define  ISR_POINTER(X)         void (*X)(...)
-    #define  ISR_FUNCTIONDEF(X)     void X(...)
-#endif
-
-
-//-------------------------------------------------------------------------------------
-//  For backward compatibility - Borland C++ Version 1.0
-//      These macros are for Borland C++ Version 1.0.  This older version can be a bit
-//	    more convenient to use for writing DOS applications
-
-#if __BORLANDC__ == 0x200
-    #define  ISR_POINTER(X)         void interrupt (*X)(...)
-    #define  ISR_FUNCTIONDEF(X)     void interrupt X(...)
-    #define  _dos_getvect	        getvect
-    #define  _dos_setvect           setvect
-    #define  DELETE_ARRAY           delete
-#endif
-
-
-//-------------------------------------------------------------------------------------
-//  Stuff common to all the Borland versions
-
-#if defined (__BORLANDC__) && defined (USES_INTERRUPTS)
-    #define  EnableInterrupts()     enable()
-    #define  DisableInterrupts()    disable()
-#endif
-
-
-//-------------------------------------------------------------------------------------
-//  Useable - Microsoft Visual C++ Version 1.5
-//      This compiler was used during original development of the program but we
-//      changed to Borland C++ (which we prefer) later on.
-
-#if defined (__MSVC__)
-    #define  ISR_POINTER(X)         void (__interrupt *X)(void)
-    #define  ISR_FUNCTIONDEF(X)     void __cdecl __interrupt __far X (void)
-
-    #define  _NOCURSOR              0x2000
-    #define  _NORMALCURSOR          0x0607
-#endif
-#if defined (__MSVC__) && defined (USES_INTERRUPTS)
-    #define  EnableInterrupts()   _enable()
-    #define  DisableInterrupts()  _disable()
-#endif
-
-#endif                                      //  End multiple-inclusion protection
-
+//*************************************************************************************
+//  TR3_COMP.HPP
+//      In this file are macros and such to permit the scheduler, which was written
+//      for Visual C++ version 1.5, to be compiled for other (better) compilers.
+//
+//  Note about DisableInterrupts() and EnableInterrupts()
+//       If we're compiling in a mode that uses interrupts, define the ...Interrupts()
+//       functions to be compatible with the compiler.  If not using interrupts, define
+//       them as inline null functions which won't do anything.  The user can thus put
+//       ...Interrupts() in his code and it will have no effect in non-interrupt modes
+//
+//  Copyright (c) 1994-1997 by D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//       3-16-95  JR   Original file
+//       5-20-95  JR   Changed from CTL_COMP to TR3_COMP for use with Tranlog 3
+//       5-20-95  JR   Primary compiler for Tranlog3 is Borland C++ 4.5
+//      12-01-96  JR   Added stuff for compatibility with BC++ 5.0
+//*************************************************************************************
+
+#ifndef TR3_COMP_HPP
+    #define  TR3_COMP_HPP                   //  Variable to prevent multiple inclusions
+
+
+//-------------------------------------------------------------------------------------
+//  Some Common Stuff
+//      The macros which control mutual exclusion protection for real-time tasks (used
+//      only when interrupt-driven multithreading is active) are the same for all of
+//      the compilers, except
+
+#if defined (TR_THREAD_MULTI) || defined (TR_THREAD_TIMER) || defined (TR_TIME_INT)
+    #define USES_INTERRUPTS
+#endif
+
+#if !defined (USES_INTERRUPTS)
+    #define  EnableInterrupts()
+    #define  DisableInterrupts()
+#endif
+
+//  Parallel simulation runs each process's single-thread sweeps in a thread of its
+//  own, so it can't be used with any other threading mode
+#if defined (TR_TIME_EXTSIM) && !defined (TR_THREAD_SINGLE)
+    #error Parallel simulation mode (TR_TIME_EXTSIM) must be used with TR_THREAD_SINGLE
+#endif
+
+//  Variables declared TR_THREAD_LOCAL get a separate copy in each thread.  They are
+//  used where one copy of the scheduler runs several threads, as in TR_TIME_EXTSIM
+//  mode; compilers without thread-local storage get ordinary (shared) variables
+#if defined (__GNUC__)
+    #define  TR_THREAD_LOCAL        __thread
+#elif defined (__WIN32__)
+    #define  TR_THREAD_LOCAL        __declspec(thread)
+#else
+    #define  TR_THREAD_LOCAL
+#endif
+
+
+//-------------------------------------------------------------------------------------
+//  Default - Borland C++ Version 4.5x and 5.0 
+//      These macros allow the program to be compiled under Borland C++ Version 4 - 5,
+//      which is currently our compiler of choice.
+
+#if (__BORLANDC__ >= 0x460)
+    #define  DELETE_ARRAY           delete []
+#endif
+#if (__BORLANDC__ >= 0x460) && defined (USES_INTERRUPTS)
+    #define  ISR_POINTER(X)         void interrupt (*X)(...)
+    #define  ISR_FUNCTIONDEF(X)     void interrupt X(...)
+#endif
+#if (__BORLANDC__ >= 0x460) && !defined (USES_INTERRUPTS)
+    #define  ISR_POINTER(X)         void (*X)(...)
+    #define  ISR_FUNCTIONDEF(X)     void X(...)
+#endif
+
+
+//-------------------------------------------------------------------------------------
+//  For backward compatibility - Borland C++ Version 1.0
+//      These macros are for Borland C++ Version 1.0.  This older version can be a bit
+//	    more convenient to use for writing DOS applications
+
+#if __BORLANDC__ == 0x200
+    #define  ISR_POINTER(X)         void interrupt (*X)(...)
+    #define  ISR_FUNCTIONDEF(X)     void interrupt X(...)
+    #define  _dos_getvect	        getvect
+    #define  _dos_setvect           setvect
+    #define  DELETE_ARRAY           delete
+#endif
+
+
+//-------------------------------------------------------------------------------------
+//  Stuff common to all the Borland versions
+
+#if defined (__BORLANDC__) && defined (USES_INTERRUPTS)
+    #define  EnableInterrupts()     enable()
+    #define  DisableInterrupts()    disable()
+#endif
+
+
+//-------------------------------------------------------------------------------------
+//  Useable - Microsoft Visual C++ Version 1.5
+//      This compiler was used during original development of the program but we
+//      changed to Borland C++ (which we prefer) later on.
+
+#if defined (__MSVC__)
+    #define  ISR_POINTER(X)         void (__interrupt *X)(void)
+    #define  ISR_FUNCTIONDEF(X)     void __cdecl __interrupt __far X (void)
+
+    #define  _NOCURSOR              0x2000
+    #define  _NORMALCURSOR          0x0607
+#endif
+#if defined (__MSVC__) && defined (USES_INTERRUPTS)
+    #define  EnableInterrupts()   _enable()
+    #define  DisableInterrupts()  _disable()
+#endif
+
+#endif                                      //  End multiple-inclusion protection
+
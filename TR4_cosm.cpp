@@ -0,0 +1,754 @@
+//*************************************************************************************
+//  TR4_cosm.cpp
+//      This file contains the implementation of the co-simulation classes, which run
+//      the scheduler a step at a time in lockstep with another simulator.  The server
+//      and client have a Winsock version, a BSD sockets version, and a version which
+//      only complains for systems with no sockets; see TR4_cosm.hpp for how the
+//      version is chosen.
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//*************************************************************************************
+
+#if defined (__WIN32__)
+    #include <winsock.h>                //  For Windows sockets
+#endif
+
+#include <math.h>
+#include <string.h>
+#include <TranRun4.hpp>
+
+#if defined (TR_BSD_SOCKETS)
+    #include <sys/types.h>
+    #include <sys/socket.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <arpa/inet.h>
+    #include <unistd.h>
+#endif
+
+
+//-------------------------------------------------------------------------------------
+//  Socket differences
+//      Winsock and BSD sockets are nearly the same; these names cover the differences.
+//      Socket handles are kept in longs so that the header file needn't include the
+//      socket headers; NO_SOCKET marks a handle which isn't open.  Messages are sent
+//      in the computer's own byte order, as both ends are on the same computer.
+
+#define  NO_SOCKET           (-1L)
+
+#if defined (__WIN32__)
+    typedef int TR_SockLen;
+    #define  CloseSocket(s)  closesocket ((SOCKET)(s))
+    #define  SEND_FLAGS      0
+#endif
+
+#if defined (TR_BSD_SOCKETS)
+    typedef socklen_t TR_SockLen;
+    #define  CloseSocket(s)  close ((int)(s))
+    //  Don't let a client which hangs up kill the whole program with SIGPIPE
+    #if defined (MSG_NOSIGNAL)
+        #define  SEND_FLAGS  MSG_NOSIGNAL
+    #else
+        #define  SEND_FLAGS  0
+    #endif
+#endif
+
+
+//=====================================================================================
+//  Class: CCoSimulation
+//      Holds the variable table and steps the scheduler.
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+//  Constructor: CCoSimulation
+//      The table starts out empty.  The first step may begin at any time, since the
+//      scheduler begins wherever it begins (at zero, or where a restored checkpoint
+//      left off); after that each step must begin where the last one ended.
+
+CCoSimulation::CCoSimulation (void)
+    {
+    Variables = NULL;
+    NumVariables = 0;
+    ArraySize = 0;
+    CommTime = (real_time)-1.0;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Destructor: ~CCoSimulation
+//      Delete the table of variables.  The variables themselves belong to the user.
+
+CCoSimulation::~CCoSimulation (void)
+    {
+    int Index;
+
+    for (Index = 0; Index < NumVariables; Index++)
+        DELETE_ARRAY Variables[Index].Name;
+    DELETE_ARRAY Variables;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Functions: AddInput, AddOutput, and AddVariable
+//      Add a variable to the table.  Inputs are set by the other simulator and read by
+//      the tasks; outputs are set by the tasks and read by the other simulator.  The
+//      value reference returned is the variable's number; variables are numbered from
+//      zero in the order in which they were added.
+
+int CCoSimulation::AddInput (const char* aName, double* aValue)
+    {
+    return (AddVariable (aName, aValue, TRUE));
+    }
+
+int CCoSimulation::AddOutput (const char* aName, double* aValue)
+    {
+    return (AddVariable (aName, aValue, FALSE));
+    }
+
+int CCoSimulation::AddVariable (const char* aName, double* aValue, boolean aIsInput)
+    {
+    int Index;                              //  Counts through variables
+
+
+    if (FindVariable (aName) >= 0)
+        {
+        TR_Exit ("Attempt to add a second co-simulation variable named \"%s\"", aName);
+        return (-1);
+        }
+
+    //  If the table is full, make a new one twice as big and copy the variables into it
+    if (NumVariables >= ArraySize)
+        {
+        int NewSize = (ArraySize < 16) ? 16 : (ArraySize * 2);
+        TR_CoSimVariable* NewVariables = new TR_CoSimVariable[NewSize];
+        if (NewVariables == NULL)
+            {
+            TR_Exit ("Unable to allocate memory for %d co-simulation variables", NewSize);
+            return (-1);
+            }
+        for (Index = 0; Index < NumVariables; Index++)
+            NewVariables[Index] = Variables[Index];
+        DELETE_ARRAY Variables;
+        Variables = NewVariables;
+        ArraySize = NewSize;
+        }
+
+    if ((Variables[NumVariables].Name = new char[strlen (aName) + 1]) != NULL)
+        strcpy (Variables[NumVariables].Name, aName);
+    Variables[NumVariables].pValue = aValue;
+    Variables[NumVariables].IsInput = aIsInput;
+
+    return (NumVariables++);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: FindVariable
+//      Look up a variable by name and return its value reference, or -1 if there's no
+//      variable with that name.
+
+int CCoSimulation::FindVariable (const char* aName)
+    {
+    int Index;
+
+    for (Index = 0; Index < NumVariables; Index++)
+        if ((Variables[Index].Name != NULL) && (strcmp (Variables[Index].Name, aName) == 0))
+            return (Index);
+
+    return (-1);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: GetName
+//      Return the name of the variable with the given value reference.
+
+const char* CCoSimulation::GetName (int aRef)
+    {
+    if ((aRef < 0) || (aRef >= NumVariables))
+        return ("");
+
+    return (Variables[aRef].Name);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: SetReal
+//      Set the inputs with the given value references to the given values.  Only
+//      inputs may be set; the outputs belong to the tasks.  If any reference is wrong,
+//      nothing is set and an error is returned.
+
+CoSimStatus CCoSimulation::SetReal (const int* aRefs, int aCount, const double* aValues)
+    {
+    int Index;                              //  Counts through the variables given
+
+    for (Index = 0; Index < aCount; Index++)
+        {
+        if ((aRefs[Index] < 0) || (aRefs[Index] >= NumVariables))
+            {
+            TR_Message ("Co-simulation has no variable number %d\n", aRefs[Index]);
+            return (COSIM_ERROR);
+            }
+        if (Variables[aRefs[Index]].IsInput == FALSE)
+            {
+            TR_Message ("Co-simulation variable \"%s\" is an output and can't be set\n",
+                        Variables[aRefs[Index]].Name);
+            return (COSIM_ERROR);
+            }
+        }
+
+    for (Index = 0; Index < aCount; Index++)
+        *(Variables[aRefs[Index]].pValue) = aValues[Index];
+
+    return (COSIM_OK);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: GetReal
+//      Read the variables with the given value references.  Inputs may be read back
+//      as well as outputs.
+
+CoSimStatus CCoSimulation::GetReal (const int* aRefs, int aCount, double* aValues)
+    {
+    int Index;                              //  Counts through the variables given
+
+    for (Index = 0; Index < aCount; Index++)
+        if ((aRefs[Index] < 0) || (aRefs[Index] >= NumVariables))
+            {
+            TR_Message ("Co-simulation has no variable number %d\n", aRefs[Index]);
+            return (COSIM_ERROR);
+            }
+
+    for (Index = 0; Index < aCount; Index++)
+        aValues[Index] = *(Variables[aRefs[Index]].pValue);
+
+    return (COSIM_OK);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: DoStep
+//      Run the scheduler from the current communication point to the next one.  The
+//      time given must be that of the current communication point, give or take half
+//      a tick, so that the two simulators can't drift apart unnoticed.  If the
+//      scheduler reaches its stop time during the step, the step is discarded, as
+//      FMI says; if the scheduler was stopped by an error, an error is returned.
+
+CoSimStatus CCoSimulation::DoStep (real_time aCurrentTime, real_time aStepSize)
+    {
+    real_time HalfTick;                     //  How far the times given may be off
+
+
+    if (aStepSize <= (real_time)0.0)
+        {
+        TR_Message ("Co-simulation step size must be positive, not %g\n",
+                    (double)aStepSize);
+        return (COSIM_ERROR);
+        }
+
+    HalfTick = TheTimer->GetDeltaTime () / (real_time)2.0;
+    if ((CommTime >= (real_time)0.0) && (fabs (aCurrentTime - CommTime) > HalfTick))
+        {
+        TR_Message ("Co-simulation step begins at %g, but the last one ended at %g\n",
+                    (double)aCurrentTime, (double)CommTime);
+        return (COSIM_ERROR);
+        }
+
+    if (TheMaster->StepTo (aCurrentTime + aStepSize) == TRUE)
+        {
+        CommTime = aCurrentTime + aStepSize;
+        return (COSIM_OK);
+        }
+
+    //  The scheduler has stopped.  The step is only partly done, so leave the
+    //  communication point where it was
+    if (GetTimeNow () > TheMaster->GetStopTime ())
+        return (COSIM_DISCARD);
+    return (COSIM_ERROR);
+    }
+
+
+#if defined (TR_NO_SOCKETS)
+
+//=====================================================================================
+//  No-socket versions
+//      Without sockets there's no way to talk to another program, so these versions
+//      just complain.
+//=====================================================================================
+
+CCoSimServer::CCoSimServer (CCoSimulation* aCoSim, unsigned short aPort)
+    {
+    pCoSim = aCoSim;
+    Port = aPort;
+    ListenSocket = NO_SOCKET;
+    ClientSocket = NO_SOCKET;
+    }
+
+CCoSimServer::~CCoSimServer (void)
+    {
+    }
+
+boolean CCoSimServer::Listen (void)
+    {
+    TR_Exit ("Co-simulation server needs sockets, which this system doesn't have");
+    return (FALSE);
+    }
+
+boolean CCoSimServer::Serve (void)
+    {
+    return (Listen ());
+    }
+
+boolean CCoSimServer::Receive (void*, int)
+    {
+    return (FALSE);
+    }
+
+boolean CCoSimServer::Send (const void*, int)
+    {
+    return (FALSE);
+    }
+
+CCoSimClient::CCoSimClient (void)
+    {
+    Socket = NO_SOCKET;
+    }
+
+CCoSimClient::~CCoSimClient (void)
+    {
+    }
+
+boolean CCoSimClient::Connect (unsigned short)
+    {
+    TR_Exit ("Co-simulation client needs sockets, which this system doesn't have");
+    return (FALSE);
+    }
+
+void CCoSimClient::Disconnect (void)
+    {
+    }
+
+boolean CCoSimClient::Receive (void*, int)
+    {
+    return (FALSE);
+    }
+
+boolean CCoSimClient::Send (const void*, int)
+    {
+    return (FALSE);
+    }
+
+CoSimStatus CCoSimClient::SetReal (const int*, int, const double*)
+    {
+    return (COSIM_ERROR);
+    }
+
+CoSimStatus CCoSimClient::GetReal (const int*, int, double*)
+    {
+    return (COSIM_ERROR);
+    }
+
+CoSimStatus CCoSimClient::DoStep (real_time, real_time)
+    {
+    return (COSIM_ERROR);
+    }
+
+#else       //  Winsock or BSD sockets
+
+
+//-------------------------------------------------------------------------------------
+//  Functions: SendAll and ReceiveAll
+//      A socket may send or receive a message in pieces; these functions keep going
+//      until the whole thing has gone through.  They return FALSE if the connection
+//      is broken.
+
+static boolean SendAll (long aSocket, const void* aData, int aSize)
+    {
+    const char* pData = (const char*)aData;
+    int Count;                              //  Number of bytes sent each time
+
+    while (aSize > 0)
+        {
+        if ((Count = send (aSocket, pData, aSize, SEND_FLAGS)) <= 0)
+            return (FALSE);
+        pData += Count;
+        aSize -= Count;
+        }
+    return (TRUE);
+    }
+
+static boolean ReceiveAll (long aSocket, void* aData, int aSize)
+    {
+    char* pData = (char*)aData;
+    int Count;                              //  Number of bytes received each time
+
+    while (aSize > 0)
+        {
+        if ((Count = recv (aSocket, pData, aSize, 0)) <= 0)
+            return (FALSE);
+        pData += Count;
+        aSize -= Count;
+        }
+    return (TRUE);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: NoDelay
+//      Messages are small and each one is answered before the next is sent, so the
+//      usual trick of holding small messages back to send them together would only
+//      slow every step down.  This function turns it off.
+
+static void NoDelay (long aSocket)
+    {
+    int On = 1;
+
+    setsockopt (aSocket, IPPROTO_TCP, TCP_NODELAY, (const char*)&On, sizeof (On));
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: LocalAddress
+//      Fill in the address of a port on the local computer.
+
+static void LocalAddress (struct sockaddr_in* aAddress, unsigned short aPort)
+    {
+    memset (aAddress, 0, sizeof (struct sockaddr_in));
+    aAddress->sin_family = AF_INET;
+    aAddress->sin_port = htons (aPort);
+    aAddress->sin_addr.s_addr = htonl (INADDR_LOOPBACK);
+    }
+
+
+//=====================================================================================
+//  Class: CCoSimServer
+//      Answers a client's requests over a socket.
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+//  Constructor: CCoSimServer
+//      The server is given the co-simulation which does the work and the port on
+//      which to listen.  It doesn't start listening until Listen() or Serve().
+
+CCoSimServer::CCoSimServer (CCoSimulation* aCoSim, unsigned short aPort)
+    {
+    pCoSim = aCoSim;
+    Port = aPort;
+    ListenSocket = NO_SOCKET;
+    ClientSocket = NO_SOCKET;
+
+    #if defined (__WIN32__)
+        WSADATA WinsockData;
+        WSAStartup (0x0101, &WinsockData);
+    #endif
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Destructor: ~CCoSimServer
+//      Close any sockets which are still open.
+
+CCoSimServer::~CCoSimServer (void)
+    {
+    if (ClientSocket != NO_SOCKET)
+        CloseSocket (ClientSocket);
+    if (ListenSocket != NO_SOCKET)
+        CloseSocket (ListenSocket);
+
+    #if defined (__WIN32__)
+        WSACleanup ();
+    #endif
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Listen
+//      Open a socket on the server's port of the local computer, so a client can
+//      connect to it.  This is done separately from Serve() so that a client which
+//      is started afterwards is sure to find the server ready.
+
+boolean CCoSimServer::Listen (void)
+    {
+    struct sockaddr_in Address;             //  Address of the port on this computer
+    int On = 1;                             //  Turns on the option to reuse the port
+
+    if (ListenSocket != NO_SOCKET)
+        return (TRUE);
+
+    if ((ListenSocket = (long)socket (AF_INET, SOCK_STREAM, 0)) == NO_SOCKET)
+        {
+        TR_Exit ("Unable to create a socket for the co-simulation server");
+        return (FALSE);
+        }
+    setsockopt (ListenSocket, SOL_SOCKET, SO_REUSEADDR, (const char*)&On, sizeof (On));
+
+    LocalAddress (&Address, Port);
+    if ((bind (ListenSocket, (struct sockaddr*)&Address, sizeof (Address)) != 0)
+        || (listen (ListenSocket, 1) != 0))
+        {
+        TR_Exit ("Co-simulation server can't listen on port %u", (unsigned)Port);
+        CloseSocket (ListenSocket);
+        ListenSocket = NO_SOCKET;
+        return (FALSE);
+        }
+
+    return (TRUE);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Functions: Send and Receive
+//      Write and read parts of messages over the connection to the client.
+
+boolean CCoSimServer::Send (const void* aData, int aSize)
+    {
+    return (SendAll (ClientSocket, aData, aSize));
+    }
+
+boolean CCoSimServer::Receive (void* aData, int aSize)
+    {
+    return (ReceiveAll (ClientSocket, aData, aSize));
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Serve
+//      Wait for a client to connect, then carry out its requests until it quits.
+//      Each request is one command character followed by its data; each answer is a
+//      status (as an int), followed for GetReal by the values.  The function returns
+//      TRUE if the client quit properly and FALSE if the connection was lost.
+
+boolean CCoSimServer::Serve (void)
+    {
+    int Refs[COSIM_MAX_TRANSFER];           //  Value references in a request
+    double Values[COSIM_MAX_TRANSFER];      //  Values being set or read
+    double Times[2];                        //  Current time and step size
+    struct sockaddr_in Address;             //  Address of the client
+    TR_SockLen AddressSize;                 //  Size of the client's address
+    char Command;                           //  What the client wants done
+    int Count;                              //  Number of values in the request
+    int Index;                              //  Counts through the values
+    int Status;                             //  Result sent back to the client
+
+
+    if (Listen () == FALSE)
+        return (FALSE);
+
+    AddressSize = sizeof (Address);
+    ClientSocket = (long)accept (ListenSocket, (struct sockaddr*)&Address, &AddressSize);
+    if (ClientSocket == NO_SOCKET)
+        {
+        TR_Exit ("Co-simulation server was unable to accept a client");
+        return (FALSE);
+        }
+    NoDelay (ClientSocket);
+
+    while (Receive (&Command, 1) == TRUE)
+        {
+        switch (Command)
+            {
+            case COSIM_SET_REAL:
+            case COSIM_GET_REAL:
+                if ((Receive (&Count, sizeof (int)) == FALSE)
+                    || (Count < 0) || (Count > COSIM_MAX_TRANSFER)
+                    || (Receive (Refs, Count * sizeof (int)) == FALSE))
+                    break;
+                if (Command == COSIM_SET_REAL)
+                    {
+                    if (Receive (Values, Count * sizeof (double)) == FALSE)
+                        break;
+                    Status = (int)pCoSim->SetReal (Refs, Count, Values);
+                    Send (&Status, sizeof (int));
+                    }
+                else
+                    {
+                    //  The values are sent even if the references were wrong, so the
+                    //  client always knows how much to read
+                    for (Index = 0; Index < Count; Index++)
+                        Values[Index] = 0.0;
+                    Status = (int)pCoSim->GetReal (Refs, Count, Values);
+                    Send (&Status, sizeof (int));
+                    Send (Values, Count * sizeof (double));
+                    }
+                continue;
+
+            case COSIM_DO_STEP:
+                if (Receive (Times, 2 * sizeof (double)) == FALSE)
+                    break;
+                Status = (int)pCoSim->DoStep ((real_time)Times[0], (real_time)Times[1]);
+                Send (&Status, sizeof (int));
+                continue;
+
+            case COSIM_QUIT:
+                CloseSocket (ClientSocket);
+                ClientSocket = NO_SOCKET;
+                return (TRUE);
+
+            default:
+                TR_Message ("Co-simulation server got unknown command '%c'\n", Command);
+                break;
+            }
+        break;                              //  Something was wrong; hang up
+        }
+
+    CloseSocket (ClientSocket);
+    ClientSocket = NO_SOCKET;
+    return (FALSE);
+    }
+
+
+//=====================================================================================
+//  Class: CCoSimClient
+//      Sends requests to a server over a socket.
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+//  Constructor and destructor:  CCoSimClient
+//      The client isn't connected until Connect() is called.  If it's still connected
+//      when it's deleted, it tells the server it's done.
+
+CCoSimClient::CCoSimClient (void)
+    {
+    Socket = NO_SOCKET;
+
+    #if defined (__WIN32__)
+        WSADATA WinsockData;
+        WSAStartup (0x0101, &WinsockData);
+    #endif
+    }
+
+CCoSimClient::~CCoSimClient (void)
+    {
+    Disconnect ();
+
+    #if defined (__WIN32__)
+        WSACleanup ();
+    #endif
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Connect
+//      Connect to a server which is listening on the given port of this computer.
+
+boolean CCoSimClient::Connect (unsigned short aPort)
+    {
+    struct sockaddr_in Address;             //  Address of the server's port
+
+    Disconnect ();
+    if ((Socket = (long)socket (AF_INET, SOCK_STREAM, 0)) == NO_SOCKET)
+        {
+        TR_Exit ("Unable to create a socket for the co-simulation client");
+        return (FALSE);
+        }
+
+    LocalAddress (&Address, aPort);
+    if (connect (Socket, (struct sockaddr*)&Address, sizeof (Address)) != 0)
+        {
+        TR_Exit ("Co-simulation client can't connect to port %u", (unsigned)aPort);
+        CloseSocket (Socket);
+        Socket = NO_SOCKET;
+        return (FALSE);
+        }
+    NoDelay (Socket);
+
+    return (TRUE);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Disconnect
+//      Tell the server we're finished and close the connection.
+
+void CCoSimClient::Disconnect (void)
+    {
+    char Command = COSIM_QUIT;
+
+    if (Socket == NO_SOCKET)
+        return;
+
+    Send (&Command, 1);
+    CloseSocket (Socket);
+    Socket = NO_SOCKET;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Functions: Send and Receive
+//      Write and read parts of messages over the connection to the server.
+
+boolean CCoSimClient::Send (const void* aData, int aSize)
+    {
+    return (SendAll (Socket, aData, aSize));
+    }
+
+boolean CCoSimClient::Receive (void* aData, int aSize)
+    {
+    return (ReceiveAll (Socket, aData, aSize));
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Functions: SetReal, GetReal, and DoStep
+//      Send a request to the server and wait for the answer.  If the connection is
+//      lost, or more variables are given than fit in a message, an error is returned.
+
+CoSimStatus CCoSimClient::SetReal (const int* aRefs, int aCount, const double* aValues)
+    {
+    char Command = COSIM_SET_REAL;
+    int Status;
+
+    if ((Socket == NO_SOCKET) || (aCount < 0) || (aCount > COSIM_MAX_TRANSFER))
+        return (COSIM_ERROR);
+
+    if ((Send (&Command, 1) == FALSE)
+        || (Send (&aCount, sizeof (int)) == FALSE)
+        || (Send (aRefs, aCount * sizeof (int)) == FALSE)
+        || (Send (aValues, aCount * sizeof (double)) == FALSE)
+        || (Receive (&Status, sizeof (int)) == FALSE))
+        return (COSIM_ERROR);
+
+    return ((CoSimStatus)Status);
+    }
+
+CoSimStatus CCoSimClient::GetReal (const int* aRefs, int aCount, double* aValues)
+    {
+    char Command = COSIM_GET_REAL;
+    int Status;
+
+    if ((Socket == NO_SOCKET) || (aCount < 0) || (aCount > COSIM_MAX_TRANSFER))
+        return (COSIM_ERROR);
+
+    if ((Send (&Command, 1) == FALSE)
+        || (Send (&aCount, sizeof (int)) == FALSE)
+        || (Send (aRefs, aCount * sizeof (int)) == FALSE)
+        || (Receive (&Status, sizeof (int)) == FALSE)
+        || (Receive (aValues, aCount * sizeof (double)) == FALSE))
+        return (COSIM_ERROR);
+
+    return ((CoSimStatus)Status);
+    }
+
+CoSimStatus CCoSimClient::DoStep (real_time aCurrentTime, real_time aStepSize)
+    {
+    char Command = COSIM_DO_STEP;
+    double Times[2];                        //  Current time and step size
+    int Status;
+
+    if (Socket == NO_SOCKET)
+        return (COSIM_ERROR);
+
+    Times[0] = (double)aCurrentTime;
+    Times[1] = (double)aStepSize;
+    if ((Send (&Command, 1) == FALSE)
+        || (Send (Times, 2 * sizeof (double)) == FALSE)
+        || (Receive (&Status, sizeof (int)) == FALSE))
+        return (COSIM_ERROR);
+
+    return ((CoSimStatus)Status);
+    }
+
+#endif      //  End of socket versions
@@ -0,0 +1,161 @@
+//*************************************************************************************
+//  TR4_cosm.hpp
+//      This is the header for co-simulation, in which a control program runs in step
+//      with a simulator written by someone else (a plant model, say).  Neither one
+//      runs freely; a master algorithm tells each in turn to advance to the next
+//      communication point, and between steps it copies the outputs of each into the
+//      inputs of the other.  The step contract is modeled on the Functional Mockup
+//      Interface:  variables are given numbers ("value references"), they're set and
+//      read with SetReal() and GetReal(), and DoStep() is given the time at the start
+//      of the step and the step size.
+//
+//      The scheduler must be in simulation mode (TR_TIME_SIM).  The program sets up
+//      its processes, tasks, and states as usual, sets the tick and stop times, and
+//      tells the co-simulation object which of its variables are inputs and outputs.
+//      Then, instead of calling TheMaster->Go(), it lets the co-simulation object run
+//      the scheduler a step at a time, either by calling DoStep() itself or by handing
+//      the object to a server which takes orders from another program.
+//
+//      The server and client talk over a TCP connection on the local computer.  The
+//      client is a stand-in for an external simulator or master algorithm, useful for
+//      testing a controller by itself.  Sockets are used through Winsock on Win32 and
+//      through BSD sockets if TR_BSD_SOCKETS is defined (it is by default on Unix
+//      systems); if neither is available, TR_NO_SOCKETS is defined and the server and
+//      client can't be used, though DoStep() still can.
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//*************************************************************************************
+
+#ifndef TR4_COSM_HPP
+    #define  TR4_COSM_HPP                   //  Variable to prevent multiple inclusions
+
+//  Decide which kind of sockets to use
+#if !defined (__WIN32__) && !defined (TR_BSD_SOCKETS) && defined (__unix__)
+    #define  TR_BSD_SOCKETS
+#endif
+#if !defined (__WIN32__) && !defined (TR_BSD_SOCKETS)
+    #define  TR_NO_SOCKETS
+#endif
+
+//  The results of a co-simulation call, like the status codes of the FMI standard.
+//  DISCARD means the step couldn't be finished because the scheduler reached its stop
+//  time; ERROR means the call was wrong or the scheduler was stopped by an error
+enum CoSimStatus {COSIM_OK, COSIM_DISCARD, COSIM_ERROR};
+
+//  At most this many variables may be set or read in one message over the socket
+#define  COSIM_MAX_TRANSFER  256
+
+//  Each message from client to server begins with one of these characters
+#define  COSIM_SET_REAL      'S'            //  Count, then reference-value pairs
+#define  COSIM_GET_REAL      'G'            //  Count, then references
+#define  COSIM_DO_STEP       'D'            //  Current time and step size
+#define  COSIM_QUIT          'Q'            //  Client is finished
+
+
+//-------------------------------------------------------------------------------------
+//  Structure:  TR_CoSimVariable
+//      Each variable which is exchanged with the other simulator has a name, by which
+//      it can be looked up, and a pointer to where the program keeps it.
+
+struct TR_CoSimVariable
+    {
+    char* Name;                             //  Name of the variable
+    double* pValue;                         //  Where the program keeps the value
+    boolean IsInput;                        //  TRUE if set from outside, FALSE if read
+    };
+
+
+//=====================================================================================
+//  Class: CCoSimulation
+//      This class holds the table of input and output variables and runs the current
+//      scheduler one step at a time.  The variables belong to the user's tasks, so
+//      they should only be changed between steps; DoStep() doesn't return until the
+//      step is over, so a single-threaded master algorithm needs no locking.
+//=====================================================================================
+
+class CCoSimulation
+    {
+    private:
+        TR_CoSimVariable* Variables;        //  Table of inputs and outputs
+        int NumVariables;                   //  How many are in the table
+        int ArraySize;                      //  How many will fit before it must grow
+        real_time CommTime;                 //  Time of the current communication point
+
+        int AddVariable (const char*, double*, boolean);
+
+    public:
+        CCoSimulation (void);
+        ~CCoSimulation (void);
+
+        int AddInput (const char*, double*);    //  Add a variable and return its
+        int AddOutput (const char*, double*);   //    value reference
+        int FindVariable (const char*);         //  Get reference of a named variable
+        int GetNumVariables (void)
+            { return (NumVariables); }
+        const char* GetName (int);              //  Get a variable's name
+
+        CoSimStatus SetReal (const int*, int, const double*);   //  Set some inputs
+        CoSimStatus GetReal (const int*, int, double*);         //  Read any variables
+        CoSimStatus DoStep (real_time, real_time);              //  Run one step
+        real_time GetTime (void)                //  Time of the current communication
+            { return (CommTime); }              //    point
+    };
+
+
+//=====================================================================================
+//  Class: CCoSimServer
+//      The server listens on a port of the local computer, accepts one client, and
+//      carries out its SetReal, GetReal, and DoStep requests on a co-simulation
+//      object until the client quits or hangs up.
+//=====================================================================================
+
+class CCoSimServer
+    {
+    private:
+        CCoSimulation* pCoSim;              //  Co-simulation which does the work
+        unsigned short Port;                //  Port on which to listen
+        long ListenSocket;                  //  Socket waiting for a client
+        long ClientSocket;                  //  Socket connected to the client
+
+        boolean Receive (void*, int);       //  Read a whole message part
+        boolean Send (const void*, int);    //  Write a whole message part
+
+    public:
+        CCoSimServer (CCoSimulation*, unsigned short);
+        ~CCoSimServer (void);
+
+        boolean Listen (void);              //  Start listening for a client
+        boolean Serve (void);               //  Answer one client until it's done
+    };
+
+
+//=====================================================================================
+//  Class: CCoSimClient
+//      The client connects to a server on the local computer and sends it requests.
+//      Each function sends a message and waits for the answer, so the functions can
+//      be used just like those of CCoSimulation.
+//=====================================================================================
+
+class CCoSimClient
+    {
+    private:
+        long Socket;                        //  Socket connected to the server
+
+        boolean Receive (void*, int);       //  Read a whole message part
+        boolean Send (const void*, int);    //  Write a whole message part
+
+    public:
+        CCoSimClient (void);
+        ~CCoSimClient (void);
+
+        boolean Connect (unsigned short);   //  Connect to server on the given port
+        void Disconnect (void);             //  Tell server we're done and hang up
+
+        CoSimStatus SetReal (const int*, int, const double*);
+        CoSimStatus GetReal (const int*, int, double*);
+        CoSimStatus DoStep (real_time, real_time);
+    };
+
+#endif      //  End of multiple-inclusion protection
@@ -0,0 +1,109 @@
+//*************************************************************************************
+//  TR4_ctxt.cpp
+//      This file contains the implementation of the scheduler context class.  A
+//      context holds a master scheduler and a timer, which used to be global objects;
+//      several contexts can be created so that several independent simulations can
+//      run side by side in one program, each in its own thread.
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//*************************************************************************************
+
+#include <stdlib.h>
+#include <TranRun4.hpp>
+
+
+//-------------------------------------------------------------------------------------
+//  Global Data
+//      Each thread has its own pointer to the context which it's working with.  The
+//      macros TheMaster, TheTimer, and MainProcess find their objects through it.
+
+TR_THREAD_LOCAL CSchedulerContext* TR_CurrentContext = NULL;
+
+
+//=====================================================================================
+//  Class: CSchedulerContext
+//      One master scheduler, its main process, and a timer.
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+//  Constructor: CSchedulerContext
+//      This constructor creates the objects which main() used to create as globals.
+//      The new context is made current first, because the master's constructor and
+//      the timer's constructor may use TheMaster and TheTimer themselves.  It stays
+//      current afterwards, so the user can go on to set up tasks in it right away.
+
+CSchedulerContext::CSchedulerContext (void)
+    {
+    pMaster = NULL;
+    pTimer = NULL;
+    pMainProcess = NULL;
+    RandomSeed = 1L;
+
+    TR_CurrentContext = this;
+
+    if ((pMaster = new CMaster ()) == NULL)
+        TR_Exit ("Unable to create master scheduler object");
+    pMainProcess = pMaster->AddProcess ("Main Process");
+    if ((pTimer = new CRealTimer ()) == NULL)
+        TR_Exit ("Unable to create timer object");
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Destructor: ~CSchedulerContext
+//      Delete the master (which deletes its processes and tasks, closing their files)
+//      and then the timer.  The context is made current while its objects are being
+//      deleted, since their destructors may use TheMaster or TheTimer.  Afterwards the
+//      thread goes back to the context it had before, unless that was this one.
+
+CSchedulerContext::~CSchedulerContext (void)
+    {
+    CSchedulerContext* pPrevious = TR_CurrentContext;
+
+    TR_CurrentContext = this;
+    delete pMaster;
+    delete pTimer;
+
+    if (pPrevious == this)
+        TR_CurrentContext = NULL;
+    else
+        TR_CurrentContext = pPrevious;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: MakeCurrent
+//      Make this the context which the calling thread works with.  A thread which was
+//      started to run a simulation calls this before doing anything else.
+
+void CSchedulerContext::MakeCurrent (void)
+    {
+    TR_CurrentContext = this;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Random
+//      This function returns a pseudo-random number between 0 and TR_RANDOM_MAX.  It
+//      uses the same simple generator as the example rand() in the ANSI C standard,
+//      but each context keeps its own seed, so the numbers which one simulation gets
+//      don't depend on what the others in the program are doing.
+
+int CSchedulerContext::Random (void)
+    {
+    RandomSeed = RandomSeed * 1103515245L + 12345L;
+    return ((int)((RandomSeed / 65536L) % ((unsigned long)TR_RANDOM_MAX + 1L)));
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: GetCurrentContext
+//      Returns a pointer to the calling thread's current context, or NULL if it has
+//      none.
+
+CSchedulerContext* GetCurrentContext (void)
+    {
+    return (TR_CurrentContext);
+    }
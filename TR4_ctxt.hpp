@@ -0,0 +1,78 @@
+//*************************************************************************************
+//  TR4_ctxt.hpp
+//      This is the header for the scheduler context.  A context is one complete copy
+//      of the scheduler:  a master (which owns the processes, their tasks, and the
+//      transition-logic trace logger) and a timer.  Each thread has a "current"
+//      context, and the names TheMaster, TheTimer, and MainProcess refer to the
+//      objects in that context.  Many contexts may exist at once, each running in
+//      its own thread, so many simulations can be run in one program.
+//
+//      Running more than one context at a time makes sense only in simulated-time
+//      modes (TR_TIME_SIM and TR_TIME_EXTSIM); the other modes use the PC's one
+//      timer chip and interrupt vector, which can't be shared.
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//*************************************************************************************
+
+#ifndef TR4_CTXT_HPP
+    #define  TR4_CTXT_HPP                   //  Variable to prevent multiple inclusions
+
+//  Random numbers from a context's own generator run from 0 to this number
+#define  TR_RANDOM_MAX       32767
+
+
+//=====================================================================================
+//  Class: CSchedulerContext
+//      This class holds one master scheduler, its main process, and its timer.  The
+//      constructor creates them in the same way main() always has, and makes the new
+//      context the current one for the thread which created it.  A context also has
+//      its own random number generator, which is used to pick the tasks' starting
+//      phases, so that simulations in different threads don't share rand()'s state.
+//=====================================================================================
+
+class CSchedulerContext
+    {
+    private:
+        CMaster* pMaster;                   //  Master scheduler for this context
+        CRealTimer* pTimer;                 //  Timer which keeps this context's time
+        CProcess* pMainProcess;             //  Process created along with the master
+        unsigned long RandomSeed;           //  State of the random number generator
+
+    public:
+        CSchedulerContext (void);           //  Constructor creates master and timer
+        ~CSchedulerContext (void);          //  Destructor deletes them again
+
+        void MakeCurrent (void);            //  Make this the calling thread's context
+        int Random (void);                  //  Get number from 0 to TR_RANDOM_MAX
+        void SetRandomSeed (unsigned long aSeed)    //  Start the random number
+            { RandomSeed = aSeed; }                 //    sequence over again
+        unsigned long GetRandomSeed (void)          //  Get the generator's state,
+            { return (RandomSeed); }                //    e.g. to save it
+
+        CMaster* GetMaster (void)           //  Functions return pointers to the
+            { return (pMaster); }           //    master scheduler,
+        CRealTimer* GetTimer (void)         //    the timer,
+            { return (pTimer); }
+        CProcess* GetMainProcess (void)     //    and the main process which belong
+            { return (pMainProcess); }      //    to this context
+    };
+
+
+//-------------------------------------------------------------------------------------
+//  Current Context
+//      Each thread has a pointer to its current context.  These macros replace the
+//      global pointers which used to be created in TranRun4.cpp, so code which uses
+//      TheMaster, TheTimer, or MainProcess works the same as ever - it just gets the
+//      objects belonging to the context which is current in the calling thread.
+
+extern TR_THREAD_LOCAL CSchedulerContext* TR_CurrentContext;
+
+CSchedulerContext* GetCurrentContext (void);    //  Returns the calling thread's context
+
+#define  TheMaster           (TR_CurrentContext->GetMaster ())
+#define  TheTimer            (TR_CurrentContext->GetTimer ())
+#define  MainProcess         (TR_CurrentContext->GetMainProcess ())
+
+#endif      //  End of multiple-inclusion protection
@@ -0,0 +1,147 @@
+//*************************************************************************************
+//  TR4_exec.cpp
+//      This file contains the implementation of execution-time models, which say how
+//      long tasks and states would take to run on the target computer.
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//*************************************************************************************
+
+#include <math.h>
+#include <TranRun4.hpp>
+
+
+//=====================================================================================
+//  Class: CExecTimeModel
+//      Gives out a simulated execution time for each run of a task or state.
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+//  Constructors: CExecTimeModel
+//      The first constructor makes a model which always gives the same time.  The
+//      second makes a uniform model, given the shortest and longest times, or a normal
+//      model, given the mean and standard deviation.  The third copies the histogram
+//      from a profiler which has measured the real run times.
+
+CExecTimeModel::CExecTimeModel (real_time aTime)
+    {
+    if (aTime < (real_time)0.0)
+        TR_Exit ("Execution time %g is negative", (double)aTime);
+
+    Type = EXEC_CONSTANT;
+    First = aTime;
+    Second = (real_time)0.0;
+    Counts = NULL;
+    NumberOfBins = 0;
+    TotalCount = 0L;
+    }
+
+CExecTimeModel::CExecTimeModel (ExecTimeType aType, real_time aFirst, real_time aSecond)
+    {
+    Type = aType;
+    First = aFirst;
+    Second = aSecond;
+    Counts = NULL;
+    NumberOfBins = 0;
+    TotalCount = 0L;
+
+    if ((Type == EXEC_UNIFORM) && ((aFirst < (real_time)0.0) || (aSecond < aFirst)))
+        TR_Exit ("Invalid uniform execution time model: %g to %g", (double)aFirst,
+                 (double)aSecond);
+    else if ((Type == EXEC_NORMAL) && ((aFirst < (real_time)0.0)
+                                       || (aSecond < (real_time)0.0)))
+        TR_Exit ("Invalid normal execution time model: mean %g, deviation %g",
+                 (double)aFirst, (double)aSecond);
+    else if ((Type != EXEC_UNIFORM) && (Type != EXEC_NORMAL))
+        TR_Exit ("This execution time model needs one time or a profiler");
+    }
+
+CExecTimeModel::CExecTimeModel (CProfiler* aProfiler)
+    {
+    int Bin;                                //  Counts through the histogram bins
+
+    Type = EXEC_HISTOGRAM;
+    First = (real_time)0.0;
+    Second = (real_time)0.0;
+    NumberOfBins = aProfiler->GetNumberOfBins ();
+    Minimum = aProfiler->GetMinimum ();
+    BinSize = (aProfiler->GetMaximum () - Minimum) / (real_time)NumberOfBins;
+    TotalCount = 0L;
+
+    Counts = new long[NumberOfBins];
+    for (Bin = 0; Bin < NumberOfBins; Bin++)
+        {
+        Counts[Bin] = aProfiler->GetBinCount (Bin);
+        TotalCount += Counts[Bin];
+        }
+
+    if (TotalCount == 0L)
+        TR_Exit ("Execution time model's profiler has no data in it");
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Destructor: ~CExecTimeModel
+//      Delete the copy of the histogram, if there is one.
+
+CExecTimeModel::~CExecTimeModel (void)
+    {
+    DELETE_ARRAY Counts;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Random
+//      Return a random number from 0 up to (but not including) 1.  Two numbers from
+//      the context's generator are put together, as one alone only gives 15 bits.
+
+real_time CExecTimeModel::Random (void)
+    {
+    CSchedulerContext* pContext = GetCurrentContext ();
+    long High = (long)pContext->Random ();
+    long Low = (long)pContext->Random ();
+
+    return ((real_time)((High * (TR_RANDOM_MAX + 1L)) + Low)
+            / ((real_time)(TR_RANDOM_MAX + 1L) * (real_time)(TR_RANDOM_MAX + 1L)));
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Sample
+//      Return the execution time for one run.  Normal times are made with the Box-
+//      Muller method and never come out negative.  Histogram times pick a bin with
+//      chances in proportion to its count, then a time spread evenly within the bin.
+
+real_time CExecTimeModel::Sample (void)
+    {
+    real_time Time;                         //  Time which is given out
+    real_time Uniform;                      //  A random number from 0 to 1
+    long Pick;                              //  Which of the histogram's counts to use
+    int Bin;
+
+    switch (Type)
+        {
+        case EXEC_UNIFORM:
+            return (First + (Second - First) * Random ());
+
+        case EXEC_NORMAL:
+            Uniform = (real_time)1.0 - Random ();       //  Must be above 0 for log()
+            Time = First + Second * (real_time)(sqrt (-2.0 * log ((double)Uniform))
+                                          * cos (2.0 * 3.14159265358979 * Random ()));
+            return ((Time > (real_time)0.0) ? Time : (real_time)0.0);
+
+        case EXEC_HISTOGRAM:
+            Pick = (long)(Random () * (real_time)TotalCount);
+            for (Bin = 0; Bin < NumberOfBins - 1; Bin++)
+                {
+                if (Pick < Counts[Bin])
+                    break;
+                Pick -= Counts[Bin];
+                }
+            return (Minimum + BinSize * ((real_time)Bin + Random ()));
+
+        default:
+            return (First);
+        }
+    }
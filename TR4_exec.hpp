@@ -0,0 +1,84 @@
+//*************************************************************************************
+//  TR4_exec.hpp
+//      This is the header for execution-time models.  In simulation mode a task's
+//      Run() function, or a state's Entry(), Action() and TransitionTest() functions,
+//      take no simulated time at all; only the scheduler's sweeps move the clock.  So
+//      a schedule which would miss deadlines on the target computer runs perfectly in
+//      simulation.  An execution-time model says how long a task or state would take
+//      to run on the target.  Each time the task or state runs in simulation, a time
+//      is drawn from its model and the simulated clock is moved ahead by that much.
+//
+//      A model may be a constant time, a time spread evenly between two limits, a
+//      time with a normal (bell curve) distribution, or a time drawn from a histogram
+//      of the run times which were really measured - for instance by a task's
+//      profiler during a real-time run, saved with CProfiler::Checkpoint() and read
+//      back into a profiler in the simulation.  Random times are taken from the
+//      scheduler context's own generator, so each simulation is still repeatable.
+//
+//      Interrupt-driven tasks can preempt others while time is being used up:  timer
+//      interrupt tasks preempt all other kinds, and preemptible tasks preempt lower
+//      priority preemptible tasks and all background (sample time, event, and
+//      continuous) tasks.  A task which comes due while a task it can preempt is
+//      using up its time is run when it comes due, and the preempted task finishes
+//      that much later.  The functions of the preempted task have already run by
+//      then, so it's the timing, not the data, which is modeled faithfully.
+//
+//      Execution-time models are used in TR_TIME_SIM mode only.  In the real-time
+//      modes the functions take as long as they take; in parallel simulation mode
+//      (TR_TIME_EXTSIM) each process's clock is driven by its sweeps, and the models
+//      are ignored.
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//*************************************************************************************
+
+#ifndef TR4_EXEC_HPP
+    #define  TR4_EXEC_HPP                   //  Variable to prevent multiple inclusions
+
+//  These are the kinds of execution-time models
+enum ExecTimeType
+    {
+    EXEC_CONSTANT,      //  Always the same time
+    EXEC_UNIFORM,       //  Evenly spread between a shortest and longest time
+    EXEC_NORMAL,        //  Normal distribution with a mean and standard deviation
+    EXEC_HISTOGRAM      //  Drawn from a histogram of measured times
+    };
+
+
+//=====================================================================================
+//  Class: CExecTimeModel
+//      An execution-time model gives out a time each time a task or state runs.  The
+//      same model may be shared by several tasks and states.  A histogram model makes
+//      its own copy of the profiler's histogram, so the profiler may go on collecting
+//      data (or be deleted) without changing the model.
+//=====================================================================================
+
+class CExecTimeModel
+    {
+    private:
+        ExecTimeType Type;                  //  What kind of model this is
+        real_time First;                    //  Constant time, shortest time, or mean
+        real_time Second;                   //  Longest time or standard deviation
+        int NumberOfBins;                   //  Number of bins in histogram copy
+        real_time Minimum;                  //  Time at the bottom of the first bin
+        real_time BinSize;                  //  Width of each bin
+        long* Counts;                       //  Count of times which fell in each bin
+        long TotalCount;                    //  Total of all the counts
+
+        real_time Random (void);            //  Get random number from 0 up to 1
+
+    public:
+        CExecTimeModel (real_time);         //  Constant time
+        CExecTimeModel (ExecTimeType,       //  Uniform between two times, or normal
+                        real_time,          //    with a mean and standard deviation
+                        real_time);
+        CExecTimeModel (CProfiler*);        //  Drawn from a profiler's histogram
+        ~CExecTimeModel (void);
+
+        ExecTimeType GetType (void)         //  Find out what kind of model this is
+            { return (Type); }
+        real_time Sample (void);            //  Get a time for one run
+    };
+
+#endif      //  End of multiple-inclusion protection
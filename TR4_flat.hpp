@@ -0,0 +1,146 @@
+//*************************************************************************************
+//  TR4_flat.hpp
+//      This is the header for flat tasks, state-based tasks whose states are a fixed
+//      table of member functions instead of a list of CState objects.  An ordinary
+//      state-based task runs each scan through CTask::Run(), the state's Schedule(),
+//      and the state's Entry(), Action() and TransitionTest(), all virtual, with the
+//      interrupts turned on and off and the profiler's clock read around each one.
+//      That's a lot of work for a small, fast machine in a timer interrupt task.
+//
+//      A flat task's states are numbered, and a table made when the program is
+//      compiled holds each state's name and its entry, action, and transition test
+//      functions, which are ordinary member functions of the user's task class.  Run()
+//      looks the current state up in the table and calls its functions directly, so a
+//      scan is one table lookup and up to three calls.  No state objects are made.
+//      The state number is kept in the task's State variable, just as for a task-
+//      based task, so transitions are written to the transition logic trace and the
+//      journal by CTask::Schedule() in the usual way.
+//
+//      The user's class is derived from CFlatTask, with its own class as the template
+//      argument, and gives its table to SetStateTable() in its constructor:
+//
+//          class CValve : public CFlatTask<CValve>
+//              {
+//              public:
+//                  CValve (void);
+//                  void OpenAction (void);
+//                  long OpenTest (void);
+//                  ...
+//              };
+//
+//          static const CFlatTask<CValve>::FlatState ValveStates[] =
+//              {
+//              {"Open",    NULL, &CValve::OpenAction,  &CValve::OpenTest},
+//              {"Closed",  NULL, &CValve::ClosedAction, &CValve::ClosedTest}
+//              };
+//
+//          CValve::CValve (void) : CFlatTask<CValve> ("Valve", TIMER_INT, 0.001)
+//              { SetStateTable (ValveStates, 2); }
+//
+//      Any of the functions may be NULL.  A transition test returns the number of the
+//      next state, or FLAT_NO_TRANSITION.  The task starts in state 0 unless the
+//      constructor sets State to another number.  As in a state's functions, Idle()
+//      is called when the task has finished its work for this sample time.
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//*************************************************************************************
+
+#ifndef TR4_FLAT_HPP
+    #define  TR4_FLAT_HPP                   //  Variable to prevent multiple inclusions
+
+//  A flat task's transition test returns this if the task is to stay where it is
+#define  FLAT_NO_TRANSITION  -1L
+
+
+//=====================================================================================
+//  Class: CFlatTask
+//      A task which runs a fixed table of states.  The template argument is the
+//      user's class, whose member functions are in the table.
+//=====================================================================================
+
+template <class TMachine> class CFlatTask : public CTask
+    {
+    public:
+        //  Each state in the table has a name and three functions
+        typedef void (TMachine::*FlatFunction) (void);
+        typedef long (TMachine::*FlatTest) (void);
+        struct FlatState
+            {
+            const char* Name;               //  Name of the state
+            FlatFunction Entry;             //  Run when the state is entered
+            FlatFunction Action;            //  Run every scan while in the state
+            FlatTest TransitionTest;        //  Returns the next state's number
+            };
+
+    private:
+        const FlatState* States;            //  The table of states
+        long NumStates;                     //  Number of states in the table
+        boolean Entering;                   //  TRUE if the state's Entry() is to run
+
+    public:
+        CFlatTask (const char* aName, TaskType aType)
+            : CTask (aName, aType)
+            { States = NULL;  NumStates = 0L;  Entering = TRUE; }
+        CFlatTask (const char* aName, TaskType aType, real_time aTimeInt)
+            : CTask (aName, aType, aTimeInt)
+            { States = NULL;  NumStates = 0L;  Entering = TRUE; }
+        CFlatTask (const char* aName, TaskType aType, int aPriority)
+            : CTask (aName, aType, aPriority)
+            { States = NULL;  NumStates = 0L;  Entering = TRUE; }
+        CFlatTask (const char* aName, TaskType aType, int aPriority, real_time aTimeInt)
+            : CTask (aName, aType, aPriority, aTimeInt)
+            { States = NULL;  NumStates = 0L;  Entering = TRUE; }
+
+        void SetStateTable (const FlatState* aStates, int aNumStates)
+            {
+            States = aStates;
+            NumStates = (long)aNumStates;
+            }
+        const char* GetStateName (long aState)
+            {
+            return (((aState >= 0L) && (aState < NumStates))
+                    ? States[aState].Name : "(none)");
+            }
+
+        //  Run the current state's functions straight from the table
+        void Run (void)
+            {
+            const FlatState* pState;        //  Table entry for the current state
+            TMachine* pMachine = (TMachine*)this;
+            long Next;                      //  State to which to make a transition
+
+            if ((State < 0L) || (State >= NumStates))
+                {
+                TR_Exit ("Flat task \"%s\" has no state %ld", Name, State);
+                return;
+                }
+            pState = States + State;
+
+            if (Entering == TRUE)
+                {
+                Entering = FALSE;
+                if (pState->Entry != NULL)
+                    (pMachine->*(pState->Entry)) ();
+                }
+            if (pState->Action != NULL)
+                (pMachine->*(pState->Action)) ();
+            if (pState->TransitionTest != NULL)
+                {
+                Next = (pMachine->*(pState->TransitionTest)) ();
+                if (Next != FLAT_NO_TRANSITION)
+                    {
+                    State = Next;
+                    Entering = TRUE;
+                    }
+                }
+            }
+
+        //  Save whether the state is being entered; CTask saves the state number.  A
+        //  user's class which saves its own data should call this function too
+        void CheckpointData (CCheckpoint* aCheckpoint)
+            { aCheckpoint->Data (&Entering, sizeof (boolean)); }
+    };
+
+#endif      //  End of multiple-inclusion protection
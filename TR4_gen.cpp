@@ -0,0 +1,645 @@
+//*************************************************************************************
+//  TR4_gen.cpp
+//      This is a stand-alone program which writes the C++ code for transition logic
+//      tasks from a description of their states and transitions.  It isn't part of the
+//      TranRun4 library; it's compiled by itself into TR4_gen.exe and run as a step
+//      of building a project, before the project's files are compiled:
+//
+//          TR4_gen machines.tl machines
+//
+//      which reads machines.tl and writes machines.hpp and machines.cpp.  For each
+//      task described, the generated code has a class derived from CFlatTask (see
+//      TR4_flat.hpp) with a constant table of its states, so the states are numbered
+//      in the order in which they're described and are dispatched through a table
+//      made by the compiler; no state objects are made or inserted when the program
+//      starts.  Transitions whose guards are in the description are compiled into
+//      the states' transition test functions.  A function InsertXxxTasks(), where Xxx
+//      is the output's base name, makes all the tasks and puts them in a process.
+//
+//      The description is a text file with one item on each line; anything after
+//      "//" is a comment.  The items are:
+//
+//          task <name> <type> [<priority>] [<sample time>]
+//              Begin a task.  The type is one of the TaskType names except
+//              HARDWARE_INT, for which CTask has no constructor; a priority is given
+//              for all but TIMER_INT and CONTINUOUS tasks and a sample time for
+//              TIMER_INT, SAMPLE_TIME, and PREEMPTIBLE tasks, as for CTask's
+//              constructors.  The class is named C<name>.
+//          variable <name> [<initial value>]
+//              A double member of the task's class, which guards may test.
+//          state <name> [entry] [action] [test]
+//              A state of the task.  The words say which of the state's functions the
+//              user writes, as members named <name>Entry(), <name>Action(), and
+//              <name>Test(); the test returns the number of the next state (ST_<name>)
+//              or FLAT_NO_TRANSITION.  If a state has no action function, the task
+//              idles after each scan in it, as a CState's default Action() does.
+//          initial <state>
+//              The state in which the task starts; otherwise the first one.
+//          transition <from> <to> [when <expression> <comparison> <number>]
+//              Go from one state to another, when the expression (a variable, or
+//              anything else which is one word of C++) compares with the number as
+//              given by <, <=, ==, !=, >=, or >; or, with no "when", at once.  A
+//              state's transitions are tried in the order given, and then its test
+//              function, if it has one.
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//*************************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#define  GEN_LINE_SIZE      512             //  Longest line in a description
+#define  GEN_NAME_SIZE      64              //  Longest name of anything
+#define  GEN_MAX_WORDS      8               //  Most words on a line
+
+//  These are the TaskType names which CTask's constructors take, and which arguments
+//  each type is given.  HARDWARE_INT isn't one of them.
+struct TypeInfo
+    {
+    const char* Name;                       //  Name of the type, as in TR4_task.hpp
+    int HasPriority;                        //  Non-zero if a priority is given
+    int HasTime;                            //  Non-zero if a sample time is given
+    };
+
+static const TypeInfo TaskTypes[] =
+    {
+    {"TIMER_INT",       0,  1},
+    {"PREEMPTIBLE",     1,  1},
+    {"SAMPLE_TIME",     1,  1},
+    {"EVENT",           1,  0},
+    {"CONTINUOUS",      0,  0}
+    };
+#define  NUM_TASK_TYPES  (int)(sizeof (TaskTypes) / sizeof (TypeInfo))
+
+//  A state as described, and its place among the states of its task
+struct GenState
+    {
+    char Name[GEN_NAME_SIZE];
+    int Task;                               //  Index of the task it belongs to
+    int Number;                             //  Number of the state in its task
+    int HasEntry, HasAction, HasTest;       //  Which functions the user writes
+    };
+
+//  A transition, with its guard if it has one
+struct GenTransition
+    {
+    int From, To;                           //  Indices of the states
+    char Expression[GEN_NAME_SIZE];         //  What is compared, or "" if no guard
+    char Comparison[4];                     //  How it's compared
+    char Threshold[GEN_NAME_SIZE];          //  With what it's compared
+    };
+
+//  A variable of a task's class
+struct GenVariable
+    {
+    char Name[GEN_NAME_SIZE];
+    int Task;                               //  Index of the task it belongs to
+    char Initial[GEN_NAME_SIZE];            //  Initial value
+    };
+
+//  A task with its type and constructor arguments
+struct GenTask
+    {
+    char Name[GEN_NAME_SIZE];
+    int Type;                               //  Index in TaskTypes[]
+    char Priority[GEN_NAME_SIZE];
+    char SampleTime[GEN_NAME_SIZE];
+    int Initial;                            //  Index of initial state, or -1
+    int FirstState;                         //  Index of the task's first state
+    int NumStates;                          //  and how many states it has
+    };
+
+//  Everything read from the description is kept in these growing arrays
+static GenTask* Tasks = NULL;
+static int NumTasks = 0;
+static GenState* States = NULL;
+static int NumStates = 0;
+static GenTransition* Transitions = NULL;
+static int NumTransitions = 0;
+static GenVariable* Variables = NULL;
+static int NumVariables = 0;
+
+static const char* InName;                  //  Name of the description file
+static int LineNumber = 0;                  //  Line being read, for error messages
+static int Errors = 0;                      //  Number of errors found
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Error
+//      Print a message about something wrong on the current line of the description,
+//      in the form most editors can jump to, and count the error.
+
+static void Error (const char* aMessage, const char* aWord)
+    {
+    fprintf (stderr, "%s(%d): %s \"%s\"\n", InName, LineNumber, aMessage, aWord);
+    Errors++;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Grow
+//      Make room for one more item at the end of one of the arrays, doubling its size
+//      when it's full.  The arrays of items are plain structures, so they're moved
+//      with realloc().
+
+static void* Grow (void* aArray, int aCount, size_t aSize)
+    {
+    void* NewArray;
+
+    //  The sizes go 16, 32, 64...  so the array is full when the count is zero or is
+    //  16 or more and a power of two
+    if ((aCount != 0) && ((aCount < 16) || ((aCount & (aCount - 1)) != 0)))
+        return (aArray);
+
+    NewArray = realloc (aArray, ((aCount == 0) ? 16 : (aCount * 2)) * aSize);
+    if (NewArray == NULL)
+        {
+        fprintf (stderr, "TR4_gen: out of memory\n");
+        exit (2);
+        }
+    return (NewArray);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: CopyName
+//      Copy a word into a name, checking that it fits and, if asked, that it's a C++
+//      identifier.
+
+static void CopyName (char* aName, const char* aWord, int aIdentifier)
+    {
+    const char* pChar;
+
+    if (strlen (aWord) >= GEN_NAME_SIZE)
+        {
+        Error ("Name is too long:", aWord);
+        aName[0] = '\0';
+        return;
+        }
+    strcpy (aName, aWord);
+
+    if (aIdentifier != 0)
+        {
+        if ((isalpha (aWord[0]) == 0) && (aWord[0] != '_'))
+            Error ("Not a valid name:", aWord);
+        else
+            for (pChar = aWord; *pChar != '\0'; pChar++)
+                if ((isalnum (*pChar) == 0) && (*pChar != '_'))
+                    {
+                    Error ("Not a valid name:", aWord);
+                    break;
+                    }
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: FindState
+//      Find a state of the current task by name, and return its index or -1.  The
+//      search only covers the current task's states, which are together at the end
+//      of the array.
+
+static int FindState (const char* aName)
+    {
+    int Index;
+
+    for (Index = Tasks[NumTasks - 1].FirstState; Index < NumStates; Index++)
+        if (strcmp (States[Index].Name, aName) == 0)
+            return (Index);
+
+    return (-1);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: ReadLine
+//      Handle one line of the description, which has been split into words.
+
+static void ReadLine (char** aWords, int aCount)
+    {
+    GenTask* pTask;
+    GenState* pState;
+    GenTransition* pTrans;
+    GenVariable* pVar;
+    int Index, Next;
+
+    if (aCount == 0)
+        return;
+
+    if (strcmp (aWords[0], "task") == 0)
+        {
+        if (aCount < 3)
+            {
+            Error ("Task needs a name and a type:", aWords[0]);
+            return;
+            }
+        Tasks = (GenTask*)Grow (Tasks, NumTasks, sizeof (GenTask));
+        pTask = Tasks + NumTasks++;
+        CopyName (pTask->Name, aWords[1], 1);
+        pTask->Initial = -1;
+        pTask->FirstState = NumStates;
+        pTask->NumStates = 0;
+        pTask->Priority[0] = '\0';
+        pTask->SampleTime[0] = '\0';
+
+        for (pTask->Type = 0; pTask->Type < NUM_TASK_TYPES; pTask->Type++)
+            if (strcmp (TaskTypes[pTask->Type].Name, aWords[2]) == 0)
+                break;
+        if (pTask->Type >= NUM_TASK_TYPES)
+            {
+            if (strcmp (aWords[2], "HARDWARE_INT") == 0)
+                Error ("No constructor makes a task of type", aWords[2]);
+            else
+                Error ("Unknown task type:", aWords[2]);
+            pTask->Type = NUM_TASK_TYPES - 1;
+            return;
+            }
+
+        Next = 3;
+        if (TaskTypes[pTask->Type].HasPriority != 0)
+            {
+            if (Next < aCount)  CopyName (pTask->Priority, aWords[Next++], 0);
+            else  Error ("Task needs a priority:", pTask->Name);
+            }
+        if (TaskTypes[pTask->Type].HasTime != 0)
+            {
+            if (Next < aCount)  CopyName (pTask->SampleTime, aWords[Next++], 0);
+            else  Error ("Task needs a sample time:", pTask->Name);
+            }
+        if (Next < aCount)
+            Error ("Too many arguments for task:", pTask->Name);
+        return;
+        }
+
+    //  Everything else belongs to a task, so there must be one
+    if (NumTasks == 0)
+        {
+        Error ("This must come after a task:", aWords[0]);
+        return;
+        }
+    pTask = Tasks + NumTasks - 1;
+
+    if (strcmp (aWords[0], "variable") == 0)
+        {
+        if ((aCount < 2) || (aCount > 3))
+            {
+            Error ("Variable needs a name and maybe a value:", aWords[0]);
+            return;
+            }
+        Variables = (GenVariable*)Grow (Variables, NumVariables, sizeof (GenVariable));
+        pVar = Variables + NumVariables++;
+        CopyName (pVar->Name, aWords[1], 1);
+        CopyName (pVar->Initial, (aCount == 3) ? aWords[2] : "0.0", 0);
+        pVar->Task = NumTasks - 1;
+        }
+    else if (strcmp (aWords[0], "state") == 0)
+        {
+        if (aCount < 2)
+            {
+            Error ("State needs a name:", aWords[0]);
+            return;
+            }
+        if (FindState (aWords[1]) >= 0)
+            {
+            Error ("State is described twice:", aWords[1]);
+            return;
+            }
+        States = (GenState*)Grow (States, NumStates, sizeof (GenState));
+        pState = States + NumStates++;
+        CopyName (pState->Name, aWords[1], 1);
+        pState->Task = NumTasks - 1;
+        pState->Number = pTask->NumStates++;
+        pState->HasEntry = pState->HasAction = pState->HasTest = 0;
+        for (Index = 2; Index < aCount; Index++)
+            {
+            if (strcmp (aWords[Index], "entry") == 0)  pState->HasEntry = 1;
+            else if (strcmp (aWords[Index], "action") == 0)  pState->HasAction = 1;
+            else if (strcmp (aWords[Index], "test") == 0)  pState->HasTest = 1;
+            else  Error ("Unknown state function:", aWords[Index]);
+            }
+        }
+    else if (strcmp (aWords[0], "initial") == 0)
+        {
+        if ((aCount != 2) || ((pTask->Initial = FindState (aWords[1])) < 0))
+            Error ("Initial state must be one of the task's states:",
+                   (aCount > 1) ? aWords[1] : aWords[0]);
+        }
+    else if (strcmp (aWords[0], "transition") == 0)
+        {
+        if ((aCount != 3) && ((aCount != 7) || (strcmp (aWords[3], "when") != 0)))
+            {
+            Error ("Transition should be: transition <from> <to> [when <x> <op> <y>]",
+                   aWords[0]);
+            return;
+            }
+        Transitions = (GenTransition*)Grow (Transitions, NumTransitions,
+                                            sizeof (GenTransition));
+        pTrans = Transitions + NumTransitions++;
+        if ((pTrans->From = FindState (aWords[1])) < 0)
+            Error ("Transition from unknown state:", aWords[1]);
+        if ((pTrans->To = FindState (aWords[2])) < 0)
+            Error ("Transition to unknown state:", aWords[2]);
+        pTrans->Expression[0] = '\0';
+        if (aCount == 7)
+            {
+            CopyName (pTrans->Expression, aWords[4], 0);
+            CopyName (pTrans->Threshold, aWords[6], 0);
+            if ((strcmp (aWords[5], "<") != 0) && (strcmp (aWords[5], "<=") != 0)
+                && (strcmp (aWords[5], "==") != 0) && (strcmp (aWords[5], "!=") != 0)
+                && (strcmp (aWords[5], ">=") != 0) && (strcmp (aWords[5], ">") != 0))
+                Error ("Unknown comparison:", aWords[5]);
+            else
+                strcpy (pTrans->Comparison, aWords[5]);
+            }
+        }
+    else
+        Error ("Unknown item:", aWords[0]);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: ReadDescription
+//      Read the description file, splitting each line into words.
+
+static int ReadDescription (void)
+    {
+    FILE* InFile;
+    char Line[GEN_LINE_SIZE];
+    char* Words[GEN_MAX_WORDS + 1];
+    char* pComment;
+    int Count;
+
+    if ((InFile = fopen (InName, "r")) == NULL)
+        {
+        fprintf (stderr, "TR4_gen: can't open \"%s\"\n", InName);
+        return (0);
+        }
+
+    while (fgets (Line, GEN_LINE_SIZE, InFile) != NULL)
+        {
+        LineNumber++;
+        if ((pComment = strstr (Line, "//")) != NULL)
+            *pComment = '\0';
+
+        Count = 0;
+        for (Words[0] = strtok (Line, " \t\r\n"); Words[Count] != NULL;
+             Words[Count] = strtok (NULL, " \t\r\n"))
+            if (++Count > GEN_MAX_WORDS)
+                break;
+
+        if (Count > GEN_MAX_WORDS)
+            Error ("Too many words on line:", Words[0]);
+        else
+            ReadLine (Words, Count);
+        }
+
+    fclose (InFile);
+    return (1);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: NeedsTest
+//      A state gets a generated transition test function if it has transitions to
+//      test or must idle because the user writes no action function for it.
+
+static int NeedsTest (int aState)
+    {
+    int Index;
+
+    if (States[aState].HasAction == 0)
+        return (1);
+    for (Index = 0; Index < NumTransitions; Index++)
+        if (Transitions[Index].From == aState)
+            return (1);
+    return (0);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: WriteHeader
+//      Write the header file, which declares each task's class.
+
+static void WriteHeader (FILE* aFile, const char* aBase)
+    {
+    GenTask* pTask;
+    GenState* pState;
+    int Task, Index;
+
+    fprintf (aFile, "//  %s.hpp - written by TR4_gen from %s; do not edit\n\n",
+             aBase, InName);
+    fprintf (aFile, "#ifndef GEN_%s_HPP\n    #define  GEN_%s_HPP\n\n", aBase, aBase);
+
+    for (Task = 0; Task < NumTasks; Task++)
+        {
+        pTask = Tasks + Task;
+        fprintf (aFile, "class C%s : public CFlatTask<C%s>\n    {\n", pTask->Name,
+                 pTask->Name);
+        fprintf (aFile, "    public:\n        enum\n            {\n");
+        for (Index = 0; Index < pTask->NumStates; Index++)
+            fprintf (aFile, "            ST_%s = %d%s\n",
+                     States[pTask->FirstState + Index].Name, Index,
+                     (Index < pTask->NumStates - 1) ? "," : "");
+        fprintf (aFile, "            };\n\n");
+
+        for (Index = 0; Index < NumVariables; Index++)
+            if (Variables[Index].Task == Task)
+                fprintf (aFile, "        double %s;\n", Variables[Index].Name);
+
+        fprintf (aFile, "\n        C%s (void);\n\n", pTask->Name);
+        fprintf (aFile, "        //  These functions are written by the user, and the\n");
+        fprintf (aFile, "        //  Guards() functions test the described transitions\n");
+        for (pState = States + pTask->FirstState;
+             pState < States + pTask->FirstState + pTask->NumStates; pState++)
+            {
+            if (pState->HasEntry != 0)
+                fprintf (aFile, "        void %sEntry (void);\n", pState->Name);
+            if (pState->HasAction != 0)
+                fprintf (aFile, "        void %sAction (void);\n", pState->Name);
+            if (pState->HasTest != 0)
+                fprintf (aFile, "        long %sTest (void);\n", pState->Name);
+            }
+
+        for (Index = pTask->FirstState; Index < pTask->FirstState + pTask->NumStates;
+             Index++)
+            if (NeedsTest (Index) != 0)
+                fprintf (aFile, "        long %sGuards (void);\n", States[Index].Name);
+        fprintf (aFile, "    };\n\n");
+        }
+
+    fprintf (aFile, "void Insert%sTasks (CProcess*);\n\n#endif\n", aBase);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: WriteSource
+//      Write the source file, which holds each task's state table, its constructor,
+//      and the transition test functions, and the function which makes the tasks.
+
+static void WriteSource (FILE* aFile, const char* aBase)
+    {
+    GenTask* pTask;
+    GenState* pState;
+    GenTransition* pTrans;
+    int Task, Index, Trans;
+
+    fprintf (aFile, "//  %s.cpp - written by TR4_gen from %s; do not edit\n\n",
+             aBase, InName);
+    fprintf (aFile, "#include <TranRun4.hpp>\n#include \"%s.hpp\"\n\n", aBase);
+
+    for (Task = 0; Task < NumTasks; Task++)
+        {
+        pTask = Tasks + Task;
+
+        //  The table of states, made by the compiler
+        fprintf (aFile, "\nstatic const CFlatTask<C%s>::FlatState %sStates[%d] =\n    {\n",
+                 pTask->Name, pTask->Name, pTask->NumStates);
+        for (Index = 0; Index < pTask->NumStates; Index++)
+            {
+            pState = States + pTask->FirstState + Index;
+            fprintf (aFile, "    {\"%s\", ", pState->Name);
+            if (pState->HasEntry != 0)
+                fprintf (aFile, "&C%s::%sEntry, ", pTask->Name, pState->Name);
+            else
+                fprintf (aFile, "NULL, ");
+            if (pState->HasAction != 0)
+                fprintf (aFile, "&C%s::%sAction, ", pTask->Name, pState->Name);
+            else
+                fprintf (aFile, "NULL, ");
+            if (NeedsTest (pTask->FirstState + Index) != 0)
+                fprintf (aFile, "&C%s::%sGuards", pTask->Name, pState->Name);
+            else if (pState->HasTest != 0)
+                fprintf (aFile, "&C%s::%sTest", pTask->Name, pState->Name);
+            else
+                fprintf (aFile, "NULL");
+            fprintf (aFile, "}%s\n", (Index < pTask->NumStates - 1) ? "," : "");
+            }
+        fprintf (aFile, "    };\n\n");
+
+        //  The constructor passes the type's arguments on to CFlatTask
+        fprintf (aFile, "C%s::C%s (void)\n    : CFlatTask<C%s> (\"%s\", %s",
+                 pTask->Name, pTask->Name, pTask->Name, pTask->Name,
+                 TaskTypes[pTask->Type].Name);
+        if (pTask->Priority[0] != '\0')
+            fprintf (aFile, ", %s", pTask->Priority);
+        if (pTask->SampleTime[0] != '\0')
+            fprintf (aFile, ", (real_time)%s", pTask->SampleTime);
+        fprintf (aFile, ")\n    {\n");
+        for (Index = 0; Index < NumVariables; Index++)
+            if (Variables[Index].Task == Task)
+                fprintf (aFile, "    %s = %s;\n", Variables[Index].Name,
+                         Variables[Index].Initial);
+        if (pTask->Initial >= 0)
+            fprintf (aFile, "    State = ST_%s;\n", States[pTask->Initial].Name);
+        fprintf (aFile, "    SetStateTable (%sStates, %d);\n    }\n\n", pTask->Name,
+                 pTask->NumStates);
+
+        //  A transition test function for each state which needs one
+        for (Index = pTask->FirstState; Index < pTask->FirstState + pTask->NumStates;
+             Index++)
+            {
+            if (NeedsTest (Index) == 0)
+                continue;
+            pState = States + Index;
+            fprintf (aFile, "long C%s::%sGuards (void)\n    {\n", pTask->Name,
+                     pState->Name);
+            if (pState->HasAction == 0)
+                fprintf (aFile, "    Idle ();\n");
+            //  Nothing after a transition with no guard would ever be reached
+            for (Trans = 0; Trans < NumTransitions; Trans++)
+                {
+                pTrans = Transitions + Trans;
+                if (pTrans->From != Index)
+                    continue;
+                if (pTrans->Expression[0] == '\0')
+                    break;
+                fprintf (aFile, "    if (%s %s %s)\n        return (ST_%s);\n",
+                         pTrans->Expression, pTrans->Comparison, pTrans->Threshold,
+                         States[pTrans->To].Name);
+                }
+            if (Trans < NumTransitions)
+                fprintf (aFile, "    return (ST_%s);\n    }\n\n",
+                         States[Transitions[Trans].To].Name);
+            else if (pState->HasTest != 0)
+                fprintf (aFile, "    return (%sTest ());\n    }\n\n", pState->Name);
+            else
+                fprintf (aFile, "    return (FLAT_NO_TRANSITION);\n    }\n\n");
+            }
+        }
+
+    //  The function which makes the tasks
+    fprintf (aFile, "\nvoid Insert%sTasks (CProcess* aProcess)\n    {\n", aBase);
+    for (Task = 0; Task < NumTasks; Task++)
+        fprintf (aFile, "    aProcess->InsertTask (new C%s);\n", Tasks[Task].Name);
+    fprintf (aFile, "    }\n");
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: main
+//      Read the description named on the command line and write the header and source
+//      files.  Nothing is written if there are any errors in the description.
+
+int main (int argc, char** argv)
+    {
+    char OutName[GEN_LINE_SIZE];
+    const char* pBase;
+    FILE* OutFile;
+    int Task;
+
+    if ((argc != 3) || (strlen (argv[2]) + 5 > GEN_LINE_SIZE))
+        {
+        fprintf (stderr, "Usage: TR4_gen <description file> <output base name>\n");
+        return (1);
+        }
+    InName = argv[1];
+
+    if (ReadDescription () == 0)
+        return (1);
+
+    for (Task = 0; Task < NumTasks; Task++)
+        if (Tasks[Task].NumStates == 0)
+            {
+            LineNumber = 0;
+            Error ("Task has no states:", Tasks[Task].Name);
+            }
+    if (Errors > 0)
+        {
+        fprintf (stderr, "TR4_gen: %d error(s); no files written\n", Errors);
+        return (1);
+        }
+
+    //  The base name, without any directory, names the generated function
+    pBase = argv[2] + strlen (argv[2]);
+    while ((pBase > argv[2]) && (strchr ("/\\:", pBase[-1]) == NULL))
+        pBase--;
+    CopyName (OutName, pBase, 1);
+    if (Errors > 0)
+        return (1);
+
+    sprintf (OutName, "%s.hpp", argv[2]);
+    if ((OutFile = fopen (OutName, "w")) == NULL)
+        {
+        fprintf (stderr, "TR4_gen: can't write \"%s\"\n", OutName);
+        return (1);
+        }
+    WriteHeader (OutFile, pBase);
+    fclose (OutFile);
+
+    sprintf (OutName, "%s.cpp", argv[2]);
+    if ((OutFile = fopen (OutName, "w")) == NULL)
+        {
+        fprintf (stderr, "TR4_gen: can't write \"%s\"\n", OutName);
+        return (1);
+        }
+    WriteSource (OutFile, pBase);
+    fclose (OutFile);
+
+    printf ("TR4_gen: %d tasks, %d states, %d transitions\n", NumTasks, NumStates,
+            NumTransitions);
+    return (0);
+    }
@@ -0,0 +1,420 @@
+//*************************************************************************************
+//  TR4_intg.cpp
+//      This file contains the implementation of the integrator tasks, which simulate
+//      plants described by ordinary differential equations.
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//*************************************************************************************
+
+#include <math.h>
+#include <string.h>
+#include <TranRun4.hpp>
+
+
+//-------------------------------------------------------------------------------------
+//  Vector functions
+//      The integration methods are built from these few operations on whole state
+//      vectors.  Each is one plain loop over contiguous arrays, which an optimizing
+//      compiler can turn into vector instructions.
+
+//  Copy one vector into another
+static void CopyVector (double* aTo, const double* aFrom, int aSize)
+    {
+    for (int Index = 0; Index < aSize; Index++)
+        aTo[Index] = aFrom[Index];
+    }
+
+//  Add a multiple of one vector to another:  aTo = aTo + aScale * aRate
+static void AddScaled (double* aTo, double aScale, const double* aRate, int aSize)
+    {
+    for (int Index = 0; Index < aSize; Index++)
+        aTo[Index] += aScale * aRate[Index];
+    }
+
+//  Start a trial state from the current one:  aTo = aFrom + aScale * aRate
+static void Extrapolate (double* aTo, const double* aFrom, double aScale,
+                         const double* aRate, int aSize)
+    {
+    for (int Index = 0; Index < aSize; Index++)
+        aTo[Index] = aFrom[Index] + aScale * aRate[Index];
+    }
+
+
+//=====================================================================================
+//  Class: CIntegratorTask
+//      Holds the state vector and runs one sample time of integration per run.
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+//  Constructor: CIntegratorTask
+//      An integrator task is a sample time task.  Its state vector starts out all
+//      zeros and its integration time at zero; the user's constructor should set up
+//      the initial state.
+
+CIntegratorTask::CIntegratorTask (const char* aName, int aPriority,
+                                  real_time aSampleTime, int aNumStates)
+    : CTask (aName, SAMPLE_TIME, aPriority, aSampleTime)
+    {
+    if (aNumStates < 1)
+        TR_Exit ("Integrator task \"%s\" has no states", aName);
+
+    NumStates = (aNumStates > 0) ? aNumStates : 1;
+    Time = (real_time)0.0;
+    State = NewWorkArray (1);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Destructor: ~CIntegratorTask
+
+CIntegratorTask::~CIntegratorTask (void)
+    {
+    DELETE_ARRAY State;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: NewWorkArray
+//      Allocate the given number of state vectors, one after another in a single
+//      array, and set them all to zero.
+
+double* CIntegratorTask::NewWorkArray (int aVectors)
+    {
+    double* pArray;                         //  The new array
+    long Size = (long)aVectors * (long)NumStates;
+
+    if ((pArray = new double[Size]) == NULL)
+        {
+        TR_Exit ("Unable to allocate memory for integrator task \"%s\"", GetName ());
+        return (NULL);
+        }
+    for (long Index = 0; Index < Size; Index++)
+        pArray[Index] = 0.0;
+
+    return (pArray);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Functions: BeforeStep and AfterStep
+//      These do nothing unless the user overrides them.
+
+void CIntegratorTask::BeforeStep (void)
+    {
+    }
+
+void CIntegratorTask::AfterStep (void)
+    {
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Run
+//      Each time the scheduler runs the task, it integrates over one sample time, then
+//      idles until the next sample time.
+
+void CIntegratorTask::Run (void)
+    {
+    BeforeStep ();
+    Integrate (GetSampleTime ());
+    AfterStep ();
+    Idle ();
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: SetState
+//      Copy a whole new state vector in, e.g. to set initial conditions.
+
+void CIntegratorTask::SetState (const double* aState)
+    {
+    CopyVector (State, aState, NumStates);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: CheckpointData
+//      Save or restore the state vector and the integration time.  A user's class
+//      which overrides this function to save its own data should call this one too.
+
+void CIntegratorTask::CheckpointData (CCheckpoint* aCheckpoint)
+    {
+    aCheckpoint->Count (NumStates, "integrator states");
+    aCheckpoint->Data (&Time, sizeof (real_time));
+    aCheckpoint->Data (State, NumStates * sizeof (double));
+    }
+
+
+//=====================================================================================
+//  Class: CRungeKutta4Task
+//      Classical fourth-order Runge-Kutta integration.
+//=====================================================================================
+
+CRungeKutta4Task::CRungeKutta4Task (const char* aName, int aPriority,
+                                    real_time aSampleTime, int aNumStates)
+    : CIntegratorTask (aName, aPriority, aSampleTime, aNumStates)
+    {
+    Work = NewWorkArray (5);
+    }
+
+CRungeKutta4Task::~CRungeKutta4Task (void)
+    {
+    DELETE_ARRAY Work;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Integrate
+//      Take one step of the given size.  The four stage rates are weighted 1/6, 1/3,
+//      1/3, 1/6 and added to the state.
+
+void CRungeKutta4Task::Integrate (real_time aStep)
+    {
+    double* K1 = Work;                      //  Rates at each of the four stages
+    double* K2 = Work + NumStates;
+    double* K3 = Work + 2 * NumStates;
+    double* K4 = Work + 3 * NumStates;
+    double* Trial = Work + 4 * NumStates;   //  State at which rates are found
+    double Half = (double)aStep / 2.0;
+
+    Derivatives (Time, State, K1);
+    Extrapolate (Trial, State, Half, K1, NumStates);
+    Derivatives (Time + (real_time)Half, Trial, K2);
+    Extrapolate (Trial, State, Half, K2, NumStates);
+    Derivatives (Time + (real_time)Half, Trial, K3);
+    Extrapolate (Trial, State, (double)aStep, K3, NumStates);
+    Derivatives (Time + aStep, Trial, K4);
+
+    AddScaled (State, (double)aStep / 6.0, K1, NumStates);
+    AddScaled (State, (double)aStep / 3.0, K2, NumStates);
+    AddScaled (State, (double)aStep / 3.0, K3, NumStates);
+    AddScaled (State, (double)aStep / 6.0, K4, NumStates);
+    Time += aStep;
+    }
+
+
+//=====================================================================================
+//  Class: CRungeKutta45Task
+//      Dormand-Prince 5(4) integration with step size control.
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+//  Dormand-Prince coefficients
+//      DP_C are the stage times, DP_A the weights of earlier stages in each stage's
+//      trial state (row by row, lower triangle), DP_B the weights of the fifth-order
+//      solution, and DP_E the differences between the fifth- and fourth-order
+//      weights, which give the error estimate.  The last stage is at the new state,
+//      so its rates are the first stage's rates for the next step.
+
+static const double DP_C[7] = {0.0, 1.0/5.0, 3.0/10.0, 4.0/5.0, 8.0/9.0, 1.0, 1.0};
+
+static const double DP_A[7][6] =
+    {
+    {0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+    {1.0/5.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+    {3.0/40.0, 9.0/40.0, 0.0, 0.0, 0.0, 0.0},
+    {44.0/45.0, -56.0/15.0, 32.0/9.0, 0.0, 0.0, 0.0},
+    {19372.0/6561.0, -25360.0/2187.0, 64448.0/6561.0, -212.0/729.0, 0.0, 0.0},
+    {9017.0/3168.0, -355.0/33.0, 46732.0/5247.0, 49.0/176.0, -5103.0/18656.0, 0.0},
+    {35.0/384.0, 0.0, 500.0/1113.0, 125.0/192.0, -2187.0/6784.0, 11.0/84.0}
+    };
+
+static const double DP_E[7] =
+    {
+    71.0/57600.0, 0.0, -71.0/16695.0, 71.0/1920.0, -17253.0/339200.0, 22.0/525.0,
+    -1.0/40.0
+    };
+
+
+//-------------------------------------------------------------------------------------
+//  Constructor and destructor:  CRungeKutta45Task
+//      The tolerances start at 1E-6 absolute and relative, and the first step tried
+//      is the whole sample time.
+
+CRungeKutta45Task::CRungeKutta45Task (const char* aName, int aPriority,
+                                      real_time aSampleTime, int aNumStates)
+    : CIntegratorTask (aName, aPriority, aSampleTime, aNumStates)
+    {
+    Work = NewWorkArray (9);
+    AbsTolerance = 1E-6;
+    RelTolerance = 1E-6;
+    StepSize = aSampleTime;
+    StepsTaken = 0L;
+    StepsRejected = 0L;
+    }
+
+CRungeKutta45Task::~CRungeKutta45Task (void)
+    {
+    DELETE_ARRAY Work;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: SetTolerance
+//      Set the absolute and relative error allowed in each step.
+
+void CRungeKutta45Task::SetTolerance (double aAbsolute, double aRelative)
+    {
+    if ((aAbsolute < 0.0) || (aRelative < 0.0) || ((aAbsolute + aRelative) <= 0.0))
+        TR_Exit ("Invalid integrator tolerances for task \"%s\"", GetName ());
+
+    AbsTolerance = aAbsolute;
+    RelTolerance = aRelative;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Integrate
+//      Cover the given time with as many steps as it takes.  After each step, the
+//      error estimate is compared with the tolerances:  if it's too big the step is
+//      taken over with a smaller size; either way, the next step size is chosen from
+//      how big the error was.  The last step is shortened to end exactly at the end
+//      of the sample time, but the size which was chosen is kept for next time.
+
+void CRungeKutta45Task::Integrate (real_time aStep)
+    {
+    double* K[7];                           //  Rates at each of the seven stages
+    double* Trial = Work + 7 * NumStates;   //  State at which rates are found
+    double* NewState = Work + 8 * NumStates;//  Fifth-order state after the step
+    real_time EndTime = Time + aStep;       //  Time at the end of the sample time
+    real_time Step;                         //  Size of the step being tried
+    double* Swap;                           //  Used to swap stage rate arrays
+    double Error;                           //  Scaled size of the error estimate
+    double Scale;                           //  Allowed error in one state
+    double Factor;                          //  Change in step size
+    long Steps = 0L;                        //  Steps tried in this sample time
+    int Stage, Index;
+
+    for (Stage = 0; Stage < 7; Stage++)
+        K[Stage] = Work + Stage * NumStates;
+
+    Derivatives (Time, State, K[0]);
+    while (Time < EndTime)
+        {
+        if (++Steps > MAX_INTEGRATOR_STEPS)
+            {
+            TR_Exit ("Integrator task \"%s\" can't meet its tolerance at time %g",
+                     GetName (), (double)Time);
+            return;
+            }
+
+        //  Don't step past the end of the sample time; if nearly there, go all the way
+        Step = StepSize;
+        if ((Time + Step * 1.01) >= EndTime)
+            Step = EndTime - Time;
+
+        //  Find the rates at stages 2 through 7; stage 7 is at the new state
+        for (Stage = 1; Stage < 7; Stage++)
+            {
+            CopyVector (Trial, State, NumStates);
+            for (int Prior = 0; Prior < Stage; Prior++)
+                if (DP_A[Stage][Prior] != 0.0)
+                    AddScaled (Trial, Step * DP_A[Stage][Prior], K[Prior], NumStates);
+            if (Stage == 6)
+                CopyVector (NewState, Trial, NumStates);
+            Derivatives (Time + (real_time)(Step * DP_C[Stage]), Trial, K[Stage]);
+            }
+
+        //  Work out the error estimate in Trial, then its root-mean-square size
+        //  relative to the tolerance
+        for (Index = 0; Index < NumStates; Index++)
+            Trial[Index] = 0.0;
+        for (Stage = 0; Stage < 7; Stage++)
+            if (DP_E[Stage] != 0.0)
+                AddScaled (Trial, Step * DP_E[Stage], K[Stage], NumStates);
+        Error = 0.0;
+        for (Index = 0; Index < NumStates; Index++)
+            {
+            Scale = AbsTolerance + RelTolerance
+                    * ((fabs (State[Index]) > fabs (NewState[Index]))
+                       ? fabs (State[Index]) : fabs (NewState[Index]));
+            Error += (Trial[Index] / Scale) * (Trial[Index] / Scale);
+            }
+        Error = sqrt (Error / (double)NumStates);
+
+        //  Choose the next step size, not changing it by more than a factor of five
+        if (Error == 0.0)
+            Factor = 5.0;
+        else
+            {
+            Factor = 0.9 * pow (Error, -0.2);
+            if (Factor > 5.0)  Factor = 5.0;
+            if (Factor < 0.2)  Factor = 0.2;
+            }
+
+        if (Error > 1.0)
+            {
+            StepsRejected++;
+            StepSize = Step * Factor;
+            continue;
+            }
+
+        //  The step is good:  keep the new state, and reuse the last stage's rates as
+        //  the first stage's rates of the next step.  If the step was cut short to
+        //  end the sample time, don't let that shrink the next one
+        StepsTaken++;
+        CopyVector (State, NewState, NumStates);
+        Swap = K[0];
+        K[0] = K[6];
+        K[6] = Swap;
+        if ((Step == StepSize) || ((Step * Factor) > StepSize))
+            StepSize = Step * Factor;
+        Time = (Time + Step >= EndTime) ? EndTime : Time + Step;
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: CheckpointData
+//      Save the step size along with the state, so a restored run takes the same
+//      steps as one which went on without stopping.
+
+void CRungeKutta45Task::CheckpointData (CCheckpoint* aCheckpoint)
+    {
+    CIntegratorTask::CheckpointData (aCheckpoint);
+    aCheckpoint->Data (&StepSize, sizeof (real_time));
+    aCheckpoint->Data (&StepsTaken, sizeof (long));
+    aCheckpoint->Data (&StepsRejected, sizeof (long));
+    }
+
+
+//=====================================================================================
+//  Class: CSemiImplicitEulerTask
+//      Semi-implicit Euler integration of positions and velocities.
+//=====================================================================================
+
+CSemiImplicitEulerTask::CSemiImplicitEulerTask (const char* aName, int aPriority,
+                                                real_time aSampleTime, int aNumStates)
+    : CIntegratorTask (aName, aPriority, aSampleTime, aNumStates)
+    {
+    if ((aNumStates % 2) != 0)
+        TR_Exit ("Semi-implicit Euler task \"%s\" needs positions and velocities, "
+                 "but has %d states", aName, aNumStates);
+
+    Work = NewWorkArray (1);
+    }
+
+CSemiImplicitEulerTask::~CSemiImplicitEulerTask (void)
+    {
+    DELETE_ARRAY Work;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Integrate
+//      Take one step:  the velocities (second half of the state) are moved on with
+//      the accelerations at the old state, then the positions (first half) with the
+//      rates found from the new velocities.
+
+void CSemiImplicitEulerTask::Integrate (real_time aStep)
+    {
+    int Half = NumStates / 2;               //  Number of positions (and velocities)
+
+    Derivatives (Time, State, Work);
+    AddScaled (State + Half, (double)aStep, Work + Half, Half);
+    Derivatives (Time, State, Work);
+    AddScaled (State, (double)aStep, Work, Half);
+    Time += aStep;
+    }
@@ -0,0 +1,163 @@
+//*************************************************************************************
+//  TR4_intg.hpp
+//      This is the header for integrator tasks, which simulate plants described by
+//      ordinary differential equations.  The user derives a class from one of the
+//      integrator tasks and overrides Derivatives(), which is given the time and the
+//      state vector and fills in the state's rates of change.  Each time the task
+//      runs, it integrates the equations over one sample time, so a plant model's
+//      sample time is its integration step.  BeforeStep() and AfterStep() may be
+//      overridden too, e.g. to read the controller's outputs from the data bus
+//      before each step and to publish the plant's measurements after it.
+//
+//      Three methods are given:
+//        CRungeKutta4Task     - Classical fourth-order Runge-Kutta, with one step per
+//                               sample time.  Good for smooth, non-stiff plants.
+//        CRungeKutta45Task    - Dormand-Prince fifth-order Runge-Kutta with a fourth-
+//                               order error estimate.  Each sample time is covered
+//                               with as many steps as are needed to keep the error
+//                               within the tolerances given to SetTolerance().
+//        CSemiImplicitEulerTask - Semi-implicit (symplectic) Euler for mechanical
+//                               systems.  The states are positions followed by
+//                               velocities; the velocities are updated first, and the
+//                               positions then use the new velocities.  It's cheap and
+//                               keeps the energy of an oscillator from drifting.
+//
+//      The state vector is kept in one array, and the methods work on it with simple
+//      loops over whole arrays, so an optimizing compiler can use vector instructions
+//      for them.  Derivatives() should work the same way where it can.  The state is
+//      saved in checkpoints along with the task; a user's class which overrides
+//      CheckpointData() should call its integrator class's version too.
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//*************************************************************************************
+
+#ifndef TR4_INTG_HPP
+    #define  TR4_INTG_HPP                   //  Variable to prevent multiple inclusions
+
+//  An adaptive integrator gives up if it needs more than this many steps to get across
+//  one sample time
+#define  MAX_INTEGRATOR_STEPS  100000L
+
+
+//=====================================================================================
+//  Class: CIntegratorTask
+//      This is the base class for integrator tasks.  It's a sample time task which
+//      holds the state vector and its own integration time, and runs one sample
+//      time's worth of integration each time it's scheduled.  The integration time
+//      goes up by exactly one sample time per run, so it doesn't pick up the small
+//      differences in the times at which the scheduler gets around to the task.
+//=====================================================================================
+
+class CIntegratorTask : public CTask
+    {
+    protected:
+        int NumStates;                      //  Number of states in the vector
+        double* State;                      //  The state vector
+        real_time Time;                     //  Integration time at the state
+
+        double* NewWorkArray (int);         //  Allocate scratch arrays of states
+
+        //  Each method integrates the state from Time over the given step
+        virtual void Integrate (real_time) = 0;
+
+    public:
+        CIntegratorTask (const char*, int,  //  Constructor is given name, priority,
+                         real_time, int);   //    sample time, and number of states
+        virtual ~CIntegratorTask (void);
+
+        //  The user's class computes the derivatives of the state at a given time
+        virtual void Derivatives (real_time, const double*, double*) = 0;
+        virtual void BeforeStep (void);     //  User may read inputs here
+        virtual void AfterStep (void);      //  and write outputs here
+
+        void Run (void);                    //  Integrate over one sample time
+        void CheckpointData (CCheckpoint*); //  Save or restore state and time
+
+        int GetNumStates (void)             //  Find the number of states
+            { return (NumStates); }
+        double* GetState (void)             //  Get a pointer to the state vector,
+            { return (State); }             //    which may be read or changed
+        void SetState (const double*);      //  Copy in a whole new state vector
+        real_time GetIntegrationTime (void) //  Find the time at which the state
+            { return (Time); }              //    vector is
+    };
+
+
+//=====================================================================================
+//  Class: CRungeKutta4Task
+//      Fixed-step fourth-order Runge-Kutta integration.
+//=====================================================================================
+
+class CRungeKutta4Task : public CIntegratorTask
+    {
+    private:
+        double* Work;                       //  Scratch arrays:  four stage rates
+                                            //    and a trial state
+    protected:
+        void Integrate (real_time);
+
+    public:
+        CRungeKutta4Task (const char*, int, real_time, int);
+        ~CRungeKutta4Task (void);
+    };
+
+
+//=====================================================================================
+//  Class: CRungeKutta45Task
+//      Adaptive Dormand-Prince 5(4) integration.  The step size which worked last
+//      time is tried first next time, so a smooth plant usually takes only a step or
+//      two per sample time.  The error in each step is kept below the absolute
+//      tolerance plus the relative tolerance times the size of each state.
+//=====================================================================================
+
+class CRungeKutta45Task : public CIntegratorTask
+    {
+    private:
+        double* Work;                       //  Scratch arrays:  seven stage rates,
+                                            //    a trial state, and a new state
+        double AbsTolerance;                //  Tolerances for the error in each step
+        double RelTolerance;
+        real_time StepSize;                 //  Step size to try next
+        long StepsTaken;                    //  Steps which were accepted
+        long StepsRejected;                 //  and those which had to be done over
+
+    protected:
+        void Integrate (real_time);
+
+    public:
+        CRungeKutta45Task (const char*, int, real_time, int);
+        ~CRungeKutta45Task (void);
+
+        void SetTolerance (double, double); //  Set absolute and relative tolerance
+        void CheckpointData (CCheckpoint*); //  Save step size along with the state
+        long GetStepsTaken (void)           //  Find how many steps were taken and
+            { return (StepsTaken); }        //    how many had to be taken over
+        long GetStepsRejected (void)        //    with a smaller step size
+            { return (StepsRejected); }
+    };
+
+
+//=====================================================================================
+//  Class: CSemiImplicitEulerTask
+//      Semi-implicit Euler integration for a system whose state is a set of positions
+//      followed by the same number of velocities.  Derivatives() fills in the rates
+//      of the positions (usually the velocities) and of the velocities (the accelera-
+//      tions); it's called twice per step.
+//=====================================================================================
+
+class CSemiImplicitEulerTask : public CIntegratorTask
+    {
+    private:
+        double* Work;                       //  Scratch array for the derivatives
+
+    protected:
+        void Integrate (real_time);
+
+    public:
+        CSemiImplicitEulerTask (const char*, int, real_time, int);
+        ~CSemiImplicitEulerTask (void);
+    };
+
+#endif      //  End of multiple-inclusion protection
@@ -0,0 +1,216 @@
+//*************************************************************************************
+//  TR4_jrnl.cpp
+//      This file contains the implementation of the journal class, which records the
+//      unpredictable inputs to a scheduler run so that the run can be replayed.
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//*************************************************************************************
+
+#include <stdio.h>
+#include <string.h>
+#include <TranRun4.hpp>
+
+
+//-------------------------------------------------------------------------------------
+//  Journal File Header
+//      Each journal file begins with these four characters, then one byte each giving
+//      the sizes of a real_time and a long.  A journal can only be replayed by a
+//      program which was compiled with the same sizes.
+
+static const char JournalTag[] = "TR4J";
+
+
+//=====================================================================================
+//  Class: CJournal
+//      Records and replays the unpredictable inputs to a scheduler run.
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+//  Constructor: CJournal
+//      Open the journal file for writing (in record mode) or reading (in replay
+//      mode).  When recording, the header is written; when replaying, it's checked.
+
+CJournal::CJournal (const char* aFileName, JournalMode aMode)
+    {
+    char Header[6];                         //  Tag and data sizes at top of file
+
+    Mode = aMode;
+    RecordCount = 0L;
+
+    if (Mode == JOURNAL_RECORD)
+        JournalFile = fopen (aFileName, "wb");
+    else
+        JournalFile = fopen (aFileName, "rb");
+    if (JournalFile == NULL)
+        {
+        TR_Exit ("Can't open journal file %s", aFileName);
+        return;
+        }
+
+    if (Mode == JOURNAL_RECORD)
+        {
+        memcpy (Header, JournalTag, 4);
+        Header[4] = (char)sizeof (real_time);
+        Header[5] = (char)sizeof (long);
+        fwrite (Header, 1, 6, JournalFile);
+        }
+    else
+        {
+        if ((fread (Header, 1, 6, JournalFile) != 6)
+            || (memcmp (Header, JournalTag, 4) != 0))
+            TR_Exit ("File %s is not a scheduler journal", aFileName);
+        else if ((Header[4] != (char)sizeof (real_time))
+                 || (Header[5] != (char)sizeof (long)))
+            TR_Exit ("Journal %s was made by a program with different data sizes",
+                     aFileName);
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Destructor: ~CJournal
+//      Close the journal file, which makes sure all the records are written to disk.
+
+CJournal::~CJournal (void)
+    {
+    if (JournalFile != NULL)
+        fclose (JournalFile);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Functions: WriteRecord and ReadRecord
+//      These functions write and read one record:  a type character, then the data.
+//      If the record read back isn't of the type expected, the replay has gone
+//      differently from the recorded run, so we stop it.  We also stop at the end of
+//      the journal, as there's no more recorded input with which to go on.
+
+void CJournal::WriteRecord (char aType, const void* aData, unsigned aSize)
+    {
+    if (JournalFile == NULL)
+        return;
+
+    fputc (aType, JournalFile);
+    fwrite (aData, 1, aSize, JournalFile);
+    RecordCount++;
+    }
+
+void CJournal::ReadRecord (char aType, void* aData, unsigned aSize)
+    {
+    int Type;                               //  Type character read from the file
+
+    if (JournalFile == NULL)
+        return;
+
+    if ((Type = fgetc (JournalFile)) == EOF)
+        {
+        TR_Exit ("Replay has reached the end of the journal after %ld records",
+                 RecordCount);
+        fclose (JournalFile);
+        JournalFile = NULL;
+        return;
+        }
+    if ((char)Type != aType)
+        {
+        TR_Exit ("Replay differs from journal at record %ld: journal has '%c', "
+                 "replay wants '%c'", RecordCount, (char)Type, aType);
+        fclose (JournalFile);
+        JournalFile = NULL;
+        return;
+        }
+    if (fread (aData, 1, aSize, JournalFile) != aSize)
+        {
+        TR_Exit ("Journal record %ld is incomplete", RecordCount);
+        fclose (JournalFile);
+        JournalFile = NULL;
+        return;
+        }
+    RecordCount++;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Time
+//      In record mode, save the given clock reading and return it.  In replay mode,
+//      return the reading which was saved at this point in the recorded run.  If the
+//      replay has stopped, the time just stays where it is.
+
+real_time CJournal::Time (real_time aTime)
+    {
+    if (Mode == JOURNAL_RECORD)
+        WriteRecord (JR_TIME, &aTime, sizeof (real_time));
+    else
+        ReadRecord (JR_TIME, &aTime, sizeof (real_time));
+
+    return (aTime);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Key
+//      Save or replay the result of checking the keyboard, which is a key code or -1
+//      if no key had been pressed.
+
+int CJournal::Key (int aKey)
+    {
+    long KeyCode = (long)aKey;
+
+    if (Mode == JOURNAL_RECORD)
+        WriteRecord (JR_KEY, &KeyCode, sizeof (long));
+    else
+        {
+        KeyCode = -1L;
+        ReadRecord (JR_KEY, &KeyCode, sizeof (long));
+        }
+
+    return ((int)KeyCode);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Check
+//      Save a record of something which the tasks did (triggering an event or making
+//      a state transition), or during replay, make sure that the tasks did the same
+//      thing at the same point as in the recorded run.
+
+void CJournal::Check (char aType, long aFirst, long aSecond)
+    {
+    long Data[2];                           //  The two numbers in the record
+
+    if (Mode == JOURNAL_RECORD)
+        {
+        Data[0] = aFirst;
+        Data[1] = aSecond;
+        WriteRecord (aType, Data, 2 * sizeof (long));
+        }
+    else
+        {
+        Data[0] = aFirst;
+        Data[1] = aSecond;
+        ReadRecord (aType, Data, 2 * sizeof (long));
+        if ((JournalFile != NULL) && ((Data[0] != aFirst) || (Data[1] != aSecond)))
+            TR_Exit ("Replay differs from journal at record %ld: journal has %c %ld %ld, "
+                     "replay has %c %ld %ld", RecordCount - 1L, aType, Data[0], Data[1],
+                     aType, aFirst, aSecond);
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: TR_JournalKey
+//      This function is meant to be used as the operator window's key filter.  It's
+//      given the key which was read (or -1 for none) and returns the one to be used:
+//      the same key if we're not journaling or are recording, or the key which had
+//      been recorded if we're replaying.
+
+int TR_JournalKey (int aKey)
+    {
+    CJournal* pJournal;
+
+    if ((GetCurrentContext () == NULL) || ((pJournal = TheMaster->GetJournal ()) == NULL))
+        return (aKey);
+
+    return (pJournal->Key (aKey));
+    }
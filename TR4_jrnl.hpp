@@ -0,0 +1,81 @@
+//*************************************************************************************
+//  TR4_jrnl.hpp
+//      This is the header for the journal, which records the inputs to a scheduler
+//      run which can't be predicted - readings of the real-time clock and keys pressed
+//      by the operator - so that the run can be replayed later exactly as it happened.
+//      During a replay the clock isn't read at all; each time the scheduler asks for
+//      the time it gets the reading which was recorded, so the tasks and states run in
+//      the same order as they did before, as fast as the computer can run them.
+//
+//      The journal also records some things which don't need to be fed back, but
+//      which ought to happen the same way on replay:  calls to TriggerEvent() and
+//      state transitions.  If the replay doesn't match, it stops with an error, so
+//      the user knows the replay has gone its own way (perhaps because the program
+//      was changed or the task code uses some other input which isn't journaled).
+//
+//      Record and replay work in the single-thread modes.  In simulation modes the
+//      clock isn't journaled, as simulated time is the same on every run anyway.
+//      The tasks' starting phases come from the scheduler context's own random number
+//      generator, which starts from the same seed every run, so they needn't be saved.
+//
+//      To journal the operator window's keys, point the operator interface's key
+//      filter at the journal before running:  OperatorKeyFilter = TR_JournalKey;
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//*************************************************************************************
+
+#ifndef TR4_JRNL_HPP
+    #define  TR4_JRNL_HPP                   //  Variable to prevent multiple inclusions
+
+//  Journals can be written or read back
+enum JournalMode {JOURNAL_RECORD, JOURNAL_REPLAY};
+
+//  Each record in the journal file begins with one of these characters to say what
+//  kind of record it is.  The rest of the record is binary data
+#define  JR_TIME             'T'            //  Clock reading:  one real_time
+#define  JR_KEY              'K'            //  Key code (or -1 for none):  one long
+#define  JR_EVENT            'E'            //  TriggerEvent():  task number and result
+#define  JR_STATE            'S'            //  Transition:  task and new state numbers
+
+
+//=====================================================================================
+//  Class: CJournal
+//      A journal is a binary file of records.  In record mode each function writes a
+//      record and returns the value it was given; in replay mode it reads the next
+//      record and returns the value which was saved, or for check records, makes sure
+//      that the saved values are the ones given.  The file begins with a short header
+//      which identifies it and the sizes of the data types in it.
+//=====================================================================================
+
+class CJournal
+    {
+    private:
+        FILE* JournalFile;                  //  File holding the journal
+        JournalMode Mode;                   //  Recording or replaying
+        long RecordCount;                   //  Number of records read or written
+
+        void WriteRecord (char, const void*, unsigned);
+        void ReadRecord (char, void*, unsigned);
+
+    public:
+        CJournal (const char*, JournalMode);    //  Open a journal file to record to
+        ~CJournal (void);                       //    or replay from; close it again
+
+        JournalMode GetMode (void)          //  Find out whether we're recording or
+            { return (Mode); }              //    replaying
+        long GetRecordCount (void)          //  Returns the number of records which
+            { return (RecordCount); }       //    have been written or read so far
+
+        real_time Time (real_time);         //  Save a clock reading or get it back
+        int Key (int);                      //  Save a key code or get it back
+        void Check (char, long, long);      //  Save or check an event or transition
+    };
+
+
+//  This function may be used as the operator interface's key filter; it sends each
+//  key through the current master's journal, if the master has one
+int TR_JournalKey (int);
+
+#endif      //  End of multiple-inclusion protection
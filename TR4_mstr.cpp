@@ -1,450 +1,1347 @@
-//*************************************************************************************
-//  TR3_MSTR.CPP
-//      This is the implementation file for the master scheduler object.  This object
-//      is the one which the user sets up in his program.  It creates the timer, task
-//      lists, and whatever else it needs to schedule the project.
-//
-//  Copyright (c) 1994-1996, D.M.Auslander and J.R.Ridgely
-//      May be used and distributed for any non-commercial purposes as long as this
-//      copyright notice is included.
-//      11-01-94  DMA  Original program
-//      11-21-94  JR   New class structure
-//      12-15-94  JR   Spun off as separate implementation file
-//       1-29-95  JR   CSim simulation stuff moved into this file from timer file
-//       5-20-95  JR   Inserted into Tranlog3 project with necessary name changes
-//      12-21-96  JR   Changed to TranRun4 flexible-scheduling version
-//*************************************************************************************
-
-#include <conio.h>
-#include <dos.h>
-#include <stdarg.h>
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <TranRun4.hpp>
-
-
-//=====================================================================================
-//  Class: CMaster
-//      One instance of this class is created in each user program.  The user program
-//      passes messages to this object to set up and run the real-time scheduler.
-//=====================================================================================
-
-//-------------------------------------------------------------------------------------
-//  Constructor: CMaster (default constructor) 
-//      This constructor creates a new CMaster object.  There should be just one for a 
-//      single-computer project and one per separate computer for a multi-computer
-//      project.  Here we allocate the task list objects and output files and such.
-
-CMaster::CMaster (void) : CBasicList ()
-    {
-    //  Set default stop time so that the program will run forever (almost)
-    StopTime = (real_time)9E99;
-
-    //  Create the transition trace logger object.  The user can write the trace which
-    //  has been recorded by the trace logger by calling DumpTrace().
-    if ((TraceLogger = new CDataLogger (LOG_CIRCULAR, 1024)) == NULL)
-        TR_Exit ("Unable to create transition trace logger object");
-
-    //  Define trace log's 7 columns:  time, process, task, pointer to state from
-    //  which we came, pointer to state to which we went, and state numbers of the
-    //  from and to states
-    TraceLogger->DefineData (7, LOG_DOUBLE, LOG_POINTER, LOG_POINTER, LOG_POINTER,
-                             LOG_POINTER, LOG_LONG, LOG_LONG);
-
-    //  Unless there's an error, this "I'm OK" message will be shown when Master stops
-    ExitMessage = new CString (128);
-    *ExitMessage = "Normal Exit from scheduler\n";
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Destructor: ~CMaster
-//      Shuts down the master scheduler.  Frees the memory it has been using for the
-//      process list and timer.  Process list object automatically deletes processes.
-
-CMaster::~CMaster (void)
-    {
-    //  Get rid of the trace logger, freeing its memory
-    delete TraceLogger;
-
-    //  If the exit message exists, it must be zapped now
-    if (ExitMessage != NULL) delete ExitMessage;
-
-    //  Now delete all of the processes which are under this scheduler
-    for (void* pCur = GetHead (); pCur != NULL; pCur = GetNext ())
-        delete (CProcess*)(GetCurrent ());
-
-    //  Call the basic list destructor
-    this->CBasicList::~CBasicList ();
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function:  DumpTrace
-//      The user calls this function to dump (write) the transition logic trace data
-//      to a file.  Note that an existing file of the same name will be overwritten.
-//      This function also flushes the trace data logger so you can start tracing all
-//      over again.
-
-void CMaster::DumpTrace (const char* aFileName)
-    {
-    FILE* TraceFile;                        //  File to which T.L. trace is written
-    unsigned Counter;                       //  Counts lines of TL trace data
-    double aTime;                           //  Time when transition occurred
-    long OldState;                          //  States are stored as long integers
-    long NewState;                          //  and retreived into these variables
-    void* pOldState;                        //  Pointers to T.L. states are
-    void* pNewState;                        //  stored in the buffer buffer
-    void* pTask;                            //  Task where transition occurred
-    void* pProc;                            //  Points to transition's process
-
-    if ((TraceFile = fopen (aFileName, "w")) == NULL)
-        {
-        TR_Message ("Warning:  Unable to open transition logic trace file \"%s\"",
-            aFileName);
-        }
-    else
-        {
-        fprintf (TraceFile, "TranRun4 State Transition Logic Trace File \n\n");
-        fprintf (TraceFile,
-           "Time       Process           Task              From              To \n\n");
-
-        //  Gotta write the transition information from the logger object to disk.
-        for (Counter = TraceLogger->GetNumLines (); Counter > 0; Counter--)
-            {
-            GetLoggerData (TraceLogger, &aTime, &pProc, &pTask,
-                           &pOldState, &pNewState, &OldState, &NewState);
-
-            //  Make sure none of the pointers is NULL; if one is we're out of data
-            if (pProc == NULL || pTask == NULL)
-                break;
-
-            //  If the from or to state pointer is NULL, the states were saved as
-            //  longs because the task is running in task-based scheduling mode.  In
-            //  that case, print out the state ID's as longs, not character strings
-            if ((pOldState == NULL) && (pNewState == NULL))
-                {
-                fprintf (TraceFile, "%-10.4f %-17s %-17s %-17ld %-17ld\n",
-                         aTime, (((CProcess*)pProc)->GetName ()),
-                         (((CTask*)pTask)->GetName ()), OldState, NewState);
-                }
-            else
-                {
-                fprintf (TraceFile, "%-10.4f %-17s %-17s %-17s %-17s\n",
-                         aTime, (((CProcess*)pProc)->GetName ()),
-                         (((CTask*)pTask)->GetName ()),
-                         (((CState*)pOldState)->GetName ()),
-                         (((CState*)pNewState)->GetName ()));
-                }
-            }
-
-        //  Reset trace data logger so the same data can be read again if necessary
-        TraceLogger->Rewind ();
-
-        //  Close that data file now
-        fclose (TraceFile);
-        }
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function:  DumpTraceNumbers
-//      This function is used to write the transition logic trace in numerical form to
-//      a file.  Note that an existing file of the same name will be overwritten.
-//      This function also flushes the trace data logger so you can start tracing all
-//      over again.
-
-void CMaster::DumpTraceNumbers (const char* aFileName)
-    {
-    FILE* TraceFile;                        //  File to which T.L. trace is written
-    unsigned Counter;                       //  Counts lines of TL trace data
-    double aTime;                           //  Time when transition occurred
-    void* pTask;                            //  Task where transition occurred
-    void* pProc;                            //  Points to transition's process
-    void* pOldState;                        //  Pointers to T.L. states are
-    void* pNewState;                        //  stored in the buffer buffer
-    long OldState;                          //  States in CTL_EXEC are represented
-    long NewState;                          //  by long integers
-
-    //  Make sure we can open the file; if we can't, complain
-    if ((TraceFile = fopen (aFileName, "w")) == NULL)
-        {
-        TR_Message ("Warning:  Unable to open transition logic trace file \"%s\"",
-            aFileName);
-        }
-    else
-        {
-        fprintf (TraceFile, "TranRun4 State Transition Logic Trace File \n\n");
-        fprintf (TraceFile,
-           "Time       Process                  Task     From     To \n\n");
-
-        //  Gotta write the transition information from the logger object to disk
-        for (Counter = TraceLogger->GetNumLines (); Counter > 0; Counter--)
-            {
-            GetLoggerData (TraceLogger, &aTime, &pProc, &pTask,
-                           &pOldState, &pNewState, &OldState, &NewState);
-
-            //  Make sure none of the pointers is NULL; if one is we're out of data
-            if (pProc == NULL || pTask == NULL)
-                break;
-
-            //  If the from or to state pointer is NULL, the states were saved as
-            //  longs because the task is running in task-based scheduling mode.  In
-            //  that case, print out the state ID's as longs, not character strings
-            if ((pOldState == NULL) && (pNewState == NULL))
-                {
-                fprintf (TraceFile, "%-10.4f %-17s %8d %8d %8d\n",
-                        aTime, (((CProcess*)pProc)->GetName ()),
-                        (((CTask*)pTask)->GetSerialNumber ()),
-                        (((CState*)OldState)->GetSerialNumber ()),
-                        (((CState*)NewState)->GetSerialNumber ()));
-                }
-            else
-                {
-                fprintf (TraceFile, "%-10.4f %-17s %-17d %-17ld %-17ld\n",
-                         aTime, (((CProcess*)pProc)->GetName ()),
-                         (((CTask*)pTask)->GetSerialNumber ()), OldState, NewState);
-                }
-            }
-
-        //  Reset trace data logger so the same data can be read again if necessary
-        TraceLogger->Rewind ();
-
-        //  Close that data file now
-        fclose (TraceFile);
-        }
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function: AddProcess
-//      This function creates a new process with the given name and inserts a pointer
-//      to it into the process list.  It returns a pointer to the new process.
-
-CProcess *CMaster::AddProcess (char *aName)
-    {
-    //  Create a new process by calling the CProcess constructor
-    CProcess *pNew = new CProcess (aName);
-
-    //  Call function to insert this thing into the list and return the pointer
-    return (InsertProcess (pNew));
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function: InsertProcess
-//      This inserts a process into the process list, given a pointer to that process.
-//      Normally the user would use AddProcess(), which creates the process and
-//      inserts it in the list.  It returns the pointer it was given.
-
-CProcess *CMaster::InsertProcess (CProcess* aProc)
-    {
-    //  Call basic list's insert() method to insert this thing into the list
-    CBasicList::Insert ((void*)aProc);
-    return (aProc);
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function: SetTickTime 
-//      This function sets the tick time of the master controller.  It checks the time 
-//      in its argument, and if it's "reasonable" sends it to the timer object.  
-
-void CMaster::SetTickTime (real_time aTickTime)
-    {
-    if ((aTickTime < (real_time)(1E-6)) || (aTickTime > (real_time)(1E6)))
-        TR_Exit ("Tick time is not within bounds (1 usec to 1Msec)");
-
-    TheTimer->Setup (aTickTime);
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function: SetStopTime 
-//      Function to set the stopping time of the controller.  If the user supplied a 
-//      reasonable value, the data field for ending time will be filled therewith.  
-
-void CMaster::SetStopTime (real_time aStopTime)
-    {
-    if (aStopTime < (real_time)(1E-6))
-        TR_Exit ("Scheduler stopping time is infinitesimal or zero");
-
-    StopTime = aStopTime;
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function: Go
-//      This function turns the scheduler "on" and starts the processes running.  In
-//      single-threading modes, a scheduler runs again and again until stopping time.  
-//      In multithreading modes, Go() calls the timer object to install ISRs which run 
-//      a scheduler that takes care of timer interrupt, event, sample time, and such 
-//      tasks.  Then the background runs only continuous tasks.
-
-void CMaster::Go (void)
-    {
-    real_time TheTime = (real_time)0.0;         //  Saves current time read from timer
-
-
-    //  Set status to GOING, until something in the program changes it
-    Status = GOING;
-
-    //  Check if the timer has been set up properly; if not, its delta time is ~0.0
-    if (TheTimer->GetDeltaTime () < (real_time)1E-6)
-        TR_Exit ("Tick time is too small; have you called SetupTimer()?");
-
-    //  Start the timer.  It responds differently in different modes
-    TheTimer->Go ();
-
-    //  Now run the background tasks by repeatedly calling RunBackground() and any
-    //  other functions which need to be run in the given real-time mode.  Exit the 
-    //  loop when time is StopTime or someone called Stop() to set Status to not GOING 
-    while (Status == GOING)
-        {
-        //  Call function to send run messages to tasks in the task list in sequence
-        RunBackground ();
-
-        //  Check the time; if time's up, say so, stop timer, and cause an exit
-        if ((TheTime = GetTimeNowUnprotected ()) > StopTime)
-            {
-            Status = STOPPED;
-            TheTimer->Stop ();
-            *ExitMessage = "Normal scheduler exit at end time ";
-            *ExitMessage << (double)TheTime << "\n";
-            }
-        }
-
-    TR_Message (ExitMessage->GetString ());         //  Display exit message
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function: Stop
-//      This function puts the scheduler into a stopped state.  It doesn't destroy any
-//      data, so the scheduler can be restarted from where it left off.  
-
-void CMaster::Stop (void)
-    {
-    Status = STOPPED;
-    TheTimer->Stop ();
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function: RunBackground 
-//      This function runs all the background tasks (tasks not called by ISR's) which 
-//      are in all the processes in the process list.  In single-threading modes, this
-//      actually runs all the task functions.
-
-void CMaster::RunBackground (void)
-    {
-    CProcess* pProcess = (CProcess*) GetHead ();
-
-    while (pProcess != NULL)
-        {
-        pProcess->RunBackground ();
-
-        GetObjWith (pProcess);
-        pProcess = (CProcess*) GetNext ();
-        }
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function: RunForeground
-//      This function is intended to be called by the interrupt service routine.  It
-//      makes one pass through each process with the scheduler.  The meaning of 'one
-//      pass' changes with the real-time mode you are employing.
-//  Changes
-//       9-02-95  JR   Added GetObjWith() call for re-entrance during RunForeground()  
-
-void CMaster::RunForeground (void)
-    {
-    CProcess* pProcess = (CProcess*) GetHead ();
-    while (pProcess != NULL)
-        {
-        pProcess->RunForeground ();
-        GetObjWith (pProcess);
-        pProcess = (CProcess*) GetNext ();
-        }
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function:  ProfileOn and ProfileOff
-//      These functions activate and deactivate execution-time profiling for all
-//      processes in the list. 
-
-void CMaster::ProfileOn (void)
-    {
-    CProcess *pCur;                     //  Pointer to each process in the list
-    for (pCur = (CProcess*)GetHead (); pCur != NULL; pCur = (CProcess *)GetNext ())
-        pCur->ProfileOn ();
-    }
-
-void CMaster::ProfileOff (void)
-    {
-    CProcess *pCur;
-    for (pCur = (CProcess*)GetHead (); pCur != NULL; pCur = (CProcess *)GetNext ())
-        pCur->ProfileOff ();
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function:  DumpProfiles
-//      This function causes each process to print a set of execution-time profiles
-//      to the given file.
-
-void CMaster::DumpProfiles (const char* aFileName)
-    {
-    FILE* aFile;                            //  Handle of the file to which we write
-
-    //  Attempt to open the file.  If it can't be opened, complain and exit
-    if ((aFile = fopen (aFileName, "w")) == NULL)
-        TR_Exit ("Unable to open file \"%s\" for task profile dump", aFileName);
-    else
-        {
-        CProcess *pCur;                     //  Pointer to process currently dumping
-
-        for (pCur = (CProcess*)GetHead (); pCur != NULL; pCur = (CProcess *)GetNext ())
-            pCur->DumpProfiles (aFile);
-        }
-    //  Since this function opened the file, this function must close it
-    fclose (aFile);
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function: TR_Exit
-//      In order to create nice clean one-line error exits, call this function and
-//      give it a text string.  Then, no matter what mode the program is running in,
-//      this function will print a complaint message and cleanly (?) exit.  This func-
-//      tion sets the Master's state to stopped (the timer will remove the ISR if it
-//      has set up one) and sets the exit text to the complaint you supplied.
-
-void TR_Exit (const char* aFormat, ...)
-    {
-    va_list Arguments;                          //  List of arguments of variable size 
-
-    //  Begin the variable-argument processing stuff
-    va_start (Arguments, aFormat);
-
-    char* FmtBuf = new char[128];               //  Make buffer for format string
-    char* ExitBuf = new char[256];              //  Another buffer for full string
-    strcpy (FmtBuf, "*** ERROR: ");             //  Put "ERROR" message into it
-    strcat (FmtBuf, aFormat);                   //  Add the user's format string
-    vsprintf (ExitBuf, FmtBuf, Arguments);      //  Use format to make message
-
-    //  Tell TheMaster to stop and give it the complaint message as exit text.
-    TheMaster->Stop ();                         //  Halt the scheduler right now
-    TheMaster->SetExitMessage (ExitBuf);        //  Set ExitBuf as exit message
-
-    //  Delete those pesky error messsage objects
-    DELETE_ARRAY FmtBuf;
-    DELETE_ARRAY ExitBuf;
-
-    //  Clean up after the variable-argument processing
-    va_end (Arguments);
-    }
-
+//*************************************************************************************
+//  TR3_MSTR.CPP
+//      This is the implementation file for the master scheduler object.  This object
+//      is the one which the user sets up in his program.  It creates the timer, task
+//      lists, and whatever else it needs to schedule the project.
+//
+//  Copyright (c) 1994-1996, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//      11-01-94  DMA  Original program
+//      11-21-94  JR   New class structure
+//      12-15-94  JR   Spun off as separate implementation file
+//       1-29-95  JR   CSim simulation stuff moved into this file from timer file
+//       5-20-95  JR   Inserted into Tranlog3 project with necessary name changes
+//      12-21-96  JR   Changed to TranRun4 flexible-scheduling version
+//*************************************************************************************
+
+#include <conio.h>
+#include <dos.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <TranRun4.hpp>
+
+
+//-------------------------------------------------------------------------------------
+//  File-scope global data
+//      In parallel simulation, or in a parallel sweep, two threads might call TR_Exit()
+//      at the same time; this lock makes them take turns.
+
+#if defined (TR_TIME_EXTSIM) || defined (TR_PARALLEL_SWEEP)
+    static CMutex ExitLock;                 //  Keeps TR_Exit() calls from colliding
+#endif
+
+
+//=====================================================================================
+//  Class: CMaster
+//      One instance of this class is created in each user program.  The user program
+//      passes messages to this object to set up and run the real-time scheduler.
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+//  Constructor: CMaster (default constructor) 
+//      This constructor creates a new CMaster object.  There should be just one for a 
+//      single-computer project and one per separate computer for a multi-computer
+//      project.  Here we allocate the task list objects and output files and such.
+
+CMaster::CMaster (void) : CBasicList ()
+    {
+    //  Set default stop time so that the program will run forever (almost)
+    StopTime = (real_time)9E99;
+
+    //  Create the transition trace logger object.  The user can write the trace which
+    //  has been recorded by the trace logger by calling DumpTrace().
+    if ((TraceLogger = new CDataLogger (LOG_CIRCULAR, 1024)) == NULL)
+        TR_Exit ("Unable to create transition trace logger object");
+
+    //  Define trace log's 7 columns:  time, process, task, pointer to state from
+    //  which we came, pointer to state to which we went, and state numbers of the
+    //  from and to states
+    TraceLogger->DefineData (7, LOG_DOUBLE, LOG_POINTER, LOG_POINTER, LOG_POINTER,
+                             LOG_POINTER, LOG_LONG, LOG_LONG);
+
+    //  Unless there's an error, this "I'm OK" message will be shown when Master stops
+    ExitMessage = new CString (128);
+    *ExitMessage = "Normal Exit from scheduler\n";
+
+    //  Create empty lists to hold the topics on the publish/subscribe data bus and
+    //  the signals passed between tasks
+    TopicList = new CBasicList ();
+    SignalList = new CBasicList ();
+
+    //  Every sweep is run, one tick at a time, unless the user asks for fast-forward
+    FastForward = FALSE;
+    SweepsSkipped = 0L;
+
+    //  Nothing is recorded or replayed unless the user asks
+    pJournal = NULL;
+
+    //  The scheduler isn't running yet, and starts from time zero unless restored
+    Status = STOPPED;
+    PendingCheckpoint = NULL;
+    Restored = FALSE;
+    RestoreFailed = FALSE;
+
+    //  The scheduler isn't being run in steps until StepTo() is called
+    Stepping = FALSE;
+    StepEndTime = (real_time)9E99;
+    CalibratedLoad = (real_time)0.0;
+
+    //  By default, the parallel simulation window is found from the tasks' timing
+    #if defined (TR_TIME_EXTSIM)
+        Lookahead = (real_time)0.0;
+        SimProcesses = NULL;
+        NumSimProcesses = 0;
+        SimThreads = NULL;
+        WindowStart = NULL;
+        WindowEnd = NULL;
+        WindowSweeps = 1L;
+        WindowCount = 0L;
+        SimFinished = FALSE;
+    #endif
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Destructor: ~CMaster
+//      Shuts down the master scheduler.  Frees the memory it has been using for the
+//      process list and timer.  Process list object automatically deletes processes.
+
+CMaster::~CMaster (void)
+    {
+    //  Get rid of the trace logger, freeing its memory
+    delete TraceLogger;
+
+    //  If the exit message exists, it must be zapped now
+    if (ExitMessage != NULL) delete ExitMessage;
+
+    //  Close the journal file, if we were recording or replaying
+    CloseJournal ();
+    DELETE_ARRAY PendingCheckpoint;
+
+    //  Delete the data bus topics; each topic deletes its own subscribers
+    for (void* pTopic = TopicList->GetHead (); pTopic != NULL;
+         pTopic = TopicList->GetNext ())
+        delete (CTopic*)pTopic;
+    delete TopicList;
+
+    //  Delete the signals which were put in the list
+    for (void* pSignal = SignalList->GetHead (); pSignal != NULL;
+         pSignal = SignalList->GetNext ())
+        delete (CBasicSignal*)pSignal;
+    delete SignalList;
+
+    //  Now delete all of the processes which are under this scheduler
+    for (void* pCur = GetHead (); pCur != NULL; pCur = GetNext ())
+        delete (CProcess*)(GetCurrent ());
+
+    //  Call the basic list destructor
+    this->CBasicList::~CBasicList ();
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  DumpTrace
+//      The user calls this function to dump (write) the transition logic trace data
+//      to a file.  Note that an existing file of the same name will be overwritten.
+//      This function also flushes the trace data logger so you can start tracing all
+//      over again.
+
+void CMaster::DumpTrace (const char* aFileName)
+    {
+    FILE* TraceFile;                        //  File to which T.L. trace is written
+    unsigned Counter;                       //  Counts lines of TL trace data
+    double aTime;                           //  Time when transition occurred
+    long OldState;                          //  States are stored as long integers
+    long NewState;                          //  and retreived into these variables
+    void* pOldState;                        //  Pointers to T.L. states are
+    void* pNewState;                        //  stored in the buffer buffer
+    void* pTask;                            //  Task where transition occurred
+    void* pProc;                            //  Points to transition's process
+
+    if ((TraceFile = fopen (aFileName, "w")) == NULL)
+        {
+        TR_Message ("Warning:  Unable to open transition logic trace file \"%s\"",
+            aFileName);
+        }
+    else
+        {
+        fprintf (TraceFile, "TranRun4 State Transition Logic Trace File \n\n");
+        fprintf (TraceFile,
+           "Time       Process           Task              From              To \n\n");
+
+        //  Gotta write the transition information from the logger object to disk.
+        for (Counter = TraceLogger->GetNumLines (); Counter > 0; Counter--)
+            {
+            GetLoggerData (TraceLogger, &aTime, &pProc, &pTask,
+                           &pOldState, &pNewState, &OldState, &NewState);
+
+            //  Make sure none of the pointers is NULL; if one is we're out of data
+            if (pProc == NULL || pTask == NULL)
+                break;
+
+            //  If the from or to state pointer is NULL, the states were saved as
+            //  longs because the task is running in task-based scheduling mode.  In
+            //  that case, print out the state ID's as longs, not character strings
+            if ((pOldState == NULL) && (pNewState == NULL))
+                {
+                fprintf (TraceFile, "%-10.4f %-17s %-17s %-17ld %-17ld\n",
+                         aTime, (((CProcess*)pProc)->GetName ()),
+                         (((CTask*)pTask)->GetName ()), OldState, NewState);
+                }
+            else
+                {
+                fprintf (TraceFile, "%-10.4f %-17s %-17s %-17s %-17s\n",
+                         aTime, (((CProcess*)pProc)->GetName ()),
+                         (((CTask*)pTask)->GetName ()),
+                         (((CState*)pOldState)->GetName ()),
+                         (((CState*)pNewState)->GetName ()));
+                }
+            }
+
+        //  Reset trace data logger so the same data can be read again if necessary
+        TraceLogger->Rewind ();
+
+        //  Close that data file now
+        fclose (TraceFile);
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  DumpTraceNumbers
+//      This function is used to write the transition logic trace in numerical form to
+//      a file.  Note that an existing file of the same name will be overwritten.
+//      This function also flushes the trace data logger so you can start tracing all
+//      over again.
+
+void CMaster::DumpTraceNumbers (const char* aFileName)
+    {
+    FILE* TraceFile;                        //  File to which T.L. trace is written
+    unsigned Counter;                       //  Counts lines of TL trace data
+    double aTime;                           //  Time when transition occurred
+    void* pTask;                            //  Task where transition occurred
+    void* pProc;                            //  Points to transition's process
+    void* pOldState;                        //  Pointers to T.L. states are
+    void* pNewState;                        //  stored in the buffer buffer
+    long OldState;                          //  States in CTL_EXEC are represented
+    long NewState;                          //  by long integers
+
+    //  Make sure we can open the file; if we can't, complain
+    if ((TraceFile = fopen (aFileName, "w")) == NULL)
+        {
+        TR_Message ("Warning:  Unable to open transition logic trace file \"%s\"",
+            aFileName);
+        }
+    else
+        {
+        fprintf (TraceFile, "TranRun4 State Transition Logic Trace File \n\n");
+        fprintf (TraceFile,
+           "Time       Process                  Task     From     To \n\n");
+
+        //  Gotta write the transition information from the logger object to disk
+        for (Counter = TraceLogger->GetNumLines (); Counter > 0; Counter--)
+            {
+            GetLoggerData (TraceLogger, &aTime, &pProc, &pTask,
+                           &pOldState, &pNewState, &OldState, &NewState);
+
+            //  Make sure none of the pointers is NULL; if one is we're out of data
+            if (pProc == NULL || pTask == NULL)
+                break;
+
+            //  If the from or to state pointer is NULL, the states were saved as
+            //  longs because the task is running in task-based scheduling mode.  In
+            //  that case, print out the state ID's as longs, not character strings
+            if ((pOldState == NULL) && (pNewState == NULL))
+                {
+                fprintf (TraceFile, "%-10.4f %-17s %8d %8d %8d\n",
+                        aTime, (((CProcess*)pProc)->GetName ()),
+                        (((CTask*)pTask)->GetSerialNumber ()),
+                        (((CState*)OldState)->GetSerialNumber ()),
+                        (((CState*)NewState)->GetSerialNumber ()));
+                }
+            else
+                {
+                fprintf (TraceFile, "%-10.4f %-17s %-17d %-17ld %-17ld\n",
+                         aTime, (((CProcess*)pProc)->GetName ()),
+                         (((CTask*)pTask)->GetSerialNumber ()), OldState, NewState);
+                }
+            }
+
+        //  Reset trace data logger so the same data can be read again if necessary
+        TraceLogger->Rewind ();
+
+        //  Close that data file now
+        fclose (TraceFile);
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: AddProcess
+//      This function creates a new process with the given name and inserts a pointer
+//      to it into the process list.  It returns a pointer to the new process.
+
+CProcess *CMaster::AddProcess (char *aName)
+    {
+    //  Create a new process by calling the CProcess constructor
+    CProcess *pNew = new CProcess (aName);
+
+    //  Call function to insert this thing into the list and return the pointer
+    return (InsertProcess (pNew));
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: InsertProcess
+//      This inserts a process into the process list, given a pointer to that process.
+//      Normally the user would use AddProcess(), which creates the process and
+//      inserts it in the list.  It returns the pointer it was given.
+
+CProcess *CMaster::InsertProcess (CProcess* aProc)
+    {
+    //  Call basic list's insert() method to insert this thing into the list
+    CBasicList::Insert ((void*)aProc);
+    return (aProc);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Functions:  AddTopic
+//      These functions create a new topic on the publish/subscribe data bus and put
+//      it in the master's topic list, where producers and subscribers in any process
+//      can find it by name.  The first version uses a default number of ring slots.
+
+CTopic* CMaster::AddTopic (const char* aName, unsigned aSize)
+    {
+    return (AddTopic (aName, aSize, BUS_DEFAULT_SLOTS));
+    }
+
+CTopic* CMaster::AddTopic (const char* aName, unsigned aSize, int aSlots)
+    {
+    //  Two topics with the same name would confuse anyone using FindTopic()
+    if (FindTopic (aName) != NULL)
+        TR_Exit ("Attempt to create a second data bus topic named \"%s\"", aName);
+
+    CTopic* pNew = new CTopic (aName, aSize, aSlots);
+    TopicList->Insert ((void*)pNew);
+    return (pNew);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  FindTopic
+//      This function returns a pointer to the data bus topic with the given name, or
+//      NULL if there isn't one.  It's meant to be called while setting up, not from
+//      within task functions, as it searches the list by comparing strings.
+
+CTopic* CMaster::FindTopic (const char* aName)
+    {
+    CTopic* pCur;
+
+    for (pCur = (CTopic*)TopicList->GetHead (); pCur != NULL;
+         pCur = (CTopic*)TopicList->GetNext ())
+        {
+        if (strcmp (pCur->GetName (), aName) == 0)
+            return (pCur);
+        }
+    return (NULL);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Functions:  InsertSignal and FindSignal
+//      InsertSignal() puts a signal which the user has created into the master's
+//      list, so it's committed at the end of each sweep; the master deletes it when
+//      it's deleted.  FindSignal() returns a pointer to the signal with the given
+//      name, or NULL; like FindTopic(), it's meant to be called while setting up.
+
+CBasicSignal* CMaster::InsertSignal (CBasicSignal* aSignal)
+    {
+    //  Two signals with the same name would confuse anyone using FindSignal()
+    if (FindSignal (aSignal->GetName ()) != NULL)
+        TR_Exit ("Attempt to insert a second signal named \"%s\"",
+                 aSignal->GetName ());
+
+    SignalList->Insert ((void*)aSignal);
+    return (aSignal);
+    }
+
+CBasicSignal* CMaster::FindSignal (const char* aName)
+    {
+    CBasicSignal* pCur;
+
+    for (pCur = (CBasicSignal*)SignalList->GetHead (); pCur != NULL;
+         pCur = (CBasicSignal*)SignalList->GetNext ())
+        {
+        if (strcmp (pCur->GetName (), aName) == 0)
+            return (pCur);
+        }
+    return (NULL);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  CommitSignals
+//      This function commits every signal at the end of a sweep, so the values which
+//      were written during the sweep are seen by the tasks from the next one on.  In
+//      multithreading mode, interrupts are held off so a foreground task can't write
+//      a signal while the signals are being committed.
+
+void CMaster::CommitSignals (void)
+    {
+    CBasicSignal* pCur;
+
+    #if defined (TR_THREAD_MULTI)
+        DisableInterrupts ();
+    #endif
+
+    for (pCur = (CBasicSignal*)SignalList->GetHead (); pCur != NULL;
+         pCur = (CBasicSignal*)SignalList->GetNext ())
+        pCur->Commit ();
+
+    #if defined (TR_THREAD_MULTI)
+        EnableInterrupts ();
+    #endif
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: SetTickTime 
+//      This function sets the tick time of the master controller.  It checks the time 
+//      in its argument, and if it's "reasonable" sends it to the timer object.  
+
+void CMaster::SetTickTime (real_time aTickTime)
+    {
+    if ((aTickTime < (real_time)(1E-6)) || (aTickTime > (real_time)(1E6)))
+        TR_Exit ("Tick time is not within bounds (1 usec to 1Msec)");
+
+    TheTimer->Setup (aTickTime);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: SetStopTime 
+//      Function to set the stopping time of the controller.  If the user supplied a 
+//      reasonable value, the data field for ending time will be filled therewith.  
+
+void CMaster::SetStopTime (real_time aStopTime)
+    {
+    if (aStopTime < (real_time)(1E-6))
+        TR_Exit ("Scheduler stopping time is infinitesimal or zero");
+
+    StopTime = aStopTime;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: SetLookahead
+//      In parallel simulation mode, this function sets the shortest time it can take
+//      a message from one process to have an effect in another - for example, the
+//      latency of the network which will link the computers.  Each process may run
+//      this far ahead without hearing from the others, so it's the length of the time
+//      window run between synchronizations.  If it isn't set, the shortest sample
+//      time of any task in any process is used instead.
+
+#if defined (TR_TIME_EXTSIM)
+void CMaster::SetLookahead (real_time aTime)
+    {
+    if (aTime < (real_time)0.0)
+        TR_Exit ("Parallel simulation lookahead time is negative");
+
+    Lookahead = aTime;
+    }
+#endif
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Go
+//      This function turns the scheduler "on" and starts the processes running.  In
+//      single-threading modes, a scheduler runs again and again until stopping time.  
+//      In multithreading modes, Go() calls the timer object to install ISRs which run 
+//      a scheduler that takes care of timer interrupt, event, sample time, and such 
+//      tasks.  Then the background runs only continuous tasks.  If the scheduler has
+//      been run a step at a time with StepTo(), Go() runs it on from where it is.
+
+void CMaster::Go (void)
+    {
+    //  Start the scheduler and timer up, unless StepTo() has already done so
+    if ((Stepping == FALSE) && (StartUp () == FALSE))
+        return;
+    Stepping = FALSE;
+
+    //  In parallel simulation mode, start up a thread to run each process
+    #if defined (TR_TIME_EXTSIM)
+        StartParallelSim ();
+    #endif
+
+    //  Now run the background tasks by repeatedly calling RunBackground() and any
+    //  other functions which need to be run in the given real-time mode.  Exit the 
+    //  loop when time is StopTime or someone called Stop() to set Status to not GOING 
+    while (Status == GOING)
+        RunSweep ();
+
+    #if defined (TR_TIME_EXTSIM)
+        StopParallelSim ();
+    #endif
+
+    TR_Message (ExitMessage->GetString ());         //  Display exit message
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: StartUp
+//      This function gets the scheduler ready to run, for Go() or the first call to
+//      StepTo().  It returns FALSE if the scheduler can't be run.
+
+boolean CMaster::StartUp (void)
+    {
+    real_time TheTime;                          //  Time restored from a checkpoint
+
+
+    //  If a checkpoint couldn't be restored, the tasks are in no state to be run;
+    //  show the complaint which was made at the time and give up
+    if (RestoreFailed == TRUE)
+        {
+        TR_Message (ExitMessage->GetString ());
+        return (FALSE);
+        }
+
+    //  Set status to GOING, until something in the program changes it
+    Status = GOING;
+
+    //  Check if the timer has been set up properly; if not, its delta time is ~0.0
+    if (TheTimer->GetDeltaTime () < (real_time)1E-6)
+        TR_Exit ("Tick time is too small; have you called SetupTimer()?");
+
+    //  Start the timer.  It responds differently in different modes.  If we've just
+    //  restored a checkpoint, the clock must go on from the time which was restored
+    if (Restored == TRUE)
+        {
+        TheTime = GetTimeNowUnprotected ();
+        TheTimer->Go ();
+        TheTimer->AdvanceTo (TheTime);
+        Restored = FALSE;
+        }
+    else
+        TheTimer->Go ();
+
+    return (TRUE);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: RunSweep
+//      This function runs one sweep of the background tasks, then checks whether it's
+//      time to stop and whether a checkpoint is to be saved.
+
+void CMaster::RunSweep (void)
+    {
+    real_time TheTime;                          //  Saves current time read from timer
+
+    //  Call function to send run messages to tasks in the task list in sequence
+    RunBackground ();
+
+    //  Check the time; if time's up, say so, stop timer, and cause an exit
+    if ((TheTime = GetTimeNowUnprotected ()) > StopTime)
+        {
+        Status = STOPPED;
+        TheTimer->Stop ();
+        *ExitMessage = "Normal scheduler exit at end time ";
+        *ExitMessage << (double)TheTime << "\n";
+        }
+
+    //  If a task asked for a checkpoint during this sweep, save it now that all
+    //  the tasks are between scans
+    if (PendingCheckpoint != NULL)
+        {
+        SaveCheckpoint (PendingCheckpoint);
+        DELETE_ARRAY PendingCheckpoint;
+        PendingCheckpoint = NULL;
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: StepTo
+//      In simulation mode, this function runs the scheduler until the simulated clock
+//      reaches the given time, then returns, so that a program which is coupled to
+//      another simulator can exchange data with it between steps.  The first call
+//      starts the scheduler up as Go() would.  Sweeps are run whole, so the clock may
+//      end up a little past the given time.  The function returns TRUE if the time
+//      was reached and FALSE if the scheduler stopped first (at its stop time, or
+//      because of an error); each later call then returns FALSE at once.
+
+boolean CMaster::StepTo (real_time aTime)
+    {
+    #if !defined (TR_TIME_SIM)
+        (void)aTime;                            //  Not used in this mode
+        TR_Exit ("The scheduler can only be run in steps in simulation mode");
+        return (FALSE);
+    #else
+        boolean WasGoing;                       //  Was scheduler running at start?
+
+        if (Stepping == FALSE)
+            {
+            if (StartUp () == FALSE)
+                return (FALSE);
+            Stepping = TRUE;
+            }
+
+        //  Fast-forward mustn't skip past the end of the step
+        WasGoing = (Status == GOING) ? TRUE : FALSE;
+        StepEndTime = aTime;
+        while ((Status == GOING) && (GetTimeNowUnprotected () < aTime))
+            RunSweep ();
+        StepEndTime = (real_time)9E99;
+
+        if (Status == GOING)
+            return (TRUE);
+
+        //  The scheduler stopped during this step; say why, just as Go() would
+        if (WasGoing == TRUE)
+            TR_Message (ExitMessage->GetString ());
+        return (FALSE);
+    #endif
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Functions: Calibrate
+//      In simulation mode the clock moves ahead one tick each sweep through the tasks,
+//      so the tick time ought to be the time a sweep takes on the computer which will
+//      run the program.  These functions measure it instead of leaving it to guess-
+//      work.  The scheduler is run for the given warm-up time, with the tick time the
+//      user has set, while the processor time used is measured with clock().  Then the
+//      tick is set to the average processor time per sweep, times the number of times
+//      slower than this computer the target computer is.  The tasks' shares of the
+//      target's processor are added up, and if they'd keep it too busy (or a task
+//      would take longer to run than its sample time) the user is warned - before the
+//      program has ever been run on the target.
+//
+//      The warm-up is the first part of the run:  Calibrate() is called after the
+//      tasks have been set up, and Go() or StepTo() then runs the rest of it with the
+//      calibrated tick time.  Since clock() measures the time used by the whole
+//      program, calibrate a run by itself, not one of several in a batch.  The
+//      functions return TRUE if the tick time was set.
+
+//  If the tasks would use more than this share of the target's processor, there'd be
+//  little time to spare for anything else, so the user is warned
+#define  CALIBRATION_BUSY_LOAD   0.8
+
+boolean CMaster::Calibrate (real_time aWarmUp)
+    {
+    return (Calibrate (aWarmUp, 1.0));
+    }
+
+boolean CMaster::Calibrate (real_time aWarmUp, double aSlowdown)
+    {
+    #if !defined (TR_TIME_SIM)
+        (void)aWarmUp;                          //  Not used in this mode
+        (void)aSlowdown;
+        TR_Exit ("The tick time can only be calibrated in simulation mode");
+        return (FALSE);
+    #else
+        real_time StartTime;                    //  Time when the warm-up began
+        real_time WarmUpTime;                   //  Simulated time the warm-up took
+        real_time NewTick;                      //  Calibrated tick time
+        double Sweeps;                          //  Number of sweeps in warm-up
+        double HostTime;                        //  Processor time used in seconds
+        clock_t StartClock;                     //  Processor time at warm-up start
+        boolean WasFastForward;                 //  Saves fast-forward setting
+        CProcess* pCur;                         //  Each process in the list
+
+
+        if ((aWarmUp <= (real_time)0.0) || (aSlowdown <= 0.0))
+            {
+            TR_Exit ("Calibration needs a positive warm-up time and speed ratio");
+            return (FALSE);
+            }
+
+        //  Start up as StepTo() would, so the warm-up begins when the run begins (which
+        //  may not be at zero, if a checkpoint has been restored)
+        if (Stepping == FALSE)
+            {
+            if (StartUp () == FALSE)
+                return (FALSE);
+            Stepping = TRUE;
+            }
+        StartTime = GetTimeNowUnprotected ();
+
+        //  Every sweep must really be run to be measured, so fast-forward is held off
+        WasFastForward = FastForward;
+        FastForward = FALSE;
+        for (pCur = (CProcess*)GetHead (); pCur != NULL; pCur = (CProcess*)GetNext ())
+            pCur->CalibrateOn ();
+
+        StartClock = clock ();
+        StepTo (StartTime + aWarmUp);
+        HostTime = (double)(clock () - StartClock) / (double)CLOCKS_PER_SEC;
+
+        for (pCur = (CProcess*)GetHead (); pCur != NULL; pCur = (CProcess*)GetNext ())
+            pCur->CalibrateOff ();
+        FastForward = WasFastForward;
+
+        //  If the run ended during the warm-up, StepTo() has already said why
+        if (Status != GOING)
+            return (FALSE);
+
+        WarmUpTime = GetTimeNowUnprotected () - StartTime;
+        Sweeps = (double)(WarmUpTime / TheTimer->GetDeltaTime ());
+        if ((Sweeps < 1.0) || (HostTime <= 0.0))
+            {
+            TR_Message ("Calibration warm-up was too short to measure; tick time "
+                        "not changed\n");
+            return (FALSE);
+            }
+
+        //  The tick can't be made shorter than SetTickTime() would allow
+        NewTick = (real_time)(HostTime * aSlowdown / Sweeps);
+        if (NewTick < (real_time)1E-6)
+            {
+            TR_Message ("Warning:  Calibrated tick time of %g sec is too short; "
+                        "using 1 usec\n", (double)NewTick);
+            NewTick = (real_time)1E-6;
+            }
+        TheTimer->Setup (NewTick);
+
+        CalibratedLoad = (real_time)0.0;
+        for (pCur = (CProcess*)GetHead (); pCur != NULL; pCur = (CProcess*)GetNext ())
+            CalibratedLoad += pCur->CalibratedLoad (WarmUpTime, aSlowdown);
+
+        TR_Message ("Calibrated tick time is %g sec; tasks would use %.1f%% of the "
+                    "target processor\n", (double)NewTick, (double)CalibratedLoad * 100.0);
+        if (CalibratedLoad > (real_time)1.0)
+            TR_Message ("Warning:  The target processor would be overloaded\n");
+        else if (CalibratedLoad > (real_time)CALIBRATION_BUSY_LOAD)
+            TR_Message ("Warning:  The target processor would be more than %d%% busy\n",
+                        (int)(CALIBRATION_BUSY_LOAD * 100.0));
+
+        return (TRUE);
+    #endif
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Stop
+//      This function puts the scheduler into a stopped state.  It doesn't destroy any
+//      data, so the scheduler can be restarted from where it left off.  
+
+void CMaster::Stop (void)
+    {
+    Status = STOPPED;
+    TheTimer->Stop ();
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: RunBackground 
+//      This function runs all the background tasks (tasks not called by ISR's) which 
+//      are in all the processes in the process list.  In single-threading modes, this
+//      actually runs all the task functions.
+
+void CMaster::RunBackground (void)
+    {
+    //  In parallel simulation mode, each call runs one time window.  The processes
+    //  run their windows in their own threads (or one after another, if there are
+    //  no threads or just one process); then the master tidies up
+    #if defined (TR_TIME_EXTSIM)
+        if (SimThreads != NULL)
+            {
+            WindowStart->Wait ();
+            WindowEnd->Wait ();
+            }
+        else
+            {
+            for (int Index = 0; Index < NumSimProcesses; Index++)
+                SimProcesses[Index]->RunWindow (WindowSweeps);
+            }
+        EndWindow ();
+
+    //  In other modes, just run a sweep of each process in turn.  In fast-forward
+    //  simulation, sweeps in which no task could run are skipped over instead
+    #else
+        #if defined (TR_TIME_SIM) && defined (TR_THREAD_SINGLE)
+            if ((FastForward == TRUE) && (SkipIdleSweeps () == TRUE))
+                return;
+        #endif
+
+        CProcess* pProcess = (CProcess*) GetHead ();
+
+        while (pProcess != NULL)
+            {
+            pProcess->RunBackground ();
+
+            GetObjWith (pProcess);
+            pProcess = (CProcess*) GetNext ();
+            }
+
+        //  Values written to signals during the sweep are seen from the next one on
+        CommitSignals ();
+
+        //  In simulation mode, the clock moves ahead by one tick per sweep.  It's done
+        //  here and not as each task is scanned, so the time base doesn't depend on how
+        //  many tasks there are; adding a logging task won't change the others' timing
+        #if defined (TR_TIME_SIM)
+            TheTimer->Increment ();
+        #endif
+    #endif
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  SkipIdleSweeps
+//      In simulation mode, the clock moves ahead one tick each sweep, whether or not
+//      any task runs.  When every task is waiting for its next sample time (or for an
+//      event), many sweeps in a row may go by in which nothing at all happens.  This
+//      function moves the clock past as many of those sweeps as it can, stopping
+//      before the first sweep in which some task might be due.  The clock is moved
+//      forward by adding one tick per sweep just as RunBackground() would, so it reads
+//      exactly what it would have read had each sweep been run, and the tasks then
+//      run in exactly the same order at exactly the same times.  The function returns
+//      TRUE if it skipped at least one sweep.
+
+#if defined (TR_TIME_SIM) && defined (TR_THREAD_SINGLE)
+
+//  Skip no more than this many sweeps at once, so Go() gets to check its status
+#define  MAX_SKIPPED_SWEEPS  100000L
+
+boolean CMaster::SkipIdleSweeps (void)
+    {
+    real_time WakeTime = (real_time)9E99;   //  Earliest time a task could run
+    real_time Now;                          //  Time on clock after skipped sweeps
+    real_time Delta;                        //  Length of one clock tick
+    long Skipped = 0L;                      //  Number of sweeps skipped this time
+    CProcess* pCur;                         //  Each process in the list
+
+    for (pCur = (CProcess*)GetHead (); pCur != NULL; pCur = (CProcess*)GetNext ())
+        if (pCur->GetNextRunTime () < WakeTime)
+            WakeTime = pCur->GetNextRunTime ();
+
+    //  If a task is ready right now, there's nothing to skip
+    if (WakeTime <= (real_time)0.0)
+        return (FALSE);
+
+    Now = GetTimeNowUnprotected ();
+    Delta = TheTimer->GetDeltaTime ();
+    while (Skipped < MAX_SKIPPED_SWEEPS)
+        {
+        //  All the tasks in a sweep see the clock as it was when the sweep began, so
+        //  no task can run in a sweep which begins before the earliest task's time
+        if (Now >= WakeTime)
+            break;
+
+        //  Go() checks the stop time after each sweep, and StepTo() checks the end of
+        //  its step, so we must stop there too
+        Now += Delta;
+        Skipped++;
+        if ((Now > StopTime) || (Now >= StepEndTime))
+            break;
+        }
+
+    if (Skipped == 0L)
+        return (FALSE);
+
+    TheTimer->AdvanceTo (Now);
+    SweepsSkipped += Skipped;
+    return (TRUE);
+    }
+#endif
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  SimThreadMain
+//      This is the function which runs in each process's thread.  The threads all wait
+//      at WindowStart until the master lets them run a window, and the master waits at
+//      WindowEnd until they've all finished it.  The thread first makes its master's
+//      context current, so TheMaster and TheTimer mean the same thing here as they do
+//      in the master's own thread.
+
+#if defined (TR_TIME_EXTSIM)
+void CMaster::SimThreadMain (void* aSimThread)
+    {
+    TR_SimThread* pSim = (TR_SimThread*)aSimThread;
+    CMaster* pMaster = pSim->pMaster;
+
+    pSim->pContext->MakeCurrent ();
+    for (;;)
+        {
+        pMaster->WindowStart->Wait ();
+        if (pMaster->SimFinished == TRUE)
+            break;
+        pSim->pProcess->RunWindow (pMaster->WindowSweeps);
+        pMaster->WindowEnd->Wait ();
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  StartParallelSim
+//      This function gets parallel simulation ready to run.  It decides how long the
+//      time window will be and starts up one thread for each process.  The window is
+//      made a whole number of ticks long, so all the processes' clocks reach the end
+//      of the window on exactly the same tick.
+
+void CMaster::StartParallelSim (void)
+    {
+    real_time Window = Lookahead;           //  Length of time window in seconds
+    CProcess* pCur;                         //  Points to each process in the list
+    int Index;                              //  Counts through the processes
+
+
+    //  Make an array of the processes, so the threads don't have to use the list
+    NumSimProcesses = HowMany ();
+    SimProcesses = new CProcess*[NumSimProcesses];
+    Index = 0;
+    for (pCur = (CProcess*)GetHead (); pCur != NULL; pCur = (CProcess*)GetNext ())
+        SimProcesses[Index++] = pCur;
+
+    //  If the user didn't set a lookahead, no process can react to another one's
+    //  messages any sooner than the shortest sample time of any task
+    if (Window <= (real_time)0.0)
+        {
+        Window = (real_time)9E99;
+        for (Index = 0; Index < NumSimProcesses; Index++)
+            if (SimProcesses[Index]->GetShortestPeriod () < Window)
+                Window = SimProcesses[Index]->GetShortestPeriod ();
+        }
+
+    //  Find the number of ticks in a window; it has to be at least one
+    if (Window >= (real_time)1E9)
+        WindowSweeps = 1L;
+    else
+        WindowSweeps = (long)((Window / TheTimer->GetDeltaTime ()) + 1E-6);
+    if (WindowSweeps < 1L)
+        WindowSweeps = 1L;
+    WindowCount = 0L;
+
+    //  Start up a thread for each process if there's more than one process to run.
+    //  The master's thread also meets the process threads at each barrier
+    SimFinished = FALSE;
+    #if !defined (TR_NO_THREADS)
+        if (NumSimProcesses > 1)
+            {
+            WindowStart = new CBarrier (NumSimProcesses + 1);
+            WindowEnd = new CBarrier (NumSimProcesses + 1);
+            SimThreads = new TR_SimThread[NumSimProcesses];
+            for (Index = 0; Index < NumSimProcesses; Index++)
+                {
+                SimThreads[Index].pMaster = this;
+                SimThreads[Index].pContext = GetCurrentContext ();
+                SimThreads[Index].pProcess = SimProcesses[Index];
+                SimThreads[Index].pThread = new CThread (SimThreadMain,
+                                                    (void*)&(SimThreads[Index]));
+                SimThreads[Index].pThread->Start ();
+                }
+            }
+    #endif
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  StopParallelSim
+//      When the master stops, this function lets the process threads go from the
+//      starting barrier one last time with the finished flag set, so they exit.
+//      Then it waits for them to finish and cleans up.
+
+void CMaster::StopParallelSim (void)
+    {
+    if (SimThreads != NULL)
+        {
+        SimFinished = TRUE;
+        WindowStart->Wait ();
+
+        for (int Index = 0; Index < NumSimProcesses; Index++)
+            {
+            SimThreads[Index].pThread->Join ();
+            delete SimThreads[Index].pThread;
+            }
+        DELETE_ARRAY SimThreads;
+        delete WindowStart;
+        delete WindowEnd;
+        SimThreads = NULL;
+        WindowStart = NULL;
+        WindowEnd = NULL;
+        }
+
+    DELETE_ARRAY SimProcesses;
+    SimProcesses = NULL;
+    NumSimProcesses = 0;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  EndWindow
+//      This function runs in the master's thread at the end of each time window,
+//      while all the process threads are waiting.  It moves the master's clock up to
+//      the end of the window, makes the data bus samples published and the signals
+//      written during the window visible, and copies the trace lines which the
+//      processes saved into the trace logger.  The trace lines are merged in time
+//      order; lines made at the same time go in process order.  Since nothing here
+//      depends on which thread finished first, each run of a simulation gives exactly
+//      the same results.
+
+void CMaster::EndWindow (void)
+    {
+    CTopic* pTopic;                         //  Each topic on the data bus
+    int* NextLine;                          //  Next trace line to copy from each
+    int Earliest;                           //  Process with earliest trace line
+    TR_TraceRecord* pLine;                  //  Trace line being copied
+    int Index;
+
+    WindowCount++;
+    TheTimer->AdvanceTo ((real_time)(WindowCount * WindowSweeps)
+                         * TheTimer->GetDeltaTime ());
+
+    for (pTopic = (CTopic*)TopicList->GetHead (); pTopic != NULL;
+         pTopic = (CTopic*)TopicList->GetNext ())
+        pTopic->CommitPending ();
+    CommitSignals ();
+
+    NextLine = new int[NumSimProcesses];
+    for (Index = 0; Index < NumSimProcesses; Index++)
+        NextLine[Index] = 0;
+
+    for (;;)
+        {
+        Earliest = -1;
+        for (Index = 0; Index < NumSimProcesses; Index++)
+            {
+            if (NextLine[Index] >= SimProcesses[Index]->GetTraceCount ())
+                continue;
+            pLine = SimProcesses[Index]->GetTraceLines () + NextLine[Index];
+            if ((Earliest < 0) || (pLine->Time < (SimProcesses[Earliest]
+                                   ->GetTraceLines () + NextLine[Earliest])->Time))
+                Earliest = Index;
+            }
+        if (Earliest < 0)
+            break;
+
+        pLine = SimProcesses[Earliest]->GetTraceLines () + NextLine[Earliest];
+        SaveLoggerData (TraceLogger, (double)pLine->Time,
+                        (void*)SimProcesses[Earliest], pLine->pTask,
+                        pLine->pFromState, pLine->pToState,
+                        pLine->FromState, pLine->ToState);
+        NextLine[Earliest]++;
+        }
+
+    for (Index = 0; Index < NumSimProcesses; Index++)
+        SimProcesses[Index]->ClearTrace ();
+    DELETE_ARRAY NextLine;
+    }
+#endif  //  TR_TIME_EXTSIM
+
+
+//-------------------------------------------------------------------------------------
+//  Function: RunForeground
+//      This function is intended to be called by the interrupt service routine.  It
+//      makes one pass through each process with the scheduler.  The meaning of 'one
+//      pass' changes with the real-time mode you are employing.
+//  Changes
+//       9-02-95  JR   Added GetObjWith() call for re-entrance during RunForeground()  
+
+void CMaster::RunForeground (void)
+    {
+    CProcess* pProcess = (CProcess*) GetHead ();
+    while (pProcess != NULL)
+        {
+        pProcess->RunForeground ();
+        GetObjWith (pProcess);
+        pProcess = (CProcess*) GetNext ();
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  ProfileOn and ProfileOff
+//      These functions activate and deactivate execution-time profiling for all
+//      processes in the list. 
+
+void CMaster::ProfileOn (void)
+    {
+    CProcess *pCur;                     //  Pointer to each process in the list
+    for (pCur = (CProcess*)GetHead (); pCur != NULL; pCur = (CProcess *)GetNext ())
+        pCur->ProfileOn ();
+    }
+
+void CMaster::ProfileOff (void)
+    {
+    CProcess *pCur;
+    for (pCur = (CProcess*)GetHead (); pCur != NULL; pCur = (CProcess *)GetNext ())
+        pCur->ProfileOff ();
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Functions:  Record, Replay, and CloseJournal
+//      Record() starts writing a journal of the clock readings and other inputs which
+//      can't be predicted; Replay() reads one back, feeding the same inputs to the
+//      tasks so they run just as they did when the journal was made.  These should be
+//      called after the tasks have been set up and before Go().  Since an interrupt
+//      can preempt a task at any instant, runs can't be replayed in multithreading
+//      modes.  CloseJournal() closes the journal file, ending recording or replay.
+
+void CMaster::Record (const char* aFileName)
+    {
+    #if defined (TR_THREAD_MULTI)
+        (void)aFileName;                        //  Not used in this mode
+        TR_Exit ("Runs can't be recorded in multithreading mode");
+    #else
+        CloseJournal ();
+        pJournal = new CJournal (aFileName, JOURNAL_RECORD);
+    #endif
+    }
+
+void CMaster::Replay (const char* aFileName)
+    {
+    #if defined (TR_THREAD_MULTI)
+        (void)aFileName;                        //  Not used in this mode
+        TR_Exit ("Runs can't be replayed in multithreading mode");
+    #else
+        CloseJournal ();
+        pJournal = new CJournal (aFileName, JOURNAL_REPLAY);
+    #endif
+    }
+
+void CMaster::CloseJournal (void)
+    {
+    if (pJournal != NULL)
+        {
+        delete pJournal;
+        pJournal = NULL;
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Functions:  Checkpoint and Restore
+//      Checkpoint() saves the whole state of a simulation in a file; Restore() reads
+//      one back, so that Go() carries on from where the saved run was rather than
+//      starting over at time zero.  Restore() must be called after the processes,
+//      tasks, states, and topics have been set up just as they were in the program
+//      which saved the checkpoint, and before Go().  Checkpoint() may be called from
+//      within a task while the scheduler is running; the checkpoint is then saved at
+//      the end of the sweep, when every task is between scans.  Since a real clock
+//      can't be set back, checkpoints can only be used in simulated-time mode.
+
+void CMaster::Checkpoint (const char* aFileName)
+    {
+    #if !defined (TR_TIME_SIM)
+        (void)aFileName;                        //  Not used in this mode
+        TR_Exit ("Checkpoints can only be saved in simulation mode");
+    #else
+        if (Status != GOING)
+            {
+            SaveCheckpoint (aFileName);
+            return;
+            }
+
+        DELETE_ARRAY PendingCheckpoint;
+        if ((PendingCheckpoint = new char[strlen (aFileName) + 1]) == NULL)
+            TR_Exit ("Unable to allocate memory for checkpoint name %s", aFileName);
+        strcpy (PendingCheckpoint, aFileName);
+    #endif
+    }
+
+void CMaster::Restore (const char* aFileName)
+    {
+    #if !defined (TR_TIME_SIM)
+        (void)aFileName;                        //  Not used in this mode
+        TR_Exit ("Checkpoints can only be restored in simulation mode");
+    #else
+        if (Status == GOING)
+            TR_Exit ("Can't restore checkpoint %s while the scheduler is running",
+                     aFileName);
+
+        CCheckpoint* pCheckpoint = new CCheckpoint (aFileName, CHECKPOINT_RESTORE);
+        CheckpointAll (pCheckpoint);
+        if (pCheckpoint->HasFailed () == TRUE)
+            RestoreFailed = TRUE;
+        else
+            Restored = TRUE;
+        delete pCheckpoint;
+    #endif
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  SaveCheckpoint
+//      This function opens a checkpoint file and saves everything in it right away.
+
+void CMaster::SaveCheckpoint (const char* aFileName)
+    {
+    CCheckpoint* pCheckpoint = new CCheckpoint (aFileName, CHECKPOINT_SAVE);
+    CheckpointAll (pCheckpoint);
+    delete pCheckpoint;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  CheckpointAll
+//      Here's where the scheduler's state is actually saved or restored:  the time,
+//      the context's random number generator, the transition trace, the topics on
+//      the data bus, and then each process, which does its tasks and their states.
+
+void CMaster::CheckpointAll (CCheckpoint* aCheckpoint)
+    {
+    real_time Now = GetTimeNowUnprotected ();   //  Time on the simulated clock
+    unsigned long Seed;                         //  Random number generator's state
+    void* pCur;                                 //  Each topic or process in turn
+
+    Seed = GetCurrentContext ()->GetRandomSeed ();
+    aCheckpoint->Data (&Now, sizeof (real_time));
+    aCheckpoint->Data (&Seed, sizeof (unsigned long));
+    aCheckpoint->Data (&SweepsSkipped, sizeof (long));
+    if (aCheckpoint->Restoring () == TRUE)
+        {
+        TheTimer->AdvanceTo (Now);
+        GetCurrentContext ()->SetRandomSeed (Seed);
+        }
+
+    CheckpointTrace (aCheckpoint);
+
+    aCheckpoint->Count (TopicList->HowMany (), "topics");
+    for (pCur = TopicList->GetHead (); pCur != NULL; pCur = TopicList->GetNext ())
+        ((CTopic*)pCur)->Checkpoint (aCheckpoint);
+
+    aCheckpoint->Count (SignalList->HowMany (), "signals");
+    for (pCur = SignalList->GetHead (); pCur != NULL; pCur = SignalList->GetNext ())
+        ((CBasicSignal*)pCur)->Checkpoint (aCheckpoint);
+
+    aCheckpoint->Count (HowMany (), "processes");
+    for (pCur = GetHead (); pCur != NULL; pCur = GetNext ())
+        ((CProcess*)pCur)->Checkpoint (aCheckpoint);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  CheckpointTrace
+//      The transition logic trace holds pointers to processes, tasks, and states, and
+//      those mean nothing to another run of the program.  So each line is saved with
+//      the number of the process in the master's list and the serial numbers of the
+//      task and states instead; on restoring, the numbers are turned back into
+//      pointers to this program's objects and the lines are logged again in order.
+
+void CMaster::CheckpointTrace (CCheckpoint* aCheckpoint)
+    {
+    int Lines;                              //  Number of lines of trace data
+    double aTime;                           //  Time when transition occurred
+    void* pProc;                            //  Points to transition's process
+    void* pTask;                            //  Task where transition occurred
+    void* pOldState;                        //  Pointers to T.L. states, or NULL
+    void* pNewState;                        //  for task-based tasks
+    long OldState;                          //  State numbers for task-based tasks
+    long NewState;
+    long Numbers[4];                        //  Process, task, and state numbers
+    int Line;
+
+    Lines = (int)TraceLogger->GetNumLines ();
+    aCheckpoint->Data (&Lines, sizeof (int));
+    if (aCheckpoint->Restoring () == TRUE)
+        TraceLogger->DiscardData ();
+
+    for (Line = 0; (Line < Lines) && (aCheckpoint->HasFailed () == FALSE); Line++)
+        {
+        if (aCheckpoint->Restoring () == FALSE)
+            {
+            GetLoggerData (TraceLogger, &aTime, &pProc, &pTask,
+                           &pOldState, &pNewState, &OldState, &NewState);
+            Numbers[0] = (long)NumberOfObjWith (pProc);
+            Numbers[1] = (long)((CTask*)pTask)->GetSerialNumber ();
+            Numbers[2] = (pOldState == NULL) ? -1L
+                         : (long)((CState*)pOldState)->GetSerialNumber ();
+            Numbers[3] = (pNewState == NULL) ? -1L
+                         : (long)((CState*)pNewState)->GetSerialNumber ();
+            }
+        aCheckpoint->Data (&aTime, sizeof (double));
+        aCheckpoint->Data (Numbers, 4 * sizeof (long));
+        aCheckpoint->Data (&OldState, sizeof (long));
+        aCheckpoint->Data (&NewState, sizeof (long));
+
+        if ((aCheckpoint->Restoring () == TRUE) && (aCheckpoint->HasFailed () == FALSE))
+            {
+            pProc = GetObjNumber ((int)Numbers[0]);
+            pTask = (pProc == NULL) ? NULL
+                    : ((CProcess*)pProc)->FindTask ((int)Numbers[1]);
+            if (pTask == NULL)
+                TR_Exit ("Trace in checkpoint refers to a task which isn't here");
+            pOldState = ((CTask*)pTask)->FindState ((int)Numbers[2]);
+            pNewState = ((CTask*)pTask)->FindState ((int)Numbers[3]);
+            SaveLoggerData (TraceLogger, aTime, pProc, pTask, pOldState, pNewState,
+                            OldState, NewState);
+            }
+        }
+
+    //  Reset the trace logger so the lines which were saved can be read again
+    if (aCheckpoint->Restoring () == FALSE)
+        TraceLogger->Rewind ();
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  DumpProfiles
+//      This function causes each process to print a set of execution-time profiles
+//      to the given file.
+
+void CMaster::DumpProfiles (const char* aFileName)
+    {
+    FILE* aFile;                            //  Handle of the file to which we write
+
+    //  Attempt to open the file.  If it can't be opened, complain and exit
+    if ((aFile = fopen (aFileName, "w")) == NULL)
+        TR_Exit ("Unable to open file \"%s\" for task profile dump", aFileName);
+    else
+        {
+        CProcess *pCur;                     //  Pointer to process currently dumping
+
+        for (pCur = (CProcess*)GetHead (); pCur != NULL; pCur = (CProcess *)GetNext ())
+            pCur->DumpProfiles (aFile);
+        }
+    //  Since this function opened the file, this function must close it
+    fclose (aFile);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: TR_Exit
+//      In order to create nice clean one-line error exits, call this function and
+//      give it a text string.  Then, no matter what mode the program is running in,
+//      this function will print a complaint message and cleanly (?) exit.  This func-
+//      tion sets the Master's state to stopped (the timer will remove the ISR if it
+//      has set up one) and sets the exit text to the complaint you supplied.
+
+void TR_Exit (const char* aFormat, ...)
+    {
+    va_list Arguments;                          //  List of arguments of variable size 
+
+    //  Begin the variable-argument processing stuff
+    va_start (Arguments, aFormat);
+
+    char* FmtBuf = new char[128];               //  Make buffer for format string
+    char* ExitBuf = new char[256];              //  Another buffer for full string
+    strcpy (FmtBuf, "*** ERROR: ");             //  Put "ERROR" message into it
+    strcat (FmtBuf, aFormat);                   //  Add the user's format string
+    vsprintf (ExitBuf, FmtBuf, Arguments);      //  Use format to make message
+
+    //  Tell TheMaster to stop and give it the complaint message as exit text.  In
+    //  parallel simulation, two processes' threads might complain at the same time
+    #if defined (TR_TIME_EXTSIM) || defined (TR_PARALLEL_SWEEP)
+        ExitLock.Lock ();
+    #endif
+    TheMaster->Stop ();                         //  Halt the scheduler right now
+    TheMaster->SetExitMessage (ExitBuf);        //  Set ExitBuf as exit message
+    #if defined (TR_TIME_EXTSIM) || defined (TR_PARALLEL_SWEEP)
+        ExitLock.Unlock ();
+    #endif
+
+    //  Delete those pesky error messsage objects
+    DELETE_ARRAY FmtBuf;
+    DELETE_ARRAY ExitBuf;
+
+    //  Clean up after the variable-argument processing
+    va_end (Arguments);
+    }
+
@@ -1,80 +1,161 @@
-//*************************************************************************************
-//  TR4_mstr.hpp
-//      Here's the interface for the master scheduler class.  The master scheduler is
-//      the object which controls the running of all the tasks in each process while
-//      the timer object keeps time.
-//
-//  Copyright (c) 1994-1996, D.M.Auslander and J.R.Ridgely
-//      May be used and distributed for any non-commercial purposes as long as this
-//      copyright notice is included.
-//      11-01-94  DMA  Original program
-//      11-21-94  JR   New class structure
-//      12-15-94  JR   Spun off as separate implementation file
-//       1-29-95  JR   CSim simulation stuff moved into this file from timer file
-//       5-20-95  JR   Inserted into Tranlog3 project with necessary name changes
-//      12-21-96  JR   Changed to TranRun4 flexible-scheduling version
-//*************************************************************************************
-
-#ifndef TR4_MSTR_HPP
-    #define  TR3_MSTR_HPP                   //  Variable to prevent multiple inclusions
-
-//=====================================================================================
-//  Class: CMaster
-//      This is the scheduler that runs everything.  Just one master may exist; it is
-//      instantiated in TRANRUN3.CPP and a pointer to it is called TheMaster.  
-//=====================================================================================
-
-//  This enum represents possible states of the process scheduler 
-enum MasterState 
-    {
-    GOING,              //  Scheduler running normally 
-    STOPPED             //  Scheduler paused, able to resume
-    };
-
-class CMaster: public CBasicList
-    {
-    private:
-        MasterState Status;                 //  State of master scheduler 
-        CDataLogger* TraceLogger;           //  Transition logic data logger object
-        real_time StopTime;                 //  Time when master will shut off
-        CString* ExitMessage;               //  Message displayed when master stops
-
-    public:
-        CMaster (void);                     //  Default constructor
-        ~CMaster (void);                    //  and destructor as usual
-
-        CProcess* AddProcess (char*);       //  Create a process and put it in list
-        CProcess* InsertProcess             //  If you've already created a process,
-            (CProcess*);                    //    use this to insert it in the list
-        void SetTickTime (real_time);       //  Set time between timer object ticks
-        void SetStopTime (real_time);       //  Set time at which control will stop
-        void Go (void);                     //  Start scheduler up
-        void Stop (void);                   //  Halt the scheduler
-        void RunBackground (void);          //  Run the tasks not called by ISR's
-        void RunForeground (void);          //  Run pre-emptive scheduler (one pass)
-        void DumpTrace (const char*);       //  Dump transition logic trace to a file
-        void DumpTraceNumbers (const char*);//  Dump trace in numbers form for Matlab
-        void ProfileOn (void);              //  Turn profiling on for all processes 
-        void ProfileOff (void);             //  Turn profiling back off again
-        void DumpProfiles (const char*);    //  Dump execution-time profiles of tasks
-        void SetExitMessage (char* aMsg)    //  Set a new exit message, usually a
-            { *ExitMessage = aMsg; }        //    complaint causing an error exit
-        friend void TL_TraceLine            //  These two TL_TraceLine functions are
-            (void*, void*, void*);          //    called by tasks to record state
-        friend void TL_TraceLine            //    transitions.  The first is for
-            (void*, long, long);            //    TranRun3, the second for CTL_EXEC.
-
-        //  Friend function complains and exits when serious errors occur
-        friend void TR_Exit (const char*, ...);
-        };
-
-
-//-------------------------------------------------------------------------------------
-//  Global pointer:  TheMaster
-//      Make a _global_ pointer to "the" master object which is shared by all modules 
-//      (It's instantiated in CTL_MSTR.CPP)
-
-extern CMaster* TheMaster;
-
-#endif      //  End multiple-inclusion protection
-
+//*************************************************************************************
+//  TR4_mstr.hpp
+//      Here's the interface for the master scheduler class.  The master scheduler is
+//      the object which controls the running of all the tasks in each process while
+//      the timer object keeps time.
+//
+//  Copyright (c) 1994-1996, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//      11-01-94  DMA  Original program
+//      11-21-94  JR   New class structure
+//      12-15-94  JR   Spun off as separate implementation file
+//       1-29-95  JR   CSim simulation stuff moved into this file from timer file
+//       5-20-95  JR   Inserted into Tranlog3 project with necessary name changes
+//      12-21-96  JR   Changed to TranRun4 flexible-scheduling version
+//*************************************************************************************
+
+#ifndef TR4_MSTR_HPP
+    #define  TR3_MSTR_HPP                   //  Variable to prevent multiple inclusions
+
+//=====================================================================================
+//  Class: CMaster
+//      This is the scheduler that runs everything.  There's one master in each
+//      scheduler context (see TR4_ctxt.hpp); TheMaster points to the current one.
+//=====================================================================================
+
+//  This enum represents possible states of the process scheduler 
+enum MasterState 
+    {
+    GOING,              //  Scheduler running normally 
+    STOPPED             //  Scheduler paused, able to resume
+    };
+
+//  In parallel simulation mode, each process runs in a thread of its own.  This is
+//  what the thread is told:  which process to run, and for which master and context
+#if defined (TR_TIME_EXTSIM)
+    class CMaster;
+    class CSchedulerContext;
+    struct TR_SimThread
+        {
+        CThread* pThread;                   //  The thread itself
+        CMaster* pMaster;                   //  Master which is running the process
+        CSchedulerContext* pContext;        //  Context to which that master belongs
+        CProcess* pProcess;                 //  Process which this thread runs
+        };
+#endif
+
+class CMaster: public CBasicList
+    {
+    private:
+        MasterState Status;                 //  State of master scheduler 
+        CDataLogger* TraceLogger;           //  Transition logic data logger object
+        real_time StopTime;                 //  Time when master will shut off
+        CString* ExitMessage;               //  Message displayed when master stops
+        CBasicList* TopicList;              //  List of topics on the data bus
+        CBasicList* SignalList;             //  Signals committed after each sweep
+        CJournal* pJournal;                 //  Journal for record or replay, if any
+        boolean FastForward;                //  Skip sweeps in which nothing can run
+        long SweepsSkipped;                 //  Count of sweeps which were skipped
+        boolean SkipIdleSweeps (void);      //  Move clock past sweeps which are idle
+        char* PendingCheckpoint;            //  Checkpoint to save at end of sweep
+        boolean Restored;                   //  TRUE if Go() is to go on from a
+                                            //    checkpoint rather than start over
+        boolean RestoreFailed;              //  TRUE if a checkpoint was only partly
+                                            //    restored, so Go() mustn't run
+        void SaveCheckpoint (const char*);  //  Write a checkpoint file right now
+        void CheckpointAll (CCheckpoint*);  //  Save or restore everything, and
+        void CheckpointTrace (CCheckpoint*);//    the transition logic trace
+        boolean Stepping;                   //  TRUE while being run by StepTo()
+        real_time StepEndTime;              //  Time at which this step is to end
+        boolean StartUp (void);             //  Get the scheduler ready to run
+        void RunSweep (void);               //  Run a sweep and check for stop time
+        void CommitSignals (void);          //  Make values written in sweep seen
+        real_time CalibratedLoad;           //  Share of target processor tasks use
+        #if defined (TR_TIME_EXTSIM)
+            real_time Lookahead;            //  Shortest delay of messages between
+                                            //    processes, or 0 to find from tasks
+            CProcess** SimProcesses;        //  Array of the processes being run
+            int NumSimProcesses;            //  and the number of them
+            TR_SimThread* SimThreads;       //  Thread for each process, if used
+            CBarrier* WindowStart;          //  Threads wait here to start a window
+            CBarrier* WindowEnd;            //  and here when they've finished one
+            long WindowSweeps;              //  Number of sweeps in each window
+            long WindowCount;               //  Number of windows run so far
+            boolean SimFinished;            //  Tells threads the run is over
+
+            static void SimThreadMain       //  Function which runs in each
+                (void*);                    //    process's thread
+            void StartParallelSim (void);   //  Start a thread for each process
+            void StopParallelSim (void);    //  Wait for process threads to finish
+            void EndWindow (void);          //  Commit messages, merge trace lines
+        #endif
+
+    public:
+        CMaster (void);                     //  Default constructor
+        ~CMaster (void);                    //  and destructor as usual
+
+        CProcess* AddProcess (char*);       //  Create a process and put it in list
+        CProcess* InsertProcess             //  If you've already created a process,
+            (CProcess*);                    //    use this to insert it in the list
+        void SetTickTime (real_time);       //  Set time between timer object ticks
+        void SetStopTime (real_time);       //  Set time at which control will stop
+        real_time GetStopTime (void)        //  Find the time at which the scheduler
+            { return (StopTime); }          //    is to stop
+        #if defined (TR_TIME_EXTSIM)
+            void SetLookahead (real_time);  //  Set the parallel simulation window
+        #endif
+        void Go (void);                     //  Start scheduler up
+        boolean StepTo (real_time);         //  Run until the clock reaches a time
+        void Stop (void);                   //  Halt the scheduler
+        void RunBackground (void);          //  Run the tasks not called by ISR's
+        void RunForeground (void);          //  Run pre-emptive scheduler (one pass)
+        void DumpTrace (const char*);       //  Dump transition logic trace to a file
+        void DumpTraceNumbers (const char*);//  Dump trace in numbers form for Matlab
+        void ProfileOn (void);              //  Turn profiling on for all processes 
+        void ProfileOff (void);             //  Turn profiling back off again
+        void FastForwardOn (void)           //  In simulation, skip over stretches
+            { FastForward = TRUE; }         //    of time in which no task can run,
+        void FastForwardOff (void)          //    or go back to running every sweep
+            { FastForward = FALSE; }
+        long GetSweepsSkipped (void)        //  Find how many sweeps fast-forward
+            { return (SweepsSkipped); }     //    mode has skipped over
+        boolean Calibrate (real_time);      //  Set tick time from processor time
+        boolean Calibrate (real_time,       //    measured during a warm-up, for
+                           double);         //    this or a slower computer
+        real_time GetCalibratedLoad (void)  //  Find share of the target processor
+            { return (CalibratedLoad); }    //    which the tasks would use
+        void Record (const char*);          //  Record unpredictable inputs to file
+        void Replay (const char*);          //  Replay a run from a recorded journal
+        void CloseJournal (void);           //  Stop recording or replaying
+        CJournal* GetJournal (void)         //  Returns a pointer to the journal, or
+            { return (pJournal); }          //    NULL if there isn't one
+        void Checkpoint (const char*);      //  Save the simulation's state to a file
+        void Restore (const char*);         //  Go on from a saved checkpoint
+        void DumpProfiles (const char*);    //  Dump execution-time profiles of tasks
+        CTopic* AddTopic (const char*,      //  Create a data bus topic with the
+                          unsigned);        //    given name and sample size, or
+        CTopic* AddTopic (const char*,      //    with a given number of slots too
+                          unsigned, int);
+        CTopic* FindTopic (const char*);    //  Find a topic on the bus by its name
+        CBasicSignal* InsertSignal          //  Put a signal in the master's list,
+            (CBasicSignal*);                //    to be committed after each sweep
+        CBasicSignal* FindSignal            //  Find a signal by its name
+            (const char*);
+        void SetExitMessage (char* aMsg)    //  Set a new exit message, usually a
+            { *ExitMessage = aMsg; }        //    complaint causing an error exit
+        friend void TL_TraceLine            //  These two TL_TraceLine functions are
+            (void*, void*, void*);          //    called by tasks to record state
+        friend void TL_TraceLine            //    transitions.  The first is for
+            (void*, long, long);            //    TranRun3, the second for CTL_EXEC.
+
+        //  Friend function complains and exits when serious errors occur
+        friend void TR_Exit (const char*, ...);
+
+        //  A parallel sweep copies the trace lines its threads made into the logger
+        friend class CParallelSweep;
+        };
+
+
+#endif      //  End multiple-inclusion protection
+
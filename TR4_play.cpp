@@ -0,0 +1,360 @@
+//*************************************************************************************
+//  TR4_play.cpp
+//      This file contains the implementation of playback tasks, which feed recorded
+//      data back into a program at the times at which it was recorded.
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//*************************************************************************************
+
+#include <stdlib.h>
+#include <string.h>
+#include <TranRun4.hpp>
+
+
+//-------------------------------------------------------------------------------------
+//  Function: ParseLine
+//      Read the numbers from one line of a text file into an array which has room for
+//      the given number of them.  The items may be separated by spaces, commas, tabs,
+//      or semicolons.  The number of items on the line is returned, or -1 if there's
+//      anything on the line which isn't a number.
+
+static int ParseLine (char* aLine, double* aItems, int aRoom)
+    {
+    char* pText = aLine;                    //  Place in the line being read
+    char* pEnd;                             //  Where a number ended
+    double Item;                            //  One number from the line
+    int Count = 0;                          //  Number of items found
+
+    while (*pText != '\0')
+        {
+        if (strchr (" ,;\t\r\n", *pText) != NULL)
+            {
+            pText++;
+            continue;
+            }
+
+        Item = strtod (pText, &pEnd);
+        if ((pEnd == pText) || ((*pEnd != '\0') && (strchr (" ,;\t\r\n", *pEnd) == NULL)))
+            return (-1);
+
+        if (Count < aRoom)
+            aItems[Count] = Item;
+        Count++;
+        pText = pEnd;
+        }
+
+    return (Count);
+    }
+
+
+//=====================================================================================
+//  Class: CPlaybackTask
+//      Plays a recording back into the user's variables.
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+//  Constructor: CPlaybackTask
+//      The file is opened and the first block of lines read right away, so the number
+//      of columns is known when the user connects them to variables.  The task first
+//      runs at the time of the first line.
+
+CPlaybackTask::CPlaybackTask (const char* aName, int aPriority, real_time aSampleTime,
+                              const char* aFileName)
+    : CTask (aName, SAMPLE_TIME, aPriority, aSampleTime)
+    {
+    if ((FileName = new char[strlen (aFileName) + 1]) != NULL)
+        strcpy (FileName, aFileName);
+
+    File = NULL;
+    Binary = FALSE;
+    NumColumns = 0;
+    TimeColumn = 0;
+    Targets = NULL;
+    Block = NULL;
+    Offsets = NULL;
+    LinesInBlock = 0;
+    NextLine = 0;
+    LinesPlayed = 0L;
+    LineBuffer = new char[PLAYBACK_LINE_SIZE];
+
+    OpenFile ();
+    if (File == NULL)
+        return;
+
+    ReadBlock ();
+    if (IsFinished () == TRUE)
+        Deactivate ();
+    else
+        SetNextRunTime (GetLineTime ());
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Destructor: ~CPlaybackTask
+
+CPlaybackTask::~CPlaybackTask (void)
+    {
+    if (File != NULL)
+        fclose (File);
+
+    DELETE_ARRAY FileName;
+    DELETE_ARRAY Targets;
+    DELETE_ARRAY Block;
+    DELETE_ARRAY Offsets;
+    DELETE_ARRAY LineBuffer;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: OpenFile
+//      Open the recording, give it a big buffer, and find out what kind of file it
+//      is and how many columns it has.  A binary file says so in its first bytes; for
+//      a text file, the items on the first line of numbers are counted.
+
+void CPlaybackTask::OpenFile (void)
+    {
+    char Tag[4];                            //  First bytes of the file
+    unsigned Columns;                       //  Number of columns in a binary file
+    long Offset;                            //  Where the first line of numbers is
+    int Column;
+
+    if ((File = fopen (FileName, "rb")) == NULL)
+        {
+        TR_Exit ("Unable to open playback file \"%s\"", FileName);
+        return;
+        }
+    setvbuf (File, NULL, _IOFBF, PLAYBACK_FILE_BUFFER);
+
+    if ((fread (Tag, 1, 4, File) == 4) && (memcmp (Tag, LOG_BINARY_TAG, 4) == 0))
+        {
+        Binary = TRUE;
+        if ((fread (&Columns, sizeof (unsigned), 1, File) != 1) || (Columns == 0))
+            {
+            TR_Exit ("Playback file \"%s\" is damaged", FileName);
+            fclose (File);
+            File = NULL;
+            return;
+            }
+        NumColumns = (int)Columns;
+        }
+    else
+        {
+        fseek (File, 0L, SEEK_SET);
+        while (NumColumns <= 0)
+            {
+            Offset = ftell (File);
+            if (fgets (LineBuffer, PLAYBACK_LINE_SIZE, File) == NULL)
+                {
+                TR_Exit ("Playback file \"%s\" has no data in it", FileName);
+                fclose (File);
+                File = NULL;
+                return;
+                }
+            NumColumns = ParseLine (LineBuffer, NULL, 0);
+            }
+        fseek (File, Offset, SEEK_SET);
+        }
+
+    Targets = new double*[NumColumns];
+    Block = new double[PLAYBACK_BLOCK_LINES * NumColumns];
+    Offsets = new long[PLAYBACK_BLOCK_LINES];
+    if ((Targets == NULL) || (Block == NULL) || (Offsets == NULL))
+        {
+        TR_Exit ("Unable to allocate memory for playback task \"%s\"", GetName ());
+        fclose (File);
+        File = NULL;
+        return;
+        }
+    for (Column = 0; Column < NumColumns; Column++)
+        Targets[Column] = NULL;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: ReadLine
+//      Read the next line of numbers from the file, and find where in the file it
+//      began.  Lines of text which aren't all numbers are skipped.  FALSE is returned
+//      at the end of the file.
+
+boolean CPlaybackTask::ReadLine (double* aLine, long* aOffset)
+    {
+    int Count;                              //  Number of items on a line of text
+
+    *aOffset = ftell (File);
+    if (Binary == TRUE)
+        return ((fread (aLine, sizeof (double), NumColumns, File) == (size_t)NumColumns)
+                ? TRUE : FALSE);
+
+    while (fgets (LineBuffer, PLAYBACK_LINE_SIZE, File) != NULL)
+        {
+        if ((strchr (LineBuffer, '\n') == NULL) && (feof (File) == 0))
+            {
+            TR_Exit ("Line in playback file \"%s\" is too long", FileName);
+            return (FALSE);
+            }
+
+        if ((Count = ParseLine (LineBuffer, aLine, NumColumns)) == NumColumns)
+            return (TRUE);
+        if (Count > 0)
+            {
+            TR_Exit ("Line in playback file \"%s\" has %d items instead of %d",
+                     FileName, Count, NumColumns);
+            return (FALSE);
+            }
+        *aOffset = ftell (File);
+        }
+
+    return (FALSE);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: ReadBlock
+//      Read the next block of lines into memory.  If none are left, the block is
+//      empty and the recording is finished.
+
+void CPlaybackTask::ReadBlock (void)
+    {
+    NextLine = 0;
+    LinesInBlock = 0;
+    while ((LinesInBlock < PLAYBACK_BLOCK_LINES)
+           && (ReadLine (Block + LinesInBlock * NumColumns, Offsets + LinesInBlock)
+               == TRUE))
+        LinesInBlock++;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Connect
+//      Have the items in the given column copied into the given variable as each
+//      line is played.
+
+void CPlaybackTask::Connect (int aColumn, double* aVariable)
+    {
+    if ((aColumn < 0) || (aColumn >= NumColumns))
+        TR_Exit ("Playback file \"%s\" has no column %d", FileName, aColumn);
+    else
+        Targets[aColumn] = aVariable;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: SetTimeColumn
+//      Choose which column holds the recorded times.  This must be called before the
+//      scheduler starts.
+
+void CPlaybackTask::SetTimeColumn (int aColumn)
+    {
+    if ((aColumn < 0) || (aColumn >= NumColumns))
+        {
+        TR_Exit ("Playback file \"%s\" has no column %d", FileName, aColumn);
+        return;
+        }
+
+    TimeColumn = aColumn;
+    if (IsFinished () == FALSE)
+        SetNextRunTime (GetLineTime ());
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: GetLineTime
+//      Return the recorded time of the next line to be played, or a very large time
+//      if the recording is finished.
+
+real_time CPlaybackTask::GetLineTime (void)
+    {
+    if (IsFinished () == TRUE)
+        return ((real_time)9E99);
+
+    return ((real_time)(Block[NextLine * NumColumns + TimeColumn]));
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: NewLine
+//      This is called after each line's items have been copied into the variables.
+//      It does nothing unless the user overrides it.
+
+void CPlaybackTask::NewLine (void)
+    {
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Run
+//      Play every line whose time has come, in order, then sleep until the time of
+//      the next line.  If the scheduler's steps are longer than the time between
+//      lines, several lines are played in one run, and NewLine() is called for each.
+
+void CPlaybackTask::Run (void)
+    {
+    real_time Now = GetTimeNow ();          //  Time at which the task is running
+    real_time LineTime;                     //  Time of the line being played
+    double* pLine;                          //  Items of the line being played
+    int Column;
+
+    while ((IsFinished () == FALSE) && ((LineTime = GetLineTime ()) <= Now))
+        {
+        pLine = Block + NextLine * NumColumns;
+        for (Column = 0; Column < NumColumns; Column++)
+            if (Targets[Column] != NULL)
+                *(Targets[Column]) = pLine[Column];
+
+        LinesPlayed++;
+        NextLine++;
+        NewLine ();
+
+        if (NextLine >= LinesInBlock)
+            ReadBlock ();
+        if (GetLineTime () < LineTime)
+            {
+            TR_Exit ("Times in playback file \"%s\" go backwards after line %ld",
+                     FileName, LinesPlayed);
+            return;
+            }
+        }
+
+    if (IsFinished () == TRUE)
+        Deactivate ();
+    else
+        {
+        SetNextRunTime (GetLineTime ());
+        Idle ();
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: CheckpointData
+//      Save the place in the file of the next line to be played.  When restoring,
+//      the file is read again from there.  The values in the user's variables aren't
+//      saved here; they belong to whoever owns the variables.
+
+void CPlaybackTask::CheckpointData (CCheckpoint* aCheckpoint)
+    {
+    long Offset;                            //  Where the next line is in the file
+
+    aCheckpoint->Count (NumColumns, "playback columns");
+    aCheckpoint->Data (&TimeColumn, sizeof (int));
+    aCheckpoint->Data (&LinesPlayed, sizeof (long));
+
+    Offset = (IsFinished () == TRUE) ? -1L : Offsets[NextLine];
+    aCheckpoint->Data (&Offset, sizeof (long));
+
+    if ((aCheckpoint->Restoring () == TRUE) && (File != NULL))
+        {
+        if (Offset < 0L)
+            {
+            NextLine = 0;
+            LinesInBlock = 0;
+            }
+        else
+            {
+            fseek (File, Offset, SEEK_SET);
+            ReadBlock ();
+            }
+        }
+    }
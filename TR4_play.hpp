@@ -0,0 +1,87 @@
+//*************************************************************************************
+//  TR4_play.hpp
+//      This is the header for playback tasks, which feed data recorded by a data
+//      logger back into a program.  A playback task reads a logger's file one line at
+//      a time; when the scheduler's time reaches the time written in a line, the task
+//      copies the line's items into the user's variables.  Recorded measurements can
+//      so stand in for a plant, and field data can be replayed through a new version
+//      of a controller - in fast-forward simulation, much faster than real time.
+//
+//      The file may be a text file written by the logger's Flush() function, with
+//      items separated by spaces, commas, or tabs, or a binary file written by its
+//      WriteBinary() function.  Lines of a text file which aren't all numbers, such
+//      as the title and column headers, are skipped.  The columns are numbered
+//      from zero as they're found in the file (if line numbers were written, they're
+//      column zero).  One column holds the time; it's column zero unless another is
+//      chosen with SetTimeColumn().  The times must not go down from line to line.
+//
+//      The file isn't read into memory all at once, so a recording may be much bigger
+//      than the memory.  It's read through a large file buffer, and a block of lines
+//      is read ahead of the one which is being played.
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//*************************************************************************************
+
+#ifndef TR4_PLAY_HPP
+    #define  TR4_PLAY_HPP                   //  Variable to prevent multiple inclusions
+
+#define  PLAYBACK_BLOCK_LINES   256         //  Lines read ahead at a time
+#define  PLAYBACK_FILE_BUFFER   32768       //  Size of the file buffer in bytes
+#define  PLAYBACK_LINE_SIZE     4096        //  Longest line in a text file
+
+
+//=====================================================================================
+//  Class: CPlaybackTask
+//      A sample time task which runs at the times in a recording rather than at even
+//      intervals.  The sample time given to the constructor should be about the time
+//      between lines of the recording; it's used to decide when the task is too late.
+//      After copying each line into the variables, the task calls NewLine(), which
+//      the user may override, e.g. to publish the values on the data bus.  When the
+//      recording runs out the task deactivates itself.
+//=====================================================================================
+
+class CPlaybackTask : public CTask
+    {
+    private:
+        char* FileName;                     //  Name of the recording's file
+        FILE* File;                         //  The file, open for reading
+        boolean Binary;                     //  TRUE for a binary log file
+        int NumColumns;                     //  Number of columns in each line
+        int TimeColumn;                     //  Column which holds the time
+        double** Targets;                   //  Where each column's items go
+        double* Block;                      //  Lines read ahead, one after another
+        long* Offsets;                      //  Where each line begins in the file
+        int LinesInBlock;                   //  Number of lines in Block
+        int NextLine;                       //  Next line in Block to be played
+        long LinesPlayed;                   //  Number of lines played so far
+        char* LineBuffer;                   //  Holds one line of a text file
+
+        void OpenFile (void);               //  Open file and find the columns
+        boolean ReadLine (double*, long*);  //  Read one line and find where it was
+        void ReadBlock (void);              //  Read the next block of lines
+
+    public:
+        CPlaybackTask (const char*, int,    //  Constructor is given name, priority,
+                       real_time,           //    sample time, and the recording's
+                       const char*);        //    file name
+        virtual ~CPlaybackTask (void);
+
+        void Connect (int, double*);        //  Copy a column into a variable
+        void SetTimeColumn (int);           //  Choose which column holds the time
+        virtual void NewLine (void);        //  User may handle each line as it's read
+
+        void Run (void);                    //  Play all lines which are due
+        void CheckpointData (CCheckpoint*); //  Save the place in the recording
+
+        int GetNumColumns (void)            //  Find how many columns the file has
+            { return (NumColumns); }
+        long GetLinesPlayed (void)          //  Find how many lines have been played
+            { return (LinesPlayed); }
+        real_time GetLineTime (void);       //  Find time of the next line to play
+        boolean IsFinished (void)           //  Find out if the whole recording
+            { return ((NextLine >= LinesInBlock) ? TRUE : FALSE); } //  has been played
+    };
+
+#endif      //  End of multiple-inclusion protection
@@ -1,695 +1,1174 @@
-//*************************************************************************************
-//  TR4_PROC.CPP
-//      This is the implementation file for the process object.  This object contains 
-//      task lists and whatever else it needs to schedule the project.  
-//
-//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
-//      May be used and distributed for any non-commercial purposes as long as this 
-//      copyright notice is included.  
-//      Original program 11-94 by DMA 
-//      11-21-94  JR   New class structure
-//      12-19-94  JR   Spun off as separate implementation file
-//       5-20-95  JR   Changed to TranRun3 project
-//      12-21-96  JR   Changed to TranRun4 project (another sequel) 
-//*************************************************************************************
-
-#include <conio.h>
-#include <dos.h>
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include "TranRun4.hpp"
-
-//=====================================================================================
-//  Class: CProcess
-//      This is the scheduler which runs a process.  Here we define a process as one 
-//      set of tasks which are intended to run on one computer.  However, for purposes 
-//      of program development, more than one process may share a computer in some 
-//      simulation modes.  The master scheduler creates this process object and passes 
-//      it messages to set up and schedule the running of run its process. 
-//=====================================================================================
-
-//-------------------------------------------------------------------------------------
-//  Constructor:  CProcess (Default constructor)
-//      If no parameters are given to this constructor, it creates a process with all
-//      empty task lists
-
-CProcess::CProcess (const char* aName)
-    {
-    //  Make some space and save the name of this object
-    if ((Name = new char[strlen (aName) + 1]) != NULL)
-        strcpy (Name, aName);
-
-    //  The serial number given to inserted tasks begins at zero
-    TaskSerialNumber = 0;
-
-    //  Create and allocate space for new task lists; give them pointer to this object
-    TimerIntTasks = new CTimerIntTaskList ();
-    PreemptibleTasks = new CPreemptiveTaskList ();
-    BackgroundTasks = new CPreemptiveTaskList ();
-    ContinuousTasks = new CContinuousTaskList ();
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Destructor:  ~CProcess
-//      This destructor just frees up the memory which has been used by this object.
-
-CProcess::~CProcess (void)
-    {
-    delete TimerIntTasks;           //  Delete the task lists
-    delete PreemptibleTasks;
-    delete BackgroundTasks;
-    delete ContinuousTasks;
-
-    DELETE_ARRAY Name;              //  Zap the name string
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function: DumpConfiguration
-//      This function writes a "configuration dump" for a process.  The idea is that it
-//      writes one line for each task wth name, type, priority, timing and so on and
-//      puts state names in a column at the right of that line.  This way we get an
-//      easy-to-read matrix of task and state information.
-
-void CProcess::DumpConfiguration (const char* aName)
-    {
-    FILE *DumpFile;                             //  Handle of file to which to dump
-
-
-    //  If a valid name was given, open the file, write-only, overwriting any old file
-    if (aName == NULL)
-        return;
-
-    //  Create a new file object to which to write the dump
-    if ((DumpFile = fopen (aName, "w")) != NULL)
-        {
-        fprintf (DumpFile, "\nConfiguration of Tasks in Process \"%s\"\n\n", Name);
-        fprintf (DumpFile,
-                 "Task                                            Sample  State\n");
-        fprintf (DumpFile,
-                 "Name                     Type       Priority    Time    Names\n\n");
-
-        //  Each list of tasks must be asked to dump its configurations
-        TimerIntTasks->DumpConfiguration (DumpFile);
-        PreemptibleTasks->DumpConfiguration (DumpFile);
-        BackgroundTasks->DumpConfiguration (DumpFile);
-        ContinuousTasks->DumpConfiguration (DumpFile);
-
-        fprintf (DumpFile, "\n\n");             //  Write some returns at the end
-        fclose (DumpFile);                      //  of the file and then close it
-        }
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function:  DumpStatus
-//      This function writes a status dump which shows what all processes are doing.
-//      It does so by calling the DumpStatus() methods for all the task lists.
-
-void CProcess::DumpStatus (const char* aName)
-    {
-    FILE* StatusFile;                           //  Handle of file where the dump goes
-
-
-    //  If a valid name was given, open the file, write-only, overwriting the old file
-    if (aName == NULL)
-        return;
-
-    //  Create a new file object to which to write the dump
-    if ((StatusFile = fopen (aName, "w")) != NULL)
-        {
-        fprintf (StatusFile, "Status Dump for Tasks in Process \"%s\"\n", Name);
-
-        TimerIntTasks->DumpStatus (StatusFile);         //  Ask the lists of tasks
-        PreemptibleTasks->DumpStatus (StatusFile);      //  to dump all their statuses
-        BackgroundTasks->DumpStatus (StatusFile);
-        ContinuousTasks->DumpStatus (StatusFile);
-
-        fclose (StatusFile);
-        }
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Functions:  ProfileOn and ProfileOff
-//      These functions activate and deactivate execution-time profiling for all
-//      task lists belonging to this process.  
-
-void CProcess::ProfileOn (void)
-    {
-    TimerIntTasks->ProfileOn ();
-    PreemptibleTasks->ProfileOn ();
-    BackgroundTasks->ProfileOn ();
-    ContinuousTasks->ProfileOn ();
-    }
-
-void CProcess::ProfileOff (void)
-    {
-    TimerIntTasks->ProfileOff ();
-    PreemptibleTasks->ProfileOff ();
-    BackgroundTasks->ProfileOff ();
-    ContinuousTasks->ProfileOff ();
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Functions:  DumpProfiles
-//      This function writes information about how long the tasks in a process take to
-//      run.  It writes a header and then calls the DumpProfile() method for each
-//      task and state; these methods will write execution time information for the
-//      Run() or Entry(), Action(), and TransitionTest() functions.  The first func-
-//      tion is meant to be called directly, the second by CMaster::DumpProfiles().
-
-void CProcess::DumpProfiles (const char* aFileName)
-    {
-    FILE* aFile;                            //  Handle of the file to which we write
-
-    //  Attempt to open the file.  If it can't be opened, complain and exit
-    if ((aFile = fopen (aFileName, "w")) == NULL)
-        TR_Exit ("Unable to open file \"%s\" for process profile dump", aFileName);
-    //  If the file was opened, write the data to it and close it  
-    else
-        DumpProfiles (aFile);
-        fclose (aFile);
-    }
-
-void CProcess::DumpProfiles (FILE* aFile)
-    {
-    #if (defined (TR_TIME_FREE) || defined (TR_THREAD_MULTI))
-        fprintf (aFile, "\nTiming information for tasks in process \"%s\"\n\n", Name);
-
-        //  Each list of tasks must be asked to dump its timing information
-        TimerIntTasks->DumpProfiles (aFile);
-        PreemptibleTasks->DumpProfiles (aFile);
-        BackgroundTasks->DumpProfiles (aFile);
-        ContinuousTasks->DumpProfiles (aFile);
-
-    #else                                   //  In case we can't do timing...
-        fprintf (aFile, "Function timing information is not available.\n");
-        fprintf (aFile, "In order to measure function timing, you must use\n");
-        fprintf (aFile, "a high-resolution timer or multithreading mode.\n\n");
-    #endif
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function:  RunBackground
-//      This function runs one 'sweep' through those tasks which are not called by the
-//      interrupt service routine.  It works differently in different real-time modes:
-//        - In sequential modes, runs all tasks in order, then increments time.
-//        - In low-latency modes, it runs tasks a few at a time according to priority.
-//        - In interrupt modes, it runs continuous tasks only, because the other tasks
-//          are being called from the interrupt service routine.  
-
-void CProcess::RunBackground (void)
-    {
-    //  If in single-thread, sequential simulation mode: just run all tasks in order 
-    #if defined (TR_EXEC_SEQ) && defined (TR_THREAD_SINGLE)
-        TimerIntTasks->RunAll ();
-        PreemptibleTasks->RunAll (); 
-        BackgroundTasks->RunAll ();
-        ContinuousTasks->RunAll ();
-    #endif
-
-    //  If in single-thread, minimum-latency mode: run all timer tasks, then run one
-    //  preemptible task which is ready to go.  If no preemptible task ran, run the
-    //  next available background or continuous task
-    #if defined (TR_EXEC_MIN) && defined (TR_THREAD_SINGLE)
-        TimerIntTasks->RunAll ();
-        if (PreemptibleTasks->RunOne () == FALSE)
-            {
-            if (BackgroundTasks->RunOne () == FALSE)
-                ContinuousTasks->RunOne ();
-            }
-    #endif
-
-    //  Multithreading:  Interrupts run timer-int and preemptible tasks only.  In the
-    //  background, run one pre-emptible background task, or if none is ready to go,
-    //  run a continuous task 
-    #if defined (TR_THREAD_MULTI)
-        if (BackgroundTasks->RunOne () == FALSE)
-            ContinuousTasks->RunOne ();
-    #endif
-
-    //  Externally controlled simulation: nope, we haven't got it yet
-    #if defined (TR_TIME_EXTSIM)
-        TR_Exit ("External simulation mode not yet implemented");
-    #endif
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function:  RunForeground
-//      This function runs the foreground tasks, i.e. those which are called by the 
-//      interrupt service routine.  In multithreading mode, this means that it first
-//      gives all the timer interrupt tasks a call, and they run if their sample time
-//      has come; then it runs the highest priority preemptible task.
-
-void CProcess::RunForeground (void)
-    {
-    //  Multithreading:  Interrupts run timer interrupt and preemptible tasks
-    #if defined (TR_THREAD_MULTI)
-        TimerIntTasks->RunAll ();       //  This calls all timer interrupt tasks
-        PreemptibleTasks->RunAll ();    //  This runs high priority preemptible tasks
-    #endif
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Functions:  AddTask (versions for each task type)
-//      This function creates a new task of the type specified by the user and calls
-//      InsertTask() to put it into the process's task list.  Several overloaded ver-
-//      sions of this method are given because the functions which create different
-//      types of tasks (timer interrupt, continuous, etc.) take different numbers
-//      and types of parameters.  The CTL_EXEC version of this program does not permit 
-//      adding tasks in this manner because there are no state objects to run in them.
-
-//  This version creates a continuous task and takes no timing parameters
-CTask *CProcess::AddTask (const char *aName, TaskType aType)
-    {
-    CTask *pNewTask;                            //  Pointer to the task we create here
-
-    pNewTask = new CTask (aName, aType);            //  Create the task object
-    ContinuousTasks->Insert (pNewTask);             //  Insert it in the task list
-    pNewTask->SetSerialNumber (TaskSerialNumber++); //  Give the task a serial number
-    return (pNewTask);                              //  Return a pointer to it
-    }
-
-//  This one is for a timer-interrupt task which takes a time but no priority
-CTask *CProcess::AddTask (const char *aName, TaskType aType, real_time aTime)
-    {
-    CTask *pNewTask;
-
-    pNewTask = new CTask (aName, aType, aTime);
-    TimerIntTasks->Insert (pNewTask);
-    pNewTask->SetSerialNumber (TaskSerialNumber++);
-    return (pNewTask);
-    }
-
-//  This version is for an event task which takes a proirity but no timing information
-CTask *CProcess::AddTask (const char *aName, TaskType aType, int aPriority)
-    {
-    CTask *pNewTask;
-
-    pNewTask = new CTask (aName, aType, aPriority);
-    BackgroundTasks->Insert (pNewTask);
-    pNewTask->SetSerialNumber (TaskSerialNumber++);
-    return (pNewTask);
-    }
-
-//  This method creates and inserts a sample time task which needs timing and priority
-CTask *CProcess::AddTask (const char *aName, TaskType aType, int aPriority,
-                          real_time aTime)
-    {
-    CTask *pNewTask;
-
-    pNewTask = new CTask (aName, aType, aPriority, aTime);
-    if (aType == PREEMPTIBLE)  PreemptibleTasks->Insert (pNewTask);
-    if (aType == SAMPLE_TIME)  BackgroundTasks->Insert (pNewTask);
-    pNewTask->SetSerialNumber (TaskSerialNumber++);
-    return (pNewTask);
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function:  InsertTask (versions which take a task pointer or a task reference)
-//      These functions insert the given task into the appropriate task list.  The task
-//      object must already have been instantiated.  These functions are usually used
-//      to insert custom task objects of a type descended from CTask into a task list.
-
-CTask *CProcess::InsertTask (CTask* pTask)
-    {
-    switch (pTask->TheType)
-        {
-        case (TIMER_INT):
-            TimerIntTasks->Insert (pTask);
-            break;
-        case (PREEMPTIBLE):
-            PreemptibleTasks->Insert (pTask);
-            break;
-        case (SAMPLE_TIME):
-        case (EVENT):
-            BackgroundTasks->Insert (pTask);
-            break;
-        case (CONTINUOUS):
-            ContinuousTasks->Insert (pTask);
-            break;
-        default:
-            TR_Exit ("Attempt to insert task \"%s\" of unknown type into process",
-                     pTask->GetName ());
-        }
-
-    //  This line gives the task a uniqu serial number
-    pTask->SetSerialNumber (TaskSerialNumber++);
-
-    return (pTask);
-    }
-
-
-CTask *CProcess::InsertTask (CTask& aTask)
-    {
-    return (InsertTask (&aTask));
-    }
-
-
-
-//=====================================================================================
-//  Class: CTaskList
-//      This class contains the common items among linked lists intended for storing 
-//      all kinds of CTask objects (i.e. it has common code from the task lists below).
-//=====================================================================================
-
-//-------------------------------------------------------------------------------------
-//  Constructor: CTimerIntTaskList
-//      This constructor is just the default sort.
-
-CTaskList::CTaskList (void) : CBasicList ()
-    {
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Destructor: ~CTaskList
-//      This destructor zaps all the tasks in the list.  These tasks actually have
-//      virtual destructors, so the user's tasks' destructors get called.
-
-CTaskList::~CTaskList (void)
-    {
-    for (CTask* pCur = (CTask*)GetHead (); pCur != NULL; pCur = (CTask*)GetNext ())
-        delete pCur;
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function: RunAll
-//      This function passes on a [run] message which it has received from the main 
-//      scheduler object.  Each of the tasks in the list is given the message to "go
-//      run yourself."  
-
-boolean CTaskList::RunAll (void)
-    {
-    CTask* pCurTask;                    //  Pointer to the task currently being run
-
-
-    //  Send a run message to each task in the list, in sequence
-    pCurTask = (CTask*) GetHead ();
-    while (pCurTask != NULL)
-        {
-        pCurTask->Schedule ();
-        pCurTask = (CTask*) GetNext ();
-        }
-
-    return (TRUE);
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function: RunOne
-//      This function acts on a run message from the main scheduler by sending just 
-//      one task in the list a run-yourself message.  RunOne messages are sequenced 
-//      through the list.  
-
-boolean CTaskList::RunOne (void)
-    {
-    CTask* pCurTask;                        //  Pointer to the task currently being run
-
-
-    pCurTask = (CTask*) GetNext ();         //  See if there's a next task available
-
-    if (pCurTask == NULL)                   //  If we were at end of task list, wrap
-        pCurTask = (CTask*) GetHead ();     //  back around to the beginning
-
-    if (pCurTask != NULL)
-        pCurTask->Schedule ();              //  Now run the task (if there is one) 
-
-    return (TRUE);                          //  If we get here, no task has run 
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function: Insert 
-//      This function inserts the task which is pointed to by its argument into the 
-//      list of timer interrupt tasks.  
-
-CTask *CTaskList::Insert (CTask* pNew)
-    {
-    //  Call function to insert this task into the list; tell it its parent's address 
-    CBasicList::Insert ((void*)pNew, pNew->GetPriority ());
-
-    return (pNew);
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function: DumpConfiguration
-//      This function writes a configuration dump to the stream given in its argument.
-//      It does so by calling the DumpStatus() methods for tasks in the list.
-
-void CTaskList::DumpConfiguration (FILE* aFile)
-    {
-    CTask *pCur;                            //  Pointer to the task currently dumping
-
-    for (pCur = (CTask *)GetHead (); pCur != NULL; pCur = (CTask *)GetNext ())
-        pCur->DumpConfiguration (aFile);
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function: DumpStatus
-//      This function writes a task list status dump to the stream given in its argu-
-//      ment.  It does so by calling the DumpStatus() methods for tasks in the list.
-
-void CTaskList::DumpStatus (FILE* aFile)
-    {
-    CTask *pCur;                            //  Pointer to the task currently dumping
-
-    for (pCur = (CTask*)GetHead (); pCur != NULL; pCur = (CTask *)GetNext ())
-        pCur->DumpStatus (aFile);
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Functions:  ProfileOn and ProfileOff
-//      These functions activate and deactivate execution-time profiling for all
-//      tasks in the list. 
-
-void CTaskList::ProfileOn (void)
-    {
-    CTask *pCur;
-    for (pCur = (CTask*)GetHead (); pCur != NULL; pCur = (CTask *)GetNext ())
-        pCur->ProfileOn ();
-    }
-
-void CTaskList::ProfileOff (void)
-    {
-    CTask *pCur;
-    for (pCur = (CTask*)GetHead (); pCur != NULL; pCur = (CTask *)GetNext ())
-        pCur->ProfileOff ();
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function: DumpTimingInfo
-//      This function writes information about how long task functions take to run
-//      to the stream given in its argument.  It does so by calling DumpProfile()
-//      methods for tasks in the list.
-
-void CTaskList::DumpProfiles (FILE* aFile)
-    {
-    CTask *pCur;                            //  Pointer to the task currently dumping
-
-    for (pCur = (CTask*)GetHead (); pCur != NULL; pCur = (CTask *)GetNext ())
-        pCur->DumpProfile (aFile);
-    }
-
-
-//=====================================================================================
-//  Class: CTimerIntTaskList
-//      This class implements a type of linked list intended for storing CTask objects 
-//      which represent timer interrupt tasks.  
-//=====================================================================================
-
-//-------------------------------------------------------------------------------------
-//  Constructor: CTimerIntTaskList
-//      This constructor is just the default sort.  
-
-CTimerIntTaskList::CTimerIntTaskList (void)
-    {
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Destructor: ~CTimerIntTaskList
-//      This destructor frees the memory which has been taken up by all the task 
-//      objects in the task list.   
-
-CTimerIntTaskList::~CTimerIntTaskList (void)
-    {
-    this->CTaskList::~CTaskList ();
-    }
-
-
-
-//-------------------------------------------------------------------------------------
-//  Function: RunAll
-//      This function passes on a [run] message which it has received from the main 
-//      scheduler object.  Each of the tasks in the list is given the message to "go
-//      run yourself."
-//  Changes
-//       8-17-95  JR   Each task is run repeatedly until it idles itself
-//       9-02-95  JR   GetObjWith() added in case list is changed during re-entrance
-//                     of this task if we were interrupted during pCurTask->Schedule()
-
-boolean CTimerIntTaskList::RunAll (void)
-    {
-    CTask *pCurTask;                    //  Pointer to the task currently being run
-    TaskStatus RetStatus;               //  Status returned by a task which ran
-
-    //  Send a run message to each task in the list, in sequence.  Each task will get
-    //  as many scans as it needs, i.e. we run it until it idles itself
-    pCurTask = (CTask *) GetHead ();
-    while (pCurTask != NULL)
-        {
-        //  Call the task's Schedule() method, which runs the Entry() and/or Action()
-        //  functions, repeatedly until the task becomes idle or deactivated
-        do
-            {
-            //  Run the task by calling the task's Schedule() method
-            RetStatus = pCurTask->Schedule ();
-            pCurTask->GetSampleTime ();
-
-            //  If this task interrupted itself, it's too slow so complain and exit
-            if (RetStatus == TS_RUNNING)
-                {
-                TR_Exit ("Timer interrupt task \"%s\" has interrupted itself",
-                         pCurTask->GetName ());
-                return (FALSE);
-                }
-            }
-        while ((RetStatus != TS_IDLE) && (RetStatus != TS_DEACTIVATED));
-
-        GetObjWith (pCurTask);
-        pCurTask = (CTask *) GetNext ();
-        }
-
-    return (TRUE);
-    }
-
-
-//=====================================================================================
-//  Class: CPreemptiveTaskList
-//      This class implements a type of linked list intended for storing CTask objects 
-//      which represent timer interrupt tasks.  
-//=====================================================================================
-
-//-------------------------------------------------------------------------------------
-//  Constructor: CTimerIntTaskList
-//      This is just a default constructor.  
-
-CPreemptiveTaskList::CPreemptiveTaskList (void) 
-    {
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Destructor: ~CPreemptiveTaskList
-//      This destructor frees the memory which has been taken up by all the task 
-//      objects in the task list.   
-
-CPreemptiveTaskList::~CPreemptiveTaskList (void)
-    {
-    this->CTaskList::~CTaskList ();
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function: RunAll
-//      This function acts on a Run message from the process scheduler.  It runs all
-//      the tasks which are ready to run, beginning with the highest priority one and
-//      working down to the bottom - unless it encounters a task which is already
-//      running, in which case it quits and returns control to the thread in which
-//      that already running task is running.
-//  Changes
-//       9-02-95  JR   GetObjWith() added in case list is changed during re-entrance
-//                     of this task if we were interrupted during pCurTask->Schedule()
-
-boolean CPreemptiveTaskList::RunAll (void)
-    {
-    CTask *pCurTask;                        //  Pointer to the task currently being run
-    TaskStatus RetStatus;                   //  Status returned by a task which ran 
-
-
-    //  Begin with the first task in the list; it has the highest priority.  Run it.  
-    //  If this task is already running or has been preempted, exit; otherwise, after 
-    //  this task is done go on to the next task which might need a chance to run too 
-    pCurTask = (CTask*) GetHead ();
-    while (pCurTask != NULL)
-        {
-        RetStatus = pCurTask->Schedule ();
-        if ((RetStatus == TS_RUNNING) || (RetStatus == TS_PREEMPTED))
-            break;
-        GetObjWith (pCurTask);
-        pCurTask = (CTask *) GetNext ();
-        }
-
-    return (TRUE);
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function: RunOne
-//      This function runs the highest priority ready-to-go task at any given time, if
-//      there actually is a task ready to run.  It returns FALSE if no task was found 
-//      which was ready to run and TRUE if a task did run.
-
-boolean CPreemptiveTaskList::RunOne (void)
-    {
-    CTask *pCurTask;                        //  Pointer to the task currently being run
-    TaskStatus RetStatus;                   //  Status returned by a task which ran 
-
-
-    //  Begin with the first task in the list; it has the highest priority.  Send a 
-    //  Schedule message to each task until one of them actually runs 
-    pCurTask = (CTask*) GetHead ();
-    while (pCurTask != NULL)
-        {
-        RetStatus = pCurTask->Schedule ();
-        if (RetStatus == TS_READY)          //  The TS_READY return tells us the task
-            return (TRUE);                  //  ran; another code means it didn't 
-        pCurTask = (CTask *) GetNext ();
-        }
-
-    return (FALSE);                         //  If we get here, no task function ran 
-    }
-
-
-//=====================================================================================
-//  Class: CContinuousTaskList
-//      This class implements a type of linked list intended for storing CTask objects 
-//      which represent timer interrupt tasks.  
-//      The CTaskList class is also designed to pass messages to the tasks in a list,
-//      for example a [run] message telling the tasks to run their action functions.  
-//=====================================================================================
-
-//-------------------------------------------------------------------------------------
-//  Constructor: CTimerIntTaskList
-//      Well, as one can see, this doesn't do much in the current incarnation.
-
-CContinuousTaskList::CContinuousTaskList ()
-    {
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Destructor: ~CContinuousTaskList
-//      This destructor frees the memory which has been taken up by all the task
-//      objects in the task list.
-
-CContinuousTaskList::~CContinuousTaskList (void)
-    {
-    this->CTaskList::~CTaskList ();
-    }
-
-
+//*************************************************************************************
+//  TR4_PROC.CPP
+//      This is the implementation file for the process object.  This object contains 
+//      task lists and whatever else it needs to schedule the project.  
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this 
+//      copyright notice is included.  
+//      Original program 11-94 by DMA 
+//      11-21-94  JR   New class structure
+//      12-19-94  JR   Spun off as separate implementation file
+//       5-20-95  JR   Changed to TranRun3 project
+//      12-21-96  JR   Changed to TranRun4 project (another sequel) 
+//*************************************************************************************
+
+#include <conio.h>
+#include <dos.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "TranRun4.hpp"
+
+
+//  In parallel simulation mode, each thread which runs a process keeps a pointer to
+//  that process here.  The time functions and trace functions use it to find the
+//  right clock and trace buffer
+#if defined (TR_TIME_EXTSIM)
+    static TR_THREAD_LOCAL CProcess* pRunningProcess = NULL;
+#endif
+
+
+//=====================================================================================
+//  Class: CProcess
+//      This is the scheduler which runs a process.  Here we define a process as one 
+//      set of tasks which are intended to run on one computer.  However, for purposes 
+//      of program development, more than one process may share a computer in some 
+//      simulation modes.  The master scheduler creates this process object and passes 
+//      it messages to set up and schedule the running of run its process. 
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+//  Constructor:  CProcess (Default constructor)
+//      If no parameters are given to this constructor, it creates a process with all
+//      empty task lists
+
+CProcess::CProcess (const char* aName)
+    {
+    //  Make some space and save the name of this object
+    if ((Name = new char[strlen (aName) + 1]) != NULL)
+        strcpy (Name, aName);
+
+    //  The serial number given to inserted tasks begins at zero
+    TaskSerialNumber = 0;
+
+    //  Create and allocate space for new task lists; give them pointer to this object
+    TimerIntTasks = new CTimerIntTaskList ();
+    PreemptibleTasks = new CPreemptiveTaskList ();
+    BackgroundTasks = new CPreemptiveTaskList ();
+    ContinuousTasks = new CContinuousTaskList ();
+
+    //  No state's timeout is running yet
+    Timeouts = new CTimeoutQueue ();
+
+    //  Sweeps are run in one thread unless ParallelOn() is called
+    Sweep = NULL;
+
+    //  In parallel simulation mode, each process starts with its own clock at zero
+    //  and an empty buffer for the trace lines made during a time window
+    #if defined (TR_TIME_EXTSIM)
+        LocalTime = (real_time)0.0;
+        SweepCount = 0L;
+        WindowTrace = NULL;
+        TraceCount = 0;
+        TraceSize = 0;
+    #endif
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Destructor:  ~CProcess
+//      This destructor just frees up the memory which has been used by this object.
+
+CProcess::~CProcess (void)
+    {
+    ParallelOff ();                 //  Stop the parallel sweep's threads, if any
+    delete TimerIntTasks;           //  Delete the task lists
+    delete PreemptibleTasks;
+    delete BackgroundTasks;
+    delete ContinuousTasks;
+    delete Timeouts;                //  Tasks take their timeouts out as they go
+
+    #if defined (TR_TIME_EXTSIM)
+        if (WindowTrace != NULL)
+            DELETE_ARRAY WindowTrace;
+    #endif
+
+    DELETE_ARRAY Name;              //  Zap the name string
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: DumpConfiguration
+//      This function writes a "configuration dump" for a process.  The idea is that it
+//      writes one line for each task wth name, type, priority, timing and so on and
+//      puts state names in a column at the right of that line.  This way we get an
+//      easy-to-read matrix of task and state information.
+
+void CProcess::DumpConfiguration (const char* aName)
+    {
+    FILE *DumpFile;                             //  Handle of file to which to dump
+
+
+    //  If a valid name was given, open the file, write-only, overwriting any old file
+    if (aName == NULL)
+        return;
+
+    //  Create a new file object to which to write the dump
+    if ((DumpFile = fopen (aName, "w")) != NULL)
+        {
+        fprintf (DumpFile, "\nConfiguration of Tasks in Process \"%s\"\n\n", Name);
+        fprintf (DumpFile,
+                 "Task                                            Sample  State\n");
+        fprintf (DumpFile,
+                 "Name                     Type       Priority    Time    Names\n\n");
+
+        //  Each list of tasks must be asked to dump its configurations
+        TimerIntTasks->DumpConfiguration (DumpFile);
+        PreemptibleTasks->DumpConfiguration (DumpFile);
+        BackgroundTasks->DumpConfiguration (DumpFile);
+        ContinuousTasks->DumpConfiguration (DumpFile);
+
+        fprintf (DumpFile, "\n\n");             //  Write some returns at the end
+        fclose (DumpFile);                      //  of the file and then close it
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  DumpStatus
+//      This function writes a status dump which shows what all processes are doing.
+//      It does so by calling the DumpStatus() methods for all the task lists.
+
+void CProcess::DumpStatus (const char* aName)
+    {
+    FILE* StatusFile;                           //  Handle of file where the dump goes
+
+
+    //  If a valid name was given, open the file, write-only, overwriting the old file
+    if (aName == NULL)
+        return;
+
+    //  Create a new file object to which to write the dump
+    if ((StatusFile = fopen (aName, "w")) != NULL)
+        {
+        fprintf (StatusFile, "Status Dump for Tasks in Process \"%s\"\n", Name);
+
+        TimerIntTasks->DumpStatus (StatusFile);         //  Ask the lists of tasks
+        PreemptibleTasks->DumpStatus (StatusFile);      //  to dump all their statuses
+        BackgroundTasks->DumpStatus (StatusFile);
+        ContinuousTasks->DumpStatus (StatusFile);
+
+        fclose (StatusFile);
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Functions:  ProfileOn and ProfileOff
+//      These functions activate and deactivate execution-time profiling for all
+//      task lists belonging to this process.  
+
+void CProcess::ProfileOn (void)
+    {
+    TimerIntTasks->ProfileOn ();
+    PreemptibleTasks->ProfileOn ();
+    BackgroundTasks->ProfileOn ();
+    ContinuousTasks->ProfileOn ();
+    }
+
+void CProcess::ProfileOff (void)
+    {
+    TimerIntTasks->ProfileOff ();
+    PreemptibleTasks->ProfileOff ();
+    BackgroundTasks->ProfileOff ();
+    ContinuousTasks->ProfileOff ();
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Functions:  CalibrateOn, CalibrateOff, and CalibratedLoad
+//      These functions start and stop measuring the processor time used by all the
+//      tasks in this process, and then add up the share of the target's processor
+//      which they would use.  See CMaster::Calibrate().
+
+void CProcess::CalibrateOn (void)
+    {
+    TimerIntTasks->CalibrateOn ();
+    PreemptibleTasks->CalibrateOn ();
+    BackgroundTasks->CalibrateOn ();
+    ContinuousTasks->CalibrateOn ();
+    }
+
+void CProcess::CalibrateOff (void)
+    {
+    TimerIntTasks->CalibrateOff ();
+    PreemptibleTasks->CalibrateOff ();
+    BackgroundTasks->CalibrateOff ();
+    ContinuousTasks->CalibrateOff ();
+    }
+
+real_time CProcess::CalibratedLoad (real_time aTime, double aSlowdown)
+    {
+    return (TimerIntTasks->CalibratedLoad (aTime, aSlowdown)
+            + PreemptibleTasks->CalibratedLoad (aTime, aSlowdown)
+            + BackgroundTasks->CalibratedLoad (aTime, aSlowdown)
+            + ContinuousTasks->CalibratedLoad (aTime, aSlowdown));
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Functions:  ParallelOn and ParallelOff
+//      ParallelOn() has the process run its sweeps in the given number of threads,
+//      counting its own; tasks in different groups (see CTask::SetGroup()) then run
+//      at the same time.  ParallelOff() stops the threads, and sweeps are run in one
+//      thread again.  These functions mustn't be called by a task while it runs.  In
+//      modes other than sequential single-thread simulation, or if there are no
+//      threads on this system, sweeps are always run in one thread.
+
+void CProcess::ParallelOn (int aThreads)
+    {
+    ParallelOff ();
+
+    #if defined (TR_PARALLEL_SWEEP) && !defined (TR_NO_THREADS)
+        if (aThreads > 1)
+            Sweep = new CParallelSweep (this, aThreads);
+    #else
+        (void)aThreads;                     //  Not used in this mode
+    #endif
+    }
+
+void CProcess::ParallelOff (void)
+    {
+    if (Sweep != NULL)
+        {
+        delete Sweep;
+        Sweep = NULL;
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  Checkpoint
+//      This function saves or restores all the tasks in this process, one list after
+//      another.  The process's name is saved first so that a checkpoint can't be put
+//      back into the wrong process.
+
+void CProcess::Checkpoint (CCheckpoint* aCheckpoint)
+    {
+    aCheckpoint->Name (Name);
+    TimerIntTasks->Checkpoint (aCheckpoint);
+    PreemptibleTasks->Checkpoint (aCheckpoint);
+    BackgroundTasks->Checkpoint (aCheckpoint);
+    ContinuousTasks->Checkpoint (aCheckpoint);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  FindTask
+//      This function looks through all the task lists for the task which has the
+//      given serial number in this process, and returns a pointer to it (or NULL).
+
+CTask* CProcess::FindTask (int aNumber)
+    {
+    CTask* pTask;
+
+    if ((pTask = TimerIntTasks->FindTask (aNumber)) != NULL)
+        return (pTask);
+    if ((pTask = PreemptibleTasks->FindTask (aNumber)) != NULL)
+        return (pTask);
+    if ((pTask = BackgroundTasks->FindTask (aNumber)) != NULL)
+        return (pTask);
+    return (ContinuousTasks->FindTask (aNumber));
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Functions:  DumpProfiles
+//      This function writes information about how long the tasks in a process take to
+//      run.  It writes a header and then calls the DumpProfile() method for each
+//      task and state; these methods will write execution time information for the
+//      Run() or Entry(), Action(), and TransitionTest() functions.  Then each task's
+//      time in states and transition counts are written.  The first function is
+//      meant to be called directly, the second by CMaster::DumpProfiles().
+
+void CProcess::DumpProfiles (const char* aFileName)
+    {
+    FILE* aFile;                            //  Handle of the file to which we write
+
+    //  Attempt to open the file.  If it can't be opened, complain and exit
+    if ((aFile = fopen (aFileName, "w")) == NULL)
+        TR_Exit ("Unable to open file \"%s\" for process profile dump", aFileName);
+    //  If the file was opened, write the data to it and close it  
+    else
+        DumpProfiles (aFile);
+        fclose (aFile);
+    }
+
+void CProcess::DumpProfiles (FILE* aFile)
+    {
+    #if defined (TR_PROFILE_TIMING)
+        fprintf (aFile, "\nTiming information for tasks in process \"%s\"\n\n", Name);
+
+        //  Each list of tasks must be asked to dump its timing information
+        TimerIntTasks->DumpProfiles (aFile);
+        PreemptibleTasks->DumpProfiles (aFile);
+        BackgroundTasks->DumpProfiles (aFile);
+        ContinuousTasks->DumpProfiles (aFile);
+
+    #else                                   //  In case we can't do timing...
+        fprintf (aFile, "Function timing information is not available.\n");
+        fprintf (aFile, "In order to measure function timing, you must use\n");
+        fprintf (aFile, "a high-resolution timer or multithreading mode, and\n");
+        fprintf (aFile, "profiling must not be turned off (TR_PROFILE_OFF).\n\n");
+    #endif
+
+    //  Time spent in states is measured by the scheduler's clock, so it's written in
+    //  every mode
+    fprintf (aFile, "\nTime in states and transitions for tasks in process \"%s\"\n\n",
+             Name);
+    TimerIntTasks->DumpStatistics (aFile);
+    PreemptibleTasks->DumpStatistics (aFile);
+    BackgroundTasks->DumpStatistics (aFile);
+    ContinuousTasks->DumpStatistics (aFile);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  RunBackground
+//      This function runs one 'sweep' through those tasks which are not called by the
+//      interrupt service routine.  It works differently in different real-time modes:
+//        - In sequential modes, runs all tasks in order, then increments time.  If
+//          sweeps are run in parallel, the tasks after the timer interrupt tasks are
+//          run by the parallel sweep, with the same results as if they'd run in order.
+//        - In low-latency modes, it runs tasks a few at a time according to priority.
+//        - In interrupt modes, it runs continuous tasks only, because the other tasks
+//          are being called from the interrupt service routine.  
+
+void CProcess::RunBackground (void)
+    {
+    //  In single-thread modes, wake the tasks whose states' timeouts have ended first
+    #if defined (TR_THREAD_SINGLE)
+        Timeouts->FireDue (GetTimeNowUnprotected ());
+    #endif
+
+    //  If in single-thread, sequential simulation mode: just run all tasks in order 
+    #if defined (TR_EXEC_SEQ) && defined (TR_THREAD_SINGLE)
+        TimerIntTasks->RunAll ();
+        if (Sweep != NULL)
+            Sweep->Run ();
+        else
+            {
+            PreemptibleTasks->RunAll ();
+            BackgroundTasks->RunAll ();
+            ContinuousTasks->RunAll ();
+            }
+    #endif
+
+    //  If in single-thread, minimum-latency mode: run all timer tasks, then run one
+    //  preemptible task which is ready to go.  If no preemptible task ran, run the
+    //  next available background or continuous task
+    #if defined (TR_EXEC_MIN) && defined (TR_THREAD_SINGLE)
+        TimerIntTasks->RunAll ();
+        if (PreemptibleTasks->RunOne () == FALSE)
+            {
+            if (BackgroundTasks->RunOne () == FALSE)
+                ContinuousTasks->RunOne ();
+            }
+    #endif
+
+    //  Multithreading:  Interrupts run timer-int and preemptible tasks only.  In the
+    //  background, run one pre-emptible background task, or if none is ready to go,
+    //  run a continuous task 
+    #if defined (TR_THREAD_MULTI)
+        if (BackgroundTasks->RunOne () == FALSE)
+            ContinuousTasks->RunOne ();
+    #endif
+
+    //  Externally controlled simulation runs one of the single-thread sweeps above;
+    //  RunWindow() calls this function and advances the process's own clock.  (It
+    //  can't be used with multithreading; TR4_comp.hpp checks for that)
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  GetShortestPeriod
+//      This function returns the shortest sample time of any timer interrupt,
+//      preemptible, or sample time task in the process.  If there are no such tasks,
+//      it returns a very large number.  In parallel simulation mode, the master uses
+//      this as the lookahead:  a task can't react to anything another process sends
+//      it any sooner than its next sample time.
+
+real_time CProcess::GetShortestPeriod (void)
+    {
+    real_time Shortest = (real_time)9E99;
+
+    Shortest = TimerIntTasks->GetShortestPeriod (Shortest);
+    Shortest = PreemptibleTasks->GetShortestPeriod (Shortest);
+    Shortest = BackgroundTasks->GetShortestPeriod (Shortest);
+
+    return (Shortest);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  GetNextRunTime
+//      This function returns the earliest time at which any task in the process could
+//      run its function without being triggered by another task (see the function
+//      of the same name in CTask).  In minimum-latency mode the continuous task list
+//      is scanned one task per sweep in rotation, so if there are continuous tasks
+//      at all, even asleep ones, we say they're ready:  skipping sweeps would change
+//      where the rotation stands.
+
+real_time CProcess::GetNextRunTime (void)
+    {
+    real_time Earliest = (real_time)9E99;
+
+    #if defined (TR_EXEC_MIN)
+        if (ContinuousTasks->HowMany () > 0)
+            return ((real_time)0.0);
+    #endif
+
+    Earliest = ContinuousTasks->GetNextRunTime (Earliest);
+    Earliest = TimerIntTasks->GetNextRunTime (Earliest);
+    Earliest = PreemptibleTasks->GetNextRunTime (Earliest);
+    Earliest = BackgroundTasks->GetNextRunTime (Earliest);
+    if (Timeouts->GetNextDue () < Earliest)
+        Earliest = Timeouts->GetNextDue ();
+
+    return (Earliest);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  UseTime
+//      In simulation mode, a task calls this function (through CTask::UseTime()) when
+//      it's to be busy for some simulated time.  The clock is moved ahead to the end
+//      of that time.  Meanwhile, if a task which could preempt the busy one comes
+//      due, the clock is moved to that time and the task is run then; the busy task
+//      finishes later by as long as the preempting task took.  Timer interrupt tasks
+//      preempt any other kind of task, and preemptible tasks preempt lower priority
+//      preemptible tasks and any background task, just as they would on the target.
+
+#if defined (TR_TIME_SIM)
+void CProcess::UseTime (CTask* aTask, real_time aTime)
+    {
+    real_time StartTime;                    //  Time when the task began to be busy
+    real_time EndTime;                      //  Time when it'll be finished
+    real_time DueTime;                      //  Time a preempting task comes due
+    real_time Before;                       //  Clock before preempting task runs
+    int Above;                              //  Preempting preemptible tasks must
+                                            //    have a priority above this
+    CTask* pNext;                           //  Next task to preempt the busy one
+
+
+    StartTime = GetTimeNowUnprotected ();
+    EndTime = StartTime + aTime;
+    Above = (aTask->GetType () == PREEMPTIBLE) ? aTask->GetPriority () : INT_MIN;
+
+    //  Nothing preempts a timer interrupt task
+    while (aTask->GetType () != TIMER_INT)
+        {
+        pNext = TimerIntTasks->FindPreemptor (INT_MIN, StartTime, NULL);
+        pNext = PreemptibleTasks->FindPreemptor (Above, StartTime, pNext);
+        if ((pNext == NULL) || ((DueTime = pNext->GetNextRunTime ()) >= EndTime))
+            break;
+
+        if (DueTime > GetTimeNowUnprotected ())
+            TheTimer->AdvanceTo (DueTime);
+        Before = GetTimeNowUnprotected ();
+        pNext->Schedule ();
+        EndTime += GetTimeNowUnprotected () - Before;
+
+        //  If the task didn't run after all (because the scheduler is stopping, say)
+        //  it would be found again and again, so give up preempting
+        if (pNext->GetNextRunTime () == DueTime)
+            break;
+        }
+
+    if (EndTime > GetTimeNowUnprotected ())
+        TheTimer->AdvanceTo (EndTime);
+    }
+#endif
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  RunWindow
+//      In parallel simulation mode, the master has each process call this function in
+//      its own thread to run the sweeps in one time window.  The process's clock
+//      advances by one tick after each sweep.  The clock is computed from the count
+//      of sweeps rather than by adding up ticks, so each process's clock reads
+//      exactly the same as the others' at the end of a window.
+
+#if defined (TR_TIME_EXTSIM)
+void CProcess::RunWindow (long aSweeps)
+    {
+    pRunningProcess = this;
+
+    for (long Count = 0L; Count < aSweeps; Count++)
+        {
+        RunBackground ();
+
+        SweepCount++;
+        LocalTime = (real_time)SweepCount * TheTimer->GetDeltaTime ();
+        }
+
+    pRunningProcess = NULL;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  SaveTraceLine
+//      TL_TraceLine() calls this function in parallel simulation mode to save a trace
+//      line in the process's own buffer, as the master's trace logger is shared by
+//      all the threads.  The buffer grows as needed; it's emptied after each window.
+
+void CProcess::SaveTraceLine (void* aTask, void* aFrom, void* aTo, long aFromNum,
+                              long aToNum)
+    {
+    //  If the buffer is full, make a new one twice as big and copy the lines over
+    if (TraceCount >= TraceSize)
+        {
+        int NewSize = (TraceSize == 0) ? 64 : (TraceSize * 2);
+        TR_TraceRecord* pNew = new TR_TraceRecord[NewSize];
+
+        if (pNew == NULL)
+            {
+            TR_Exit ("Unable to allocate trace buffer for process \"%s\"", Name);
+            return;
+            }
+        for (int Line = 0; Line < TraceCount; Line++)
+            pNew[Line] = WindowTrace[Line];
+        if (WindowTrace != NULL)
+            DELETE_ARRAY WindowTrace;
+        WindowTrace = pNew;
+        TraceSize = NewSize;
+        }
+
+    WindowTrace[TraceCount].Time = LocalTime;
+    WindowTrace[TraceCount].pTask = aTask;
+    WindowTrace[TraceCount].pFromState = aFrom;
+    WindowTrace[TraceCount].pToState = aTo;
+    WindowTrace[TraceCount].FromState = aFromNum;
+    WindowTrace[TraceCount].ToState = aToNum;
+    TraceCount++;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  GetRunningProcess
+//      This function returns a pointer to the process which is running a time window
+//      in the calling thread, or NULL if no process is (as in the master's thread).
+
+CProcess* GetRunningProcess (void)
+    {
+    return (pRunningProcess);
+    }
+#endif  //  TR_TIME_EXTSIM
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  RunForeground
+//      This function runs the foreground tasks, i.e. those which are called by the 
+//      interrupt service routine.  In multithreading mode, this means that it first
+//      wakes the tasks whose states' timeouts have ended, then gives all the timer
+//      interrupt tasks a call, and they run if their sample time has come; then it
+//      runs the highest priority preemptible task.
+
+void CProcess::RunForeground (void)
+    {
+    //  Multithreading:  Interrupts run timer interrupt and preemptible tasks
+    #if defined (TR_THREAD_MULTI)
+        Timeouts->FireDue (GetTimeNowUnprotected ());
+        TimerIntTasks->RunAll ();       //  This calls all timer interrupt tasks
+        PreemptibleTasks->RunAll ();    //  This runs high priority preemptible tasks
+    #endif
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Functions:  AddTask (versions for each task type)
+//      This function creates a new task of the type specified by the user and calls
+//      InsertTask() to put it into the process's task list.  Several overloaded ver-
+//      sions of this method are given because the functions which create different
+//      types of tasks (timer interrupt, continuous, etc.) take different numbers
+//      and types of parameters.  The CTL_EXEC version of this program does not permit 
+//      adding tasks in this manner because there are no state objects to run in them.
+
+//  This version creates a continuous task and takes no timing parameters
+CTask *CProcess::AddTask (const char *aName, TaskType aType)
+    {
+    CTask *pNewTask;                            //  Pointer to the task we create here
+
+    pNewTask = new CTask (aName, aType);            //  Create the task object
+    ContinuousTasks->Insert (pNewTask);             //  Insert it in the task list
+    pNewTask->SetSerialNumber (TaskSerialNumber++); //  Give the task a serial number
+    pNewTask->pProcess = this;                      //  and tell it where it belongs
+    if (Sweep != NULL)  Sweep->Invalidate ();       //  Parallel sweep plans again
+    return (pNewTask);                              //  Return a pointer to it
+    }
+
+//  This one is for a timer-interrupt task which takes a time but no priority
+CTask *CProcess::AddTask (const char *aName, TaskType aType, real_time aTime)
+    {
+    CTask *pNewTask;
+
+    pNewTask = new CTask (aName, aType, aTime);
+    TimerIntTasks->Insert (pNewTask);
+    pNewTask->SetSerialNumber (TaskSerialNumber++);
+    pNewTask->pProcess = this;
+    if (Sweep != NULL)  Sweep->Invalidate ();
+    return (pNewTask);
+    }
+
+//  This version is for an event task which takes a proirity but no timing information
+CTask *CProcess::AddTask (const char *aName, TaskType aType, int aPriority)
+    {
+    CTask *pNewTask;
+
+    pNewTask = new CTask (aName, aType, aPriority);
+    BackgroundTasks->Insert (pNewTask);
+    pNewTask->SetSerialNumber (TaskSerialNumber++);
+    pNewTask->pProcess = this;
+    if (Sweep != NULL)  Sweep->Invalidate ();
+    return (pNewTask);
+    }
+
+//  This method creates and inserts a sample time task which needs timing and priority
+CTask *CProcess::AddTask (const char *aName, TaskType aType, int aPriority,
+                          real_time aTime)
+    {
+    CTask *pNewTask;
+
+    pNewTask = new CTask (aName, aType, aPriority, aTime);
+    if (aType == PREEMPTIBLE)  PreemptibleTasks->Insert (pNewTask);
+    if (aType == SAMPLE_TIME)  BackgroundTasks->Insert (pNewTask);
+    pNewTask->SetSerialNumber (TaskSerialNumber++);
+    pNewTask->pProcess = this;
+    if (Sweep != NULL)  Sweep->Invalidate ();
+    return (pNewTask);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  InsertTask (versions which take a task pointer or a task reference)
+//      These functions insert the given task into the appropriate task list.  The task
+//      object must already have been instantiated.  These functions are usually used
+//      to insert custom task objects of a type descended from CTask into a task list.
+
+CTask *CProcess::InsertTask (CTask* pTask)
+    {
+    switch (pTask->TheType)
+        {
+        case (TIMER_INT):
+            TimerIntTasks->Insert (pTask);
+            break;
+        case (PREEMPTIBLE):
+            PreemptibleTasks->Insert (pTask);
+            break;
+        case (SAMPLE_TIME):
+        case (EVENT):
+            BackgroundTasks->Insert (pTask);
+            break;
+        case (CONTINUOUS):
+            ContinuousTasks->Insert (pTask);
+            break;
+        default:
+            TR_Exit ("Attempt to insert task \"%s\" of unknown type into process",
+                     pTask->GetName ());
+        }
+
+    //  This line gives the task a uniqu serial number
+    pTask->SetSerialNumber (TaskSerialNumber++);
+    pTask->pProcess = this;
+
+    //  A parallel sweep has to fit the new task into its plan
+    if (Sweep != NULL)
+        Sweep->Invalidate ();
+
+    return (pTask);
+    }
+
+
+CTask *CProcess::InsertTask (CTask& aTask)
+    {
+    return (InsertTask (&aTask));
+    }
+
+
+
+//=====================================================================================
+//  Class: CTaskList
+//      This class contains the common items among linked lists intended for storing 
+//      all kinds of CTask objects (i.e. it has common code from the task lists below).
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+//  Constructor: CTimerIntTaskList
+//      This constructor is just the default sort.
+
+CTaskList::CTaskList (void) : CBasicList ()
+    {
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Destructor: ~CTaskList
+//      This destructor zaps all the tasks in the list.  These tasks actually have
+//      virtual destructors, so the user's tasks' destructors get called.
+
+CTaskList::~CTaskList (void)
+    {
+    for (CTask* pCur = (CTask*)GetHead (); pCur != NULL; pCur = (CTask*)GetNext ())
+        delete pCur;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: RunAll
+//      This function passes on a [run] message which it has received from the main 
+//      scheduler object.  Each of the tasks in the list is given the message to "go
+//      run yourself."  
+
+boolean CTaskList::RunAll (void)
+    {
+    CTask* pCurTask;                    //  Pointer to the task currently being run
+
+
+    //  Send a run message to each task in the list, in sequence
+    pCurTask = (CTask*) GetHead ();
+    while (pCurTask != NULL)
+        {
+        pCurTask->Schedule ();
+        pCurTask = (CTask*) GetNext ();
+        }
+
+    return (TRUE);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: RunOne
+//      This function acts on a run message from the main scheduler by sending just 
+//      one task in the list a run-yourself message.  RunOne messages are sequenced 
+//      through the list.  
+
+boolean CTaskList::RunOne (void)
+    {
+    CTask* pCurTask;                        //  Pointer to the task currently being run
+
+
+    pCurTask = (CTask*) GetNext ();         //  See if there's a next task available
+
+    if (pCurTask == NULL)                   //  If we were at end of task list, wrap
+        pCurTask = (CTask*) GetHead ();     //  back around to the beginning
+
+    if (pCurTask != NULL)
+        pCurTask->Schedule ();              //  Now run the task (if there is one) 
+
+    return (TRUE);                          //  If we get here, no task has run 
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: GetNextRunTime
+//      This function looks through the list for the earliest time at which any of
+//      its tasks could run, and returns it or the time given if that one is earlier.
+
+real_time CTaskList::GetNextRunTime (real_time aEarliest)
+    {
+    CTask *pCur;
+
+    //  Once some task is found to be ready right now, there's no use looking further
+    for (pCur = (CTask *)GetHead (); (pCur != NULL) && (aEarliest > (real_time)0.0);
+         pCur = (CTask *)GetNext ())
+        {
+        if (pCur->GetNextRunTime () < aEarliest)
+            aEarliest = pCur->GetNextRunTime ();
+        }
+    return (aEarliest);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Insert 
+//      This function inserts the task which is pointed to by its argument into the 
+//      list of timer interrupt tasks.  
+
+CTask *CTaskList::Insert (CTask* pNew)
+    {
+    //  Call function to insert this task into the list; tell it its parent's address 
+    CBasicList::Insert ((void*)pNew, pNew->GetPriority ());
+
+    return (pNew);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: FindPreemptor
+//      This function looks through the list for the task which will come due first
+//      at or after the given time, among those with a priority above the one given.
+//      If the task given as the best so far is due sooner, it's returned instead.
+
+CTask* CTaskList::FindPreemptor (int aAbove, real_time aFrom, CTask* aBest)
+    {
+    CTask *pCur;
+
+    for (pCur = (CTask *)GetHead (); pCur != NULL; pCur = (CTask *)GetNext ())
+        {
+        if ((pCur->GetPriority () > aAbove) && (pCur->GetNextRunTime () >= aFrom)
+            && ((aBest == NULL)
+                || (pCur->GetNextRunTime () < aBest->GetNextRunTime ())))
+            aBest = pCur;
+        }
+    return (aBest);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: GetShortestPeriod
+//      This function looks through the list for tasks which run at a sample time and
+//      returns the shortest sample time, or the time given if that one is shorter.
+
+real_time CTaskList::GetShortestPeriod (real_time aShortest)
+    {
+    CTask *pCur;
+
+    for (pCur = (CTask *)GetHead (); pCur != NULL; pCur = (CTask *)GetNext ())
+        {
+        if ((pCur->GetSampleTime () > (real_time)0.0)
+            && (pCur->GetSampleTime () < aShortest))
+            aShortest = pCur->GetSampleTime ();
+        }
+    return (aShortest);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: DumpConfiguration
+//      This function writes a configuration dump to the stream given in its argument.
+//      It does so by calling the DumpStatus() methods for tasks in the list.
+
+void CTaskList::DumpConfiguration (FILE* aFile)
+    {
+    CTask *pCur;                            //  Pointer to the task currently dumping
+
+    for (pCur = (CTask *)GetHead (); pCur != NULL; pCur = (CTask *)GetNext ())
+        pCur->DumpConfiguration (aFile);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: DumpStatus
+//      This function writes a task list status dump to the stream given in its argu-
+//      ment.  It does so by calling the DumpStatus() methods for tasks in the list.
+
+void CTaskList::DumpStatus (FILE* aFile)
+    {
+    CTask *pCur;                            //  Pointer to the task currently dumping
+
+    for (pCur = (CTask*)GetHead (); pCur != NULL; pCur = (CTask *)GetNext ())
+        pCur->DumpStatus (aFile);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Functions:  ProfileOn and ProfileOff
+//      These functions activate and deactivate execution-time profiling for all
+//      tasks in the list. 
+
+void CTaskList::ProfileOn (void)
+    {
+    CTask *pCur;
+    for (pCur = (CTask*)GetHead (); pCur != NULL; pCur = (CTask *)GetNext ())
+        pCur->ProfileOn ();
+    }
+
+void CTaskList::ProfileOff (void)
+    {
+    CTask *pCur;
+    for (pCur = (CTask*)GetHead (); pCur != NULL; pCur = (CTask *)GetNext ())
+        pCur->ProfileOff ();
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Functions:  CalibrateOn, CalibrateOff, and CalibratedLoad
+//      These functions pass calibration messages on to all the tasks in the list.
+
+void CTaskList::CalibrateOn (void)
+    {
+    CTask *pCur;
+    for (pCur = (CTask*)GetHead (); pCur != NULL; pCur = (CTask *)GetNext ())
+        pCur->CalibrateOn ();
+    }
+
+void CTaskList::CalibrateOff (void)
+    {
+    CTask *pCur;
+    for (pCur = (CTask*)GetHead (); pCur != NULL; pCur = (CTask *)GetNext ())
+        pCur->CalibrateOff ();
+    }
+
+real_time CTaskList::CalibratedLoad (real_time aTime, double aSlowdown)
+    {
+    CTask *pCur;
+    real_time Load = (real_time)0.0;        //  Sum of all the tasks' shares
+
+    for (pCur = (CTask*)GetHead (); pCur != NULL; pCur = (CTask *)GetNext ())
+        Load += pCur->CalibratedLoad (aTime, aSlowdown);
+
+    return (Load);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Checkpoint
+//      This function saves or restores each task in the list.  The number of tasks is
+//      saved first, so a list with a different number of tasks is caught at once.
+
+void CTaskList::Checkpoint (CCheckpoint* aCheckpoint)
+    {
+    CTask *pCur;
+
+    aCheckpoint->Count (HowMany (), "tasks");
+    for (pCur = (CTask*)GetHead (); pCur != NULL; pCur = (CTask *)GetNext ())
+        pCur->Checkpoint (aCheckpoint);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: FindTask
+//      Return a pointer to the task in this list which has the given serial number,
+//      or NULL if it isn't in this list.
+
+CTask* CTaskList::FindTask (int aNumber)
+    {
+    CTask *pCur;
+
+    for (pCur = (CTask*)GetHead (); pCur != NULL; pCur = (CTask *)GetNext ())
+        if (pCur->GetSerialNumber () == aNumber)
+            return (pCur);
+
+    return (NULL);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: DumpTimingInfo
+//      This function writes information about how long task functions take to run
+//      to the stream given in its argument.  It does so by calling DumpProfile()
+//      methods for tasks in the list.
+
+void CTaskList::DumpProfiles (FILE* aFile)
+    {
+    CTask *pCur;                            //  Pointer to the task currently dumping
+
+    for (pCur = (CTask*)GetHead (); pCur != NULL; pCur = (CTask *)GetNext ())
+        pCur->DumpProfile (aFile);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: DumpStatistics
+//      This function has each task in the list write how long it stayed in its states
+//      and how often it went from one state to another.
+
+void CTaskList::DumpStatistics (FILE* aFile)
+    {
+    CTask *pCur;                            //  Pointer to the task currently dumping
+
+    for (pCur = (CTask*)GetHead (); pCur != NULL; pCur = (CTask *)GetNext ())
+        pCur->DumpStatistics (aFile);
+    }
+
+
+//=====================================================================================
+//  Class: CTimerIntTaskList
+//      This class implements a type of linked list intended for storing CTask objects 
+//      which represent timer interrupt tasks.  
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+//  Constructor: CTimerIntTaskList
+//      This constructor is just the default sort.  
+
+CTimerIntTaskList::CTimerIntTaskList (void)
+    {
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Destructor: ~CTimerIntTaskList
+//      This destructor frees the memory which has been taken up by all the task 
+//      objects in the task list.   
+
+CTimerIntTaskList::~CTimerIntTaskList (void)
+    {
+    this->CTaskList::~CTaskList ();
+    }
+
+
+
+//-------------------------------------------------------------------------------------
+//  Function: RunAll
+//      This function passes on a [run] message which it has received from the main 
+//      scheduler object.  Each of the tasks in the list is given the message to "go
+//      run yourself."
+//  Changes
+//       8-17-95  JR   Each task is run repeatedly until it idles itself
+//       9-02-95  JR   GetObjWith() added in case list is changed during re-entrance
+//                     of this task if we were interrupted during pCurTask->Schedule()
+
+boolean CTimerIntTaskList::RunAll (void)
+    {
+    CTask *pCurTask;                    //  Pointer to the task currently being run
+    TaskStatus RetStatus;               //  Status returned by a task which ran
+
+    //  Send a run message to each task in the list, in sequence.  Each task will get
+    //  as many scans as it needs, i.e. we run it until it idles itself
+    pCurTask = (CTask *) GetHead ();
+    while (pCurTask != NULL)
+        {
+        //  Call the task's Schedule() method, which runs the Entry() and/or Action()
+        //  functions, repeatedly until the task becomes idle or deactivated
+        do
+            {
+            //  Run the task by calling the task's Schedule() method
+            RetStatus = pCurTask->Schedule ();
+            pCurTask->GetSampleTime ();
+
+            //  If this task interrupted itself, it's too slow so complain and exit
+            if (RetStatus == TS_RUNNING)
+                {
+                TR_Exit ("Timer interrupt task \"%s\" has interrupted itself",
+                         pCurTask->GetName ());
+                return (FALSE);
+                }
+            }
+        while ((RetStatus != TS_IDLE) && (RetStatus != TS_DEACTIVATED));
+
+        GetObjWith (pCurTask);
+        pCurTask = (CTask *) GetNext ();
+        }
+
+    return (TRUE);
+    }
+
+
+//=====================================================================================
+//  Class: CPreemptiveTaskList
+//      This class implements a type of linked list intended for storing CTask objects 
+//      which represent timer interrupt tasks.  
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+//  Constructor: CTimerIntTaskList
+//      This is just a default constructor.  
+
+CPreemptiveTaskList::CPreemptiveTaskList (void) 
+    {
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Destructor: ~CPreemptiveTaskList
+//      This destructor frees the memory which has been taken up by all the task 
+//      objects in the task list.   
+
+CPreemptiveTaskList::~CPreemptiveTaskList (void)
+    {
+    this->CTaskList::~CTaskList ();
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: RunAll
+//      This function acts on a Run message from the process scheduler.  It runs all
+//      the tasks which are ready to run, beginning with the highest priority one and
+//      working down to the bottom - unless it encounters a task which is already
+//      running, in which case it quits and returns control to the thread in which
+//      that already running task is running.
+//  Changes
+//       9-02-95  JR   GetObjWith() added in case list is changed during re-entrance
+//                     of this task if we were interrupted during pCurTask->Schedule()
+
+boolean CPreemptiveTaskList::RunAll (void)
+    {
+    CTask *pCurTask;                        //  Pointer to the task currently being run
+    TaskStatus RetStatus;                   //  Status returned by a task which ran 
+
+
+    //  Begin with the first task in the list; it has the highest priority.  Run it.  
+    //  If this task is already running or has been preempted, exit; otherwise, after 
+    //  this task is done go on to the next task which might need a chance to run too 
+    pCurTask = (CTask*) GetHead ();
+    while (pCurTask != NULL)
+        {
+        RetStatus = pCurTask->Schedule ();
+        if ((RetStatus == TS_RUNNING) || (RetStatus == TS_PREEMPTED))
+            break;
+        GetObjWith (pCurTask);
+        pCurTask = (CTask *) GetNext ();
+        }
+
+    return (TRUE);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: RunOne
+//      This function runs the highest priority ready-to-go task at any given time, if
+//      there actually is a task ready to run.  It returns FALSE if no task was found 
+//      which was ready to run and TRUE if a task did run.
+
+boolean CPreemptiveTaskList::RunOne (void)
+    {
+    CTask *pCurTask;                        //  Pointer to the task currently being run
+    TaskStatus RetStatus;                   //  Status returned by a task which ran 
+
+
+    //  Begin with the first task in the list; it has the highest priority.  Send a 
+    //  Schedule message to each task until one of them actually runs 
+    pCurTask = (CTask*) GetHead ();
+    while (pCurTask != NULL)
+        {
+        RetStatus = pCurTask->Schedule ();
+        if (RetStatus == TS_READY)          //  The TS_READY return tells us the task
+            return (TRUE);                  //  ran; another code means it didn't 
+        pCurTask = (CTask *) GetNext ();
+        }
+
+    return (FALSE);                         //  If we get here, no task function ran 
+    }
+
+
+//=====================================================================================
+//  Class: CContinuousTaskList
+//      This class implements a type of linked list intended for storing CTask objects 
+//      which represent timer interrupt tasks.  
+//      The CTaskList class is also designed to pass messages to the tasks in a list,
+//      for example a [run] message telling the tasks to run their action functions.  
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+//  Constructor: CTimerIntTaskList
+//      Well, as one can see, this doesn't do much in the current incarnation.
+
+CContinuousTaskList::CContinuousTaskList ()
+    {
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Destructor: ~CContinuousTaskList
+//      This destructor frees the memory which has been taken up by all the task
+//      objects in the task list.
+
+CContinuousTaskList::~CContinuousTaskList (void)
+    {
+    this->CTaskList::~CTaskList ();
+    }
+
+
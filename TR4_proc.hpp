@@ -1,157 +1,237 @@
-//*************************************************************************************
-//  TR4_PROC.HPP
-//      Header file for the process class which is used in the TranRun4 scheduler.
-//
-//  Copyright (c) 1994-1997 D.M.Auslander and J.R.Ridgely
-//      May be used and distributed for any non-commercial purposes as long as this
-//      copyright notice is included.
-//
-//  Version
-//       1-30-95  JR   Original version
-//       5-20-95  JR   File changed to TranRun3 name
-//       7-30-95  JR   DumpStatus and DumpConfiguration given file names as arguments
-//      12-21-96  JR   File changed to TranRun4 version
-//*************************************************************************************
-
-#ifndef TR4_PROC_HPP                        //  Variable to prevent multiple inclusions
-    #define  TR4_PROC_HPP
-
-//  We need forward declarations of the task lists so process can hold them
-class CTaskList;
-class CTimerIntTaskList;
-class CPreemptiveTaskList;
-class CContinuousTaskList;
-
-
-//=====================================================================================
-//  Class: CProcess
-//      This is the object which runs a process.  Here we define a process as one 
-//      set of tasks which are intended to run on one computer.  However, for purposes
-//      of program development, more than one process may share a computer in some 
-//      simulation modes.  The user's program creates this process object.  The master 
-//      scheduler passes it messages to schedule and run the tasks in the process.  
-//=====================================================================================
-
-class CProcess
-    {
-    private:
-        char *Name;                             //  Name of this process
-        CTimerIntTaskList *TimerIntTasks;       //  Unitary interrupt tasks
-        CPreemptiveTaskList *PreemptibleTasks;  //  Pre-emptible interrupt tasks
-        CPreemptiveTaskList *BackgroundTasks;   //  Sample time and digital event tasks
-        CContinuousTaskList *ContinuousTasks;   //  List of continuous tasks
-        int TaskSerialNumber;                   //  Gives tasks in list their numbers
-
-    public:
-        CProcess (void) { }                     //  Default constructor - don't use it
-        CProcess (const char*);                 //  Constructor which we use sets name
-        ~CProcess (void);                       //  Virtual destructor called by list
-
-        void DumpStatus (const char*);          //  Dump status of all tasks
-        void DumpConfiguration (const char*);   //  Dump task configuration information
-        void ProfileOn (void);                  //  Turn profiling on for all tasks
-        void ProfileOff (void);                 //  Turn all tasks' profiling back off
-        void DumpProfiles (const char*);        //  Dump info about how fast tasks ran
-        void DumpProfiles (FILE*);              //  Same function as called by CMaster
-        void RunBackground (void);              //  Run one sweep through task lists
-        void RunForeground (void);              //  Run a sweep through ISR driven list
-        const char *GetName (void)              //  Function returns pointer to name
-            { return (Name); }                  //    of process in a character string
-
-        //  The AddTask() methods create a new task object and add it into the task
-        //  list for this process, returning a pointer to the newly created task.
-        //  InsertTask() is called to put an already-created task into the task list.
-        //  State objects are used with TranRun3, but not with CTL_EXEC
-        CTask *AddTask (const char*, TaskType);
-        CTask *AddTask (const char*, TaskType, int);
-        CTask *AddTask (const char*, TaskType, real_time);
-        CTask *AddTask (const char*, TaskType, int, real_time);
-
-        CTask *InsertTask (CTask*);
-        CTask *InsertTask (CTask&);
-    };
-
-
-//=====================================================================================
-//  Class: CTaskList
-//      This class contains the common items among linked lists intended for storing
-//      all kinds of CTask objects (i.e. it has common code from the task lists below).
-//=====================================================================================
-
-class CTaskList : public CBasicList
-    {
-    public:
-        CTaskList (void);                   //  Constructor does nearly nothing
-        ~CTaskList (void);
-
-        boolean RunAll (void);              //  Run all the tasks in sequence
-        boolean RunOne (void);              //  Run one task at a time
-        void DumpStatus (FILE*);            //  Print status dump of all tasks
-        void DumpConfiguration (FILE*);     //  Print status dump of all tasks
-        void ProfileOn (void);              //  Turn execution time on or off for 
-        void ProfileOff (void);             //    all tasks in the task list
-        void DumpProfiles (FILE*);          //  Print a dump of timing information
-        CTask *Insert (CTask*);             //  Insert task at end of list
-    };
-
-
-//=====================================================================================
-//  Class: CTimerIntTaskList
-//      This class implements a type of linked list intended for storing CTask objects
-//      which represent continuous tasks.  The CTimerIntTaskList class is also
-//      designed to pass messages to the tasks in a list, for example a [run] message
-//      telling the tasks to run their action functions if they find it's time to.  
-//=====================================================================================
-
-class CTimerIntTaskList : public CTaskList 
-    {
-    public:
-        CTimerIntTaskList (void);                       //  Constructor does nothing
-        ~CTimerIntTaskList (void);
-
-        boolean CTimerIntTaskList::RunAll (void);       //  Runs all the tasks
-    };
-
-
-//=====================================================================================
-//  Class: CPreemptiveTaskList
-//      This class implements a list of pre-emptive tasks, that is sample time, event,
-//      or preemptible interrupt-driven tasks.  The list is kept sorted by priority
-//      and the [run] message causes preemptive scheduling to occur if we're in a
-//      preemptive scheduling mode.
-//=====================================================================================
-
-class CPreemptiveTaskList : public CTaskList
-    {
-    public:
-        CPreemptiveTaskList (void);         //  Default do-nothing contstructor 
-        ~CPreemptiveTaskList (void);
-
-        boolean RunAll (void);              //  Run all ready tasks in priority order 
-        boolean RunOne (void);              //  Run highest priority task that's ready 
-    };
-
-
-//=====================================================================================
-//  Class: CContinuousTaskList
-//      This class implements a type of linked list intended for storing CTask objects
-//      which represent continuous tasks.  The CContTaskList class can also pass mes-
-//      sages such as a [run] message to the tasks in its list.
-//=====================================================================================
-
-class CContinuousTaskList : public CTaskList
-    {
-    public:
-        CContinuousTaskList (void);         //  Constructor does nothing
-        ~CContinuousTaskList (void);
-    };
-
-
-//-------------------------------------------------------------------------------------
-//  Global Main Process Pointer
-//      It is expected that every project will have one "main" process, so for conven-
-//      ience we declare an external pointer to it here; it's created in TranRun4.cpp
-extern CProcess* MainProcess;
-
-#endif
-
+//*************************************************************************************
+//  TR4_PROC.HPP
+//      Header file for the process class which is used in the TranRun4 scheduler.
+//
+//  Copyright (c) 1994-1997 D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//
+//  Version
+//       1-30-95  JR   Original version
+//       5-20-95  JR   File changed to TranRun3 name
+//       7-30-95  JR   DumpStatus and DumpConfiguration given file names as arguments
+//      12-21-96  JR   File changed to TranRun4 version
+//*************************************************************************************
+
+#ifndef TR4_PROC_HPP                        //  Variable to prevent multiple inclusions
+    #define  TR4_PROC_HPP
+
+//  We need forward declarations of the task lists so process can hold them
+class CTaskList;
+class CTimerIntTaskList;
+class CPreemptiveTaskList;
+class CContinuousTaskList;
+class CParallelSweep;
+
+//  In parallel simulation mode, each process saves the transition-logic trace lines
+//  it makes during one time window in its own buffer.  The master merges all the
+//  buffers into the trace logger, in time order, at the end of each window.  The
+//  threads which run a parallel sweep (see TR4_pswp.hpp) save their lines likewise
+struct TR_TraceRecord
+    {
+    real_time Time;                         //  Time at which the transition occurred
+    void* pTask;                            //  Task in which it occurred
+    void* pFromState;                       //  State objects, for state-based tasks,
+    void* pToState;                         //    or NULL
+    long FromState;                         //  State numbers, for task-based tasks,
+    long ToState;                           //    or -1
+    };
+
+
+//=====================================================================================
+//  Class: CProcess
+//      This is the object which runs a process.  Here we define a process as one 
+//      set of tasks which are intended to run on one computer.  However, for purposes
+//      of program development, more than one process may share a computer in some 
+//      simulation modes.  The user's program creates this process object.  The master 
+//      scheduler passes it messages to schedule and run the tasks in the process.  
+//=====================================================================================
+
+class CProcess
+    {
+    private:
+        char *Name;                             //  Name of this process
+        CTimerIntTaskList *TimerIntTasks;       //  Unitary interrupt tasks
+        CPreemptiveTaskList *PreemptibleTasks;  //  Pre-emptible interrupt tasks
+        CPreemptiveTaskList *BackgroundTasks;   //  Sample time and digital event tasks
+        CContinuousTaskList *ContinuousTasks;   //  List of continuous tasks
+        int TaskSerialNumber;                   //  Gives tasks in list their numbers
+        CTimeoutQueue* Timeouts;                //  States' timeouts, earliest first
+        CParallelSweep* Sweep;                  //  Runs sweeps in threads, or NULL
+        #if defined (TR_TIME_EXTSIM)
+            real_time LocalTime;                //  This process's own simulated clock
+            long SweepCount;                    //  Number of sweeps run so far
+            TR_TraceRecord* WindowTrace;        //  Trace lines made in this window
+            int TraceCount;                     //  Number of lines in WindowTrace
+            int TraceSize;                      //  Number of lines there's room for
+        #endif
+
+    public:
+        CProcess (void) { }                     //  Default constructor - don't use it
+        CProcess (const char*);                 //  Constructor which we use sets name
+        ~CProcess (void);                       //  Virtual destructor called by list
+
+        void DumpStatus (const char*);          //  Dump status of all tasks
+        void DumpConfiguration (const char*);   //  Dump task configuration information
+        void ProfileOn (void);                  //  Turn profiling on for all tasks
+        void ProfileOff (void);                 //  Turn all tasks' profiling back off
+        void CalibrateOn (void);                //  Measure processor time used by
+        void CalibrateOff (void);               //    all tasks, or stop measuring
+        real_time CalibratedLoad                //  Share of target processor which
+            (real_time, double);                //    the tasks would use
+        void ParallelOn (int);                  //  Run sweeps in the given number of
+        void ParallelOff (void);                //    threads, or in one thread again
+        void Checkpoint (CCheckpoint*);         //  Save or restore all the tasks
+        CTask* FindTask (int);                  //  Find a task by its serial number
+        void DumpProfiles (const char*);        //  Dump info about how fast tasks ran
+        void DumpProfiles (FILE*);              //  Same function as called by CMaster
+        void RunBackground (void);              //  Run one sweep through task lists
+        void RunForeground (void);              //  Run a sweep through ISR driven list
+        const char *GetName (void)              //  Function returns pointer to name
+            { return (Name); }                  //    of process in a character string
+        real_time GetShortestPeriod (void);     //  Find fastest task's sample time
+        real_time GetNextRunTime (void);        //  Find when a task can next run
+        CTimeoutQueue* GetTimeoutQueue (void)   //  Function returns a pointer to the
+            { return (Timeouts); }              //    queue of states' timeouts
+        CParallelSweep* GetParallelSweep (void) //  Function returns a pointer to the
+            { return (Sweep); }                 //    parallel sweep, or NULL if none
+        #if defined (TR_TIME_SIM)
+            void UseTime (CTask*, real_time);   //  Let a task use up simulated time
+        #endif
+
+        //  These functions are used by the master in parallel simulation mode.  Each
+        //  process runs its sweeps for one time window in its own thread, keeping its
+        //  own clock; then the master collects the trace lines made in that window
+        #if defined (TR_TIME_EXTSIM)
+            void RunWindow (long);              //  Run the given number of sweeps
+            real_time GetLocalTime (void)       //  Function returns the time on this
+                { return (LocalTime); }         //    process's own simulated clock
+            void SaveTraceLine (void*, void*,   //  Save a transition-logic trace line
+                                void*, long, long);
+            int GetTraceCount (void)            //  Returns the number of trace lines
+                { return (TraceCount); }        //    saved during the current window
+            TR_TraceRecord* GetTraceLines (void)    //  Returns a pointer to the
+                { return (WindowTrace); }           //    window's trace lines
+            void ClearTrace (void)              //  The master calls this when it has
+                { TraceCount = 0; }             //    copied the window's trace lines
+        #endif
+
+        //  The AddTask() methods create a new task object and add it into the task
+        //  list for this process, returning a pointer to the newly created task.
+        //  InsertTask() is called to put an already-created task into the task list.
+        //  State objects are used with TranRun3, but not with CTL_EXEC
+        CTask *AddTask (const char*, TaskType);
+        CTask *AddTask (const char*, TaskType, int);
+        CTask *AddTask (const char*, TaskType, real_time);
+        CTask *AddTask (const char*, TaskType, int, real_time);
+
+        CTask *InsertTask (CTask*);
+        CTask *InsertTask (CTask&);
+
+    //  The parallel sweep reads the task lists to plan which thread runs each task
+    friend class CParallelSweep;
+    };
+
+
+//=====================================================================================
+//  Class: CTaskList
+//      This class contains the common items among linked lists intended for storing
+//      all kinds of CTask objects (i.e. it has common code from the task lists below).
+//=====================================================================================
+
+class CTaskList : public CBasicList
+    {
+    public:
+        CTaskList (void);                   //  Constructor does nearly nothing
+        ~CTaskList (void);
+
+        boolean RunAll (void);              //  Run all the tasks in sequence
+        boolean RunOne (void);              //  Run one task at a time
+        void DumpStatus (FILE*);            //  Print status dump of all tasks
+        void DumpConfiguration (FILE*);     //  Print status dump of all tasks
+        void ProfileOn (void);              //  Turn execution time on or off for 
+        void ProfileOff (void);             //    all tasks in the task list
+        void CalibrateOn (void);            //  Measure processor time used by tasks
+        void CalibrateOff (void);           //    in the list, or stop measuring
+        real_time CalibratedLoad            //  Share of target processor which the
+            (real_time, double);            //    tasks in the list would use
+        void Checkpoint (CCheckpoint*);     //  Save or restore all tasks in list
+        CTask* FindTask (int);              //  Find a task by its serial number
+        void DumpProfiles (FILE*);          //  Print a dump of timing information
+        void DumpStatistics (FILE*);        //  Print time in states and transitions
+        CTask *Insert (CTask*);             //  Insert task at end of list
+        real_time GetShortestPeriod         //  Find shortest sample time of tasks in
+            (real_time);                    //    list if it's less than the one given
+        real_time GetNextRunTime            //  Find earliest time a task in the list
+            (real_time);                    //    can run, if before the one given
+        CTask* FindPreemptor (int,          //  Find the first task in the list to
+            real_time, CTask*);             //    come due which could preempt a task
+    };
+
+
+//=====================================================================================
+//  Class: CTimerIntTaskList
+//      This class implements a type of linked list intended for storing CTask objects
+//      which represent continuous tasks.  The CTimerIntTaskList class is also
+//      designed to pass messages to the tasks in a list, for example a [run] message
+//      telling the tasks to run their action functions if they find it's time to.  
+//=====================================================================================
+
+class CTimerIntTaskList : public CTaskList 
+    {
+    public:
+        CTimerIntTaskList (void);                       //  Constructor does nothing
+        ~CTimerIntTaskList (void);
+
+        boolean CTimerIntTaskList::RunAll (void);       //  Runs all the tasks
+    };
+
+
+//=====================================================================================
+//  Class: CPreemptiveTaskList
+//      This class implements a list of pre-emptive tasks, that is sample time, event,
+//      or preemptible interrupt-driven tasks.  The list is kept sorted by priority
+//      and the [run] message causes preemptive scheduling to occur if we're in a
+//      preemptive scheduling mode.
+//=====================================================================================
+
+class CPreemptiveTaskList : public CTaskList
+    {
+    public:
+        CPreemptiveTaskList (void);         //  Default do-nothing contstructor 
+        ~CPreemptiveTaskList (void);
+
+        boolean RunAll (void);              //  Run all ready tasks in priority order 
+        boolean RunOne (void);              //  Run highest priority task that's ready 
+    };
+
+
+//=====================================================================================
+//  Class: CContinuousTaskList
+//      This class implements a type of linked list intended for storing CTask objects
+//      which represent continuous tasks.  The CContTaskList class can also pass mes-
+//      sages such as a [run] message to the tasks in its list.
+//=====================================================================================
+
+class CContinuousTaskList : public CTaskList
+    {
+    public:
+        CContinuousTaskList (void);         //  Constructor does nothing
+        ~CContinuousTaskList (void);
+    };
+
+
+//-------------------------------------------------------------------------------------
+//  Main Process
+//      It is expected that every project will have one "main" process, so for conven-
+//      ience each scheduler context creates one; MainProcess (see TR4_ctxt.hpp) points
+//      to the one belonging to the current context.
+
+//  In parallel simulation mode, this function returns a pointer to the process which
+//  is running in the calling thread, or NULL if it's the master's thread
+#if defined (TR_TIME_EXTSIM)
+    CProcess* GetRunningProcess (void);
+#endif
+
+#endif
+
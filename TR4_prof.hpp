@@ -1,68 +1,127 @@
-//*************************************************************************************
-//  TR4_prof.hpp
-//      This is the header file for the TranLog4 execution-time profiler class used
-//      in TranLog4 programs.  This profiler is a simple tool which measures the
-//      execution times of the user's Run(), Entry(), Action(), and TransitionTest()
-//      functions and keeps some statistical data on them.     
-//
-//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
-//      May be used and distributed for any non-commercial purposes as long as this
-//      copyright notice is included.
-//
-//  Version
-//      12-22-96  JR   Original version.  Idea taken from Howell and Uchanski's ME230
-//                     class project, in which they wrote a nice fancy profiler 
-//*************************************************************************************
-
-#ifndef TR4_PROF_HPP                        //  Protect file from multiple inclusions
-    #define TR4_PROF_HPP
-
-//=====================================================================================
-//  Class: CProfiler
-//      This class implements a run-time profiling object which keeps useful statis-
-//      tical data on the execution times of a user's functions.  It is given data
-//      which is being measured during every run of the given function; it enters the
-//      data into bins and presents a summary at the end of the run.
-//=====================================================================================
-
-class CProfiler
-    {
-    private:
-        long NumberOfRuns;                  //  How many times the function was run
-        real_time SumOfRunTimes;            //  Sum of all run times
-        real_time SumOfSquares;             //  Sum of squares of run times
-        real_time LongestRun;               //  Duration of the very longest run
-        int NumberOfBins;                   //  Number of bins in duration histogram
-        real_time Minimum;                  //  Minimum time on histogram - usually 0
-        real_time Maximum;                  //  Time for maximum bin
-        real_time LinearBinSize;            //  Size of each linearly spaced bin  
-        long* HistogramBins;                //  Pointer to the array of duration bins
-
-    public:
-        //  Constructors for default version and user-sized version
-        CProfiler (void);
-        CProfiler (int, real_time, real_time);
-        ~CProfiler (void);
-
-        void SaveData (real_time);          //  Save one timing data point
-        void ClearData (void);              //  Clear all the bins out
-
-        //  Specify the number of bins and the minimum and maximum times
-        void SetBins (int, real_time, real_time);
-
-        void DumpProfile (FILE*);           //  Write profile for a function to file
-        void DumpHistogram (FILE*);         //  Write a histogram table of times
-        int GetNumberOfBins (void)          //  Ask how many bins there are in the
-            { return NumberOfBins; }        //    histogram array
-        long GetNumberOfRuns (void)         //  Function returns number of times
-            { return NumberOfRuns; }        //    the function has been called
-        real_time GetSumOfRunTimes (void)   //  Function to return total time the
-            { return SumOfRunTimes; }       //    function has been running
-        real_time GetSumOfSquares (void)    //  Function returns sum of squares of
-            { return SumOfSquares; }        //    function execution times
-        real_time GetLongestRun (void)      //  Function returns time of slowest
-            { return LongestRun; }          //    execution of the function
-    };
-
-#endif                                      //  End of multiple inclusion protection
-
+//*************************************************************************************
+//  TR4_prof.hpp
+//      This is the header file for the TranLog4 execution-time profiler class used
+//      in TranLog4 programs.  This profiler is a simple tool which measures the
+//      execution times of the user's Run(), Entry(), Action(), and TransitionTest()
+//      functions and keeps some statistical data on them.     
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//
+//  Version
+//      12-22-96  JR   Original version.  Idea taken from Howell and Uchanski's ME230
+//                     class project, in which they wrote a nice fancy profiler 
+//*************************************************************************************
+
+#ifndef TR4_PROF_HPP                        //  Protect file from multiple inclusions
+    #define TR4_PROF_HPP
+
+//-------------------------------------------------------------------------------------
+//  Profiling Policy
+//      The configuration file picks how the state functions are profiled:
+//
+//        TR_PROFILE_OFF     - Never.  CState::Schedule() calls the user's functions
+//                             directly; ProfileOn() still works for the time spent in
+//                             states, but not for the functions' run times.
+//        TR_PROFILE_SAMPLED - While a state's profiling is on, one scan in every
+//                             PROFILE_SAMPLE_INTERVAL is timed.  The averages and
+//                             histograms are estimates from those scans.
+//        TR_PROFILE_FULL    - While a state's profiling is on, every scan is timed.
+//
+//      If the configuration file doesn't pick one, TR_PROFILE_FULL is used.  A scan is
+//      timed by reading the profile clock once before the first function and once
+//      after each function, so the end of one function's time is the start of the
+//      next one's.  The profile clock is the processor's cycle counter where there
+//      is one (GNU C on an x86) and the scheduler's clock runs in real time; it's read
+//      in a few cycles, and it doesn't go into a journal as the clock's readings do.
+//      Otherwise it's the scheduler's clock.  Function timing is only measured with a
+//      clock which runs while the functions do:  the cycle counter, the free-running
+//      timer, or the interrupt clock in multithreading mode.
+
+#if !defined (TR_PROFILE_OFF) && !defined (TR_PROFILE_SAMPLED) \
+                              && !defined (TR_PROFILE_FULL)
+    #define  TR_PROFILE_FULL
+#endif
+
+#if !defined (TR_TIME_SIM) && !defined (TR_TIME_EXTSIM) && defined (__GNUC__) \
+    && (defined (__i386__) || defined (__x86_64__))
+    #define  TR_PROFILE_CYCLES
+#endif
+
+#if !defined (TR_PROFILE_OFF) && (defined (TR_PROFILE_CYCLES) \
+    || defined (TR_TIME_FREE) || defined (TR_THREAD_MULTI))
+    #define  TR_PROFILE_TIMING
+#endif
+
+//  Readings of the profile clock are kept as ticks, and changed into seconds only
+//  when they're given to a profiler.  The cycle counter's ticks are measured against
+//  the scheduler's clock when the timer starts
+#if defined (TR_PROFILE_CYCLES)
+    typedef unsigned long long ProfileTicks;
+    extern real_time ProfileSecondsPerTick;
+    #define  ReadProfileClock()         ((ProfileTicks)__builtin_ia32_rdtsc ())
+    #define  ProfileTicksToTime(X)      ((real_time)(X) * ProfileSecondsPerTick)
+#else
+    typedef real_time ProfileTicks;
+    #define  ReadProfileClock()         GetTimeNowUnprotected ()
+    #define  ProfileTicksToTime(X)      (X)
+#endif
+
+
+//=====================================================================================
+//  Class: CProfiler
+//      This class implements a run-time profiling object which keeps useful statis-
+//      tical data on the execution times of a user's functions.  It is given data
+//      which is being measured during every run of the given function; it enters the
+//      data into bins and presents a summary at the end of the run.
+//=====================================================================================
+
+class CProfiler
+    {
+    private:
+        long NumberOfRuns;                  //  How many times the function was run
+        real_time SumOfRunTimes;            //  Sum of all run times
+        real_time SumOfSquares;             //  Sum of squares of run times
+        real_time LongestRun;               //  Duration of the very longest run
+        int NumberOfBins;                   //  Number of bins in duration histogram
+        real_time Minimum;                  //  Minimum time on histogram - usually 0
+        real_time Maximum;                  //  Time for maximum bin
+        real_time LinearBinSize;            //  Size of each linearly spaced bin  
+        long* HistogramBins;                //  Pointer to the array of duration bins
+
+    public:
+        //  Constructors for default version and user-sized version
+        CProfiler (void);
+        CProfiler (int, real_time, real_time);
+        ~CProfiler (void);
+
+        void SaveData (real_time);          //  Save one timing data point
+        void ClearData (void);              //  Clear all the bins out
+
+        //  Specify the number of bins and the minimum and maximum times
+        void SetBins (int, real_time, real_time);
+
+        void DumpProfile (FILE*);           //  Write profile for a function to file
+        void DumpHistogram (FILE*);         //  Write a histogram table of times
+        void Checkpoint (CCheckpoint*);     //  Save or restore all the data
+        int GetNumberOfBins (void)          //  Ask how many bins there are in the
+            { return NumberOfBins; }        //    histogram array
+        real_time GetMinimum (void)         //  Find the times at the bottom and top
+            { return Minimum; }             //    of the histogram
+        real_time GetMaximum (void)
+            { return Maximum; }
+        long GetBinCount (int aBin)         //  Find how many times fell in one bin
+            { return HistogramBins[aBin]; }
+        long GetNumberOfRuns (void)         //  Function returns number of times
+            { return NumberOfRuns; }        //    the function has been called
+        real_time GetSumOfRunTimes (void)   //  Function to return total time the
+            { return SumOfRunTimes; }       //    function has been running
+        real_time GetSumOfSquares (void)    //  Function returns sum of squares of
+            { return SumOfSquares; }        //    function execution times
+        real_time GetLongestRun (void)      //  Function returns time of slowest
+            { return LongestRun; }          //    execution of the function
+    };
+
+#endif                                      //  End of multiple inclusion protection
+
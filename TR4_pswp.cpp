@@ -0,0 +1,415 @@
+//*************************************************************************************
+//  TR4_pswp.cpp
+//      This file contains the implementation of the parallel sweep, which runs the
+//      tasks of a process in several threads at once in sequential simulation.  See
+//      TR4_pswp.hpp.
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//*************************************************************************************
+
+#include <stdlib.h>
+#include <TranRun4.hpp>
+
+
+//  Each thread which is running a stage of a parallel sweep keeps a pointer to its
+//  worker here, so trace lines made by its tasks can be saved in the worker's buffer
+static TR_THREAD_LOCAL TR_SweepWorker* pRunningWorker = NULL;
+
+
+//=====================================================================================
+//  Class: CParallelSweep
+//      The process's own thread is worker 0; the other workers have threads of their
+//      own, which wait at the StageStart barrier between stages.  Each stage is a run
+//      of tasks in the task lists, either one task in group 0 or tasks in other groups
+//      up to the next one in group 0.
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+//  Constructor:  CParallelSweep
+//      The constructor starts a thread for each worker but the first.  The threads
+//      make the process's context their own, so TheMaster and TheTimer mean the same
+//      thing in them as in the process's thread.  From now on, the process's timeout
+//      queue is locked whenever a task changes it.  The plan is made before the first
+//      sweep, when all the tasks have been added.
+
+CParallelSweep::CParallelSweep (CProcess* aProcess, int aThreads)
+    {
+    int Index;                              //  Counts through the workers
+
+
+    pProcess = aProcess;
+    pContext = GetCurrentContext ();
+    NumWorkers = (aThreads < 1) ? 1 : aThreads;
+    Finished = FALSE;
+    Planned = FALSE;
+    Tasks = NULL;
+    NumTasks = 0;
+    WorkerOf = NULL;
+    TraceEnd = NULL;
+    StageFirst = NULL;
+    NumStages = 0;
+    Stage = 0;
+
+    pTimeoutLock = new CMutex ();
+    pProcess->GetTimeoutQueue ()->SetLock (pTimeoutLock);
+
+    StageStart = new CBarrier (NumWorkers);
+    StageEnd = new CBarrier (NumWorkers);
+    Workers = new TR_SweepWorker[NumWorkers];
+    if ((Workers == NULL) || (StageStart == NULL) || (StageEnd == NULL))
+        {
+        TR_Exit ("Unable to allocate memory for parallel sweep of process \"%s\"",
+                 pProcess->GetName ());
+        return;
+        }
+
+    for (Index = 0; Index < NumWorkers; Index++)
+        {
+        Workers[Index].pSweep = this;
+        Workers[Index].Index = Index;
+        Workers[Index].pThread = NULL;
+        Workers[Index].Trace = NULL;
+        Workers[Index].TraceCount = 0;
+        Workers[Index].TraceSize = 0;
+        Workers[Index].TraceCopied = 0;
+        }
+    for (Index = 1; Index < NumWorkers; Index++)
+        {
+        Workers[Index].pThread = new CThread (WorkerMain, (void*)&(Workers[Index]));
+        Workers[Index].pThread->Start ();
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Destructor:  ~CParallelSweep
+//      The workers' threads are let go from the starting barrier one last time with
+//      the finished flag set, so they exit.  Then we wait for them and clean up.
+
+CParallelSweep::~CParallelSweep (void)
+    {
+    int Index;
+
+    Finished = TRUE;
+    StageStart->Wait ();
+
+    for (Index = 0; Index < NumWorkers; Index++)
+        {
+        if (Workers[Index].pThread != NULL)
+            {
+            Workers[Index].pThread->Join ();
+            delete Workers[Index].pThread;
+            }
+        if (Workers[Index].Trace != NULL)
+            DELETE_ARRAY Workers[Index].Trace;
+        }
+    DELETE_ARRAY Workers;
+    delete StageStart;
+    delete StageEnd;
+
+    pProcess->GetTimeoutQueue ()->SetLock (NULL);
+    delete pTimeoutLock;
+
+    if (Tasks != NULL)
+        {
+        DELETE_ARRAY Tasks;
+        DELETE_ARRAY WorkerOf;
+        DELETE_ARRAY TraceEnd;
+        DELETE_ARRAY StageFirst;
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  WorkerMain
+//      This is the function which runs in each worker's thread.  It waits at the
+//      StageStart barrier until the process's thread has a stage to run, runs its
+//      share of the stage, and waits at StageEnd until the others have finished.
+
+void CParallelSweep::WorkerMain (void* aWorker)
+    {
+    TR_SweepWorker* pWorker = (TR_SweepWorker*)aWorker;
+    CParallelSweep* pSweep = pWorker->pSweep;
+
+    pSweep->pContext->MakeCurrent ();
+    for (;;)
+        {
+        pSweep->StageStart->Wait ();
+        if (pSweep->Finished == TRUE)
+            break;
+        pSweep->RunShare (pWorker);
+        pSweep->StageEnd->Wait ();
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  MakePlan
+//      This function makes a list of the tasks in the order in which a sequential
+//      sweep would run them, cuts it into stages, and decides which worker is to run
+//      each task.  All the tasks in one group within a stage go to the same worker,
+//      so they run in order; each group which shows up goes to the worker which has
+//      the fewest tasks so far.  If a stage turns out to have only one group, it's
+//      run by itself, as there would be nothing to gain from waking the workers.
+
+void CParallelSweep::MakePlan (void)
+    {
+    CTaskList* Lists[3];                    //  Task lists in a sweep's order
+    CTask* pTask;                           //  Each task in those lists
+    int* Load;                              //  Tasks given to each worker in a stage
+    int First;                              //  First task in the current stage
+    int Index, Other, List, Worker;         //  Count through tasks, lists, workers
+
+
+    if (Tasks != NULL)
+        {
+        DELETE_ARRAY Tasks;
+        DELETE_ARRAY WorkerOf;
+        DELETE_ARRAY TraceEnd;
+        DELETE_ARRAY StageFirst;
+        }
+
+    //  Timer interrupt tasks are run by the process before the sweep
+    Lists[0] = pProcess->PreemptibleTasks;
+    Lists[1] = pProcess->BackgroundTasks;
+    Lists[2] = pProcess->ContinuousTasks;
+
+    NumTasks = 0;
+    for (List = 0; List < 3; List++)
+        NumTasks += Lists[List]->HowMany ();
+
+    Tasks = new CTask*[NumTasks + 1];
+    WorkerOf = new int[NumTasks + 1];
+    TraceEnd = new int[NumTasks + 1];
+    StageFirst = new int[NumTasks + 1];
+    Load = new int[NumWorkers];
+    if ((Tasks == NULL) || (WorkerOf == NULL) || (TraceEnd == NULL)
+        || (StageFirst == NULL) || (Load == NULL))
+        {
+        TR_Exit ("Unable to allocate memory for parallel sweep of %d tasks", NumTasks);
+        return;
+        }
+
+    Index = 0;
+    for (List = 0; List < 3; List++)
+        for (pTask = (CTask*)Lists[List]->GetHead (); pTask != NULL;
+             pTask = (CTask*)Lists[List]->GetNext ())
+            Tasks[Index++] = pTask;
+
+    //  Cut the sweep into stages; a task in group 0 is a stage by itself
+    NumStages = 0;
+    Index = 0;
+    while (Index < NumTasks)
+        {
+        StageFirst[NumStages++] = Index;
+        if (Tasks[Index]->GetGroup () == 0)
+            {
+            WorkerOf[Index++] = -1;
+            continue;
+            }
+
+        First = Index;
+        for (Worker = 0; Worker < NumWorkers; Worker++)
+            Load[Worker] = 0;
+
+        for ( ; (Index < NumTasks) && (Tasks[Index]->GetGroup () != 0); Index++)
+            {
+            //  A group which is already in this stage stays with the same worker
+            for (Other = First; Other < Index; Other++)
+                if (Tasks[Other]->GetGroup () == Tasks[Index]->GetGroup ())
+                    break;
+
+            if (Other < Index)
+                Worker = WorkerOf[Other];
+            else
+                {
+                Worker = 0;
+                for (Other = 1; Other < NumWorkers; Other++)
+                    if (Load[Other] < Load[Worker])
+                        Worker = Other;
+                }
+            WorkerOf[Index] = Worker;
+            Load[Worker]++;
+            }
+
+        if (Load[WorkerOf[First]] == Index - First)
+            for (Other = First; Other < Index; Other++)
+                WorkerOf[Other] = -1;
+        }
+    StageFirst[NumStages] = NumTasks;
+
+    DELETE_ARRAY Load;
+    Planned = TRUE;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  GetNumStages
+//      This function returns the number of stages in each sweep.  The fewer there are,
+//      the less time the workers spend waiting for each other.
+
+int CParallelSweep::GetNumStages (void)
+    {
+    if (Planned == FALSE)
+        MakePlan ();
+
+    return (NumStages);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  RunShare
+//      A worker calls this function to run its share of the current stage, in the
+//      order of the task lists.  After each task, it notes how many trace lines it
+//      has saved, so the lines can be put back in order after the stage.
+
+void CParallelSweep::RunShare (TR_SweepWorker* aWorker)
+    {
+    int Last = StageFirst[Stage + 1];       //  One past the last task in the stage
+
+    pRunningWorker = aWorker;
+    aWorker->TraceCount = 0;
+
+    for (int Index = StageFirst[Stage]; Index < Last; Index++)
+        {
+        if (WorkerOf[Index] == aWorker->Index)
+            {
+            Tasks[Index]->Schedule ();
+            TraceEnd[Index] = aWorker->TraceCount;
+            }
+        }
+
+    pRunningWorker = NULL;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  MergeTrace
+//      After a stage, while the other workers wait, the process's thread copies the
+//      trace lines which the workers saved into the trace logger.  The lines made by
+//      each task are taken from the worker which ran it, a task at a time in the
+//      order of the task lists - the order in which a sequential sweep makes them.
+
+void CParallelSweep::MergeTrace (void)
+    {
+    TR_SweepWorker* pWorker;                //  Worker which ran each task
+    TR_TraceRecord* pLine;                  //  Trace line being copied
+    int Index;
+
+    for (Index = 0; Index < NumWorkers; Index++)
+        Workers[Index].TraceCopied = 0;
+
+    for (Index = StageFirst[Stage]; Index < StageFirst[Stage + 1]; Index++)
+        {
+        pWorker = &(Workers[WorkerOf[Index]]);
+        while (pWorker->TraceCopied < TraceEnd[Index])
+            {
+            pLine = pWorker->Trace + pWorker->TraceCopied++;
+            if (TheMaster->TraceLogger != NULL)
+                SaveLoggerData (TheMaster->TraceLogger, (double)pLine->Time,
+                                (void*)pProcess, pLine->pTask, pLine->pFromState,
+                                pLine->pToState, pLine->FromState, pLine->ToState);
+            }
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  Run
+//      The process calls this function in place of running its task lists.  A stage
+//      with one group, or a task in group 0, is run right here; for other stages, the
+//      workers are let go from the starting barrier, this thread runs worker 0's share,
+//      and then waits at the ending barrier for the rest.  A journal has to see the
+//      tasks' transitions in order, so while there's one, the tasks are run in turn.
+
+void CParallelSweep::Run (void)
+    {
+    int Index;
+
+    if (Planned == FALSE)
+        MakePlan ();
+
+    if (TheMaster->GetJournal () != NULL)
+        {
+        for (Index = 0; Index < NumTasks; Index++)
+            Tasks[Index]->Schedule ();
+        return;
+        }
+
+    for (Stage = 0; Stage < NumStages; Stage++)
+        {
+        if (WorkerOf[StageFirst[Stage]] < 0)
+            {
+            for (Index = StageFirst[Stage]; Index < StageFirst[Stage + 1]; Index++)
+                Tasks[Index]->Schedule ();
+            continue;
+            }
+
+        StageStart->Wait ();
+        RunShare (&(Workers[0]));
+        StageEnd->Wait ();
+        MergeTrace ();
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  SaveSweepTraceLine
+//      If the calling thread is running a stage of a parallel sweep, this function
+//      saves a trace line in its worker's buffer and returns TRUE.  The buffer grows
+//      as needed.  Otherwise it returns FALSE, and the caller logs the line itself.
+
+boolean SaveSweepTraceLine (void* aTask, void* aFrom, void* aTo, long aFromNum,
+                            long aToNum)
+    {
+    TR_SweepWorker* pWorker = pRunningWorker;
+    TR_TraceRecord* pLine;
+
+    if (pWorker == NULL)
+        return (FALSE);
+
+    //  If the buffer is full, make a new one twice as big and copy the lines over
+    if (pWorker->TraceCount >= pWorker->TraceSize)
+        {
+        int NewSize = (pWorker->TraceSize == 0) ? 64 : (pWorker->TraceSize * 2);
+        TR_TraceRecord* pNew = new TR_TraceRecord[NewSize];
+
+        if (pNew == NULL)
+            {
+            TR_Exit ("Unable to allocate trace buffer for parallel sweep");
+            return (TRUE);
+            }
+        for (int Line = 0; Line < pWorker->TraceCount; Line++)
+            pNew[Line] = pWorker->Trace[Line];
+        if (pWorker->Trace != NULL)
+            DELETE_ARRAY pWorker->Trace;
+        pWorker->Trace = pNew;
+        pWorker->TraceSize = NewSize;
+        }
+
+    pLine = pWorker->Trace + pWorker->TraceCount++;
+    pLine->Time = GetTimeNowUnprotected ();
+    pLine->pTask = aTask;
+    pLine->pFromState = aFrom;
+    pLine->pToState = aTo;
+    pLine->FromState = aFromNum;
+    pLine->ToState = aToNum;
+
+    return (TRUE);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  GetRunningSweep
+//      This function returns a pointer to the parallel sweep whose stage is being run
+//      in the calling thread, or NULL if none is.
+
+CParallelSweep* GetRunningSweep (void)
+    {
+    if (pRunningWorker == NULL)
+        return (NULL);
+
+    return (pRunningWorker->pSweep);
+    }
@@ -0,0 +1,115 @@
+//*************************************************************************************
+//  TR4_pswp.hpp
+//      This is the header for the parallel sweep, which lets a process run its tasks'
+//      functions in several threads at once in sequential simulation.  Each task may
+//      be given a group number with CTask::SetGroup().  Tasks in different groups are
+//      promised not to touch each other's data - not even through the data bus, or
+//      by triggering each other - so they may run at the same time; tasks in the
+//      same group run one after another, as always.  Group 0, which every task is in
+//      unless it's given another, means the task may touch anything, so it runs by
+//      itself.  Signals (see TR4_sgnl.hpp) are the exception: tasks which pass data
+//      only through signals, each written by one task, may be in different groups.
+//
+//      The sweep is cut into stages at each task in group 0.  Within a stage, each
+//      group's tasks are handed to one thread, which runs them in the order of the
+//      task lists; the threads meet at a barrier at the end of the stage.  Since no
+//      two groups share data, every task sees just what it would have seen in a
+//      sequential sweep.  Trace lines are saved by each thread and copied into the
+//      trace logger after the stage in the order of the task lists, so the trace is
+//      the same as that of a sequential run too.
+//
+//      Timer interrupt tasks, which run first in each sweep, are always run in the
+//      process's own thread.  A task in a group other than 0 mustn't use simulated
+//      time (see CTask::UseTime()), since the clock belongs to every thread.  While a
+//      run is being recorded or replayed, the sweep is run in sequence.
+//
+//      Parallel sweeps are used only in sequential single-thread simulation, where
+//      the clock stands still during a sweep (TR_PARALLEL_SWEEP is defined then).  In
+//      other modes, CProcess::ParallelOn() does nothing and the groups are ignored.
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//*************************************************************************************
+
+#ifndef TR4_PSWP_HPP
+    #define  TR4_PSWP_HPP                   //  Variable to prevent multiple inclusions
+
+#if defined (TR_TIME_SIM) && defined (TR_EXEC_SEQ) && defined (TR_THREAD_SINGLE)
+    #define  TR_PARALLEL_SWEEP
+#endif
+
+class CParallelSweep;
+class CSchedulerContext;
+
+//  Each thread which helps run a sweep has one of these, holding the trace lines
+//  made by the tasks it runs during a stage
+struct TR_SweepWorker
+    {
+    CParallelSweep* pSweep;                 //  Sweep to which the worker belongs
+    int Index;                              //  Worker's number; the process is 0
+    CThread* pThread;                       //  Thread the worker runs in, or NULL
+    TR_TraceRecord* Trace;                  //  Trace lines made during this stage
+    int TraceCount;                         //  Number of lines in Trace
+    int TraceSize;                          //  Number of lines there's room for
+    int TraceCopied;                        //  Lines copied to the trace logger
+    };
+
+
+//=====================================================================================
+//  Class: CParallelSweep
+//      A process which runs its sweeps in parallel owns one of these.  It keeps the
+//      worker threads and a plan saying which tasks run in which stage, and which
+//      worker runs each one.  The plan is made again when tasks are added or their
+//      groups are changed.
+//=====================================================================================
+
+class CParallelSweep
+    {
+    private:
+        CProcess* pProcess;                 //  Process whose sweeps are run
+        CSchedulerContext* pContext;        //  Context to which the process belongs
+        int NumWorkers;                     //  Workers, counting the process's thread
+        TR_SweepWorker* Workers;            //  Array of workers
+        CBarrier* StageStart;               //  Workers wait here to begin a stage,
+        CBarrier* StageEnd;                 //    and here when they've finished it
+        CMutex* pTimeoutLock;               //  Guards the process's timeout queue
+        boolean Finished;                   //  Tells the workers' threads to exit
+        boolean Planned;                    //  FALSE if the plan must be made again
+        CTask** Tasks;                      //  Tasks in the order of the task lists
+        int NumTasks;                       //  Number of tasks in the plan
+        int* WorkerOf;                      //  Worker which runs each task, or -1 if
+                                            //    it runs by itself
+        int* TraceEnd;                      //  Worker's trace count after each task
+        int* StageFirst;                    //  First task in each stage
+        int NumStages;                      //  Number of stages in a sweep
+        int Stage;                          //  Stage which the workers are running
+
+        static void WorkerMain (void*);     //  Function which runs in each thread
+        void MakePlan (void);               //  Find stages and share out the tasks
+        void RunShare (TR_SweepWorker*);    //  Run one worker's tasks in this stage
+        void MergeTrace (void);             //  Log this stage's trace lines in order
+
+    public:
+        CParallelSweep (CProcess*, int);    //  Constructor is given the process and
+        ~CParallelSweep (void);             //    number of threads, and starts them
+
+        void Run (void);                    //  Run one sweep through the tasks
+        void Invalidate (void)              //  Make the plan again before the next
+            { Planned = FALSE; }            //    sweep, as tasks or groups changed
+        int GetNumWorkers (void)            //  Function returns the number of
+            { return (NumWorkers); }        //    threads which run the sweep
+        int GetNumStages (void);            //  Find how many stages a sweep has
+    };
+
+
+//  TL_TraceLine() calls this function, which saves the trace line and returns TRUE if
+//  the calling thread is running a stage of a parallel sweep; otherwise it returns
+//  FALSE and the line is logged as usual
+boolean SaveSweepTraceLine (void*, void*, void*, long, long);
+
+//  This function returns a pointer to the parallel sweep whose stage is being run in
+//  the calling thread, or NULL if none is
+CParallelSweep* GetRunningSweep (void);
+
+#endif      //  End of multiple-inclusion protection
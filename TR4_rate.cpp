@@ -0,0 +1,158 @@
+//*************************************************************************************
+//  TR4_rate.cpp
+//      This file contains the implementation of rate-transition blocks, which use
+//      triple buffering to move frames of data between tasks running at different
+//      rates without PreventPreemption() and AllowPreemption().
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//*************************************************************************************
+
+#if defined (__WIN32__)
+    #include <windows.h>                //  For InterlockedExchange()
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <TranRun4.hpp>
+
+
+//  The middle buffer word holds the buffer's index in its low two bits and this flag,
+//  which is set by the writer when the middle buffer holds a frame the reader hasn't
+//  seen and cleared when the reader takes it
+#define  NEW_FRAME_FLAG      0x04L
+#define  BUFFER_INDEX_MASK   0x03L
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  TR_AtomicExchange
+//      This function puts a new value into a variable and returns the value which was
+//      there before, in such a way that nothing can get in between the reading and
+//      the writing.  With real threads we need the processor's locked exchange; in
+//      interrupt-driven modes, disabling interrupts is enough; in single-thread modes
+//      without interrupts, nothing can get in between anyway.
+
+long TR_AtomicExchange (volatile long* aTarget, long aValue)
+    {
+    #if defined (__WIN32__)
+        return (InterlockedExchange ((long*)aTarget, aValue));
+    #elif defined (__GNUC__)
+        return (__atomic_exchange_n (aTarget, aValue, __ATOMIC_ACQ_REL));
+    #else
+        long OldValue;
+
+        DisableInterrupts ();
+        OldValue = *aTarget;
+        *aTarget = aValue;
+        EnableInterrupts ();
+        return (OldValue);
+    #endif
+    }
+
+
+//=====================================================================================
+//  Class: CRateTransition
+//      A triple buffer which passes frames of a fixed size from one writer task to
+//      one reader task.  See TR4_rate.hpp for a description of how it works.
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+//  Constructor:  CRateTransition
+//      This constructor allocates the three frame buffers in one block and clears
+//      them, so a reader which runs before the first frame is written sees zeros.
+
+CRateTransition::CRateTransition (unsigned aSize)
+    {
+    if (aSize == 0)
+        TR_Exit ("Rate transition block created with a frame size of zero");
+
+    FrameSize = aSize;
+    if ((Buffers = new char[3 * FrameSize]) == NULL)
+        TR_Exit ("Unable to allocate memory for rate transition block");
+    memset (Buffers, 0, 3 * FrameSize);
+
+    //  Buffer 0 starts out with the reader, 1 in the middle, and 2 with the writer
+    ReadIndex = 0;
+    Middle = 1L;
+    WriteIndex = 2;
+
+    FramesWritten = 0L;
+    FramesRead = 0L;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Destructor:  ~CRateTransition
+//      This destructor frees the memory used for the buffers.
+
+CRateTransition::~CRateTransition (void)
+    {
+    DELETE_ARRAY Buffers;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Functions:  BeginWrite, EndWrite, and Write
+//      The writer fills the buffer returned by BeginWrite(), which no one else can
+//      touch, then calls EndWrite() to swap it into the middle with the new-frame
+//      flag set.  It gets back whichever buffer was in the middle, which is free
+//      because the reader only ever holds its own buffer.  If the reader hasn't taken
+//      the previous frame yet, that frame is simply replaced by the newer one.
+
+void* CRateTransition::BeginWrite (void)
+    {
+    return ((void*)(Buffers + (WriteIndex * FrameSize)));
+    }
+
+void CRateTransition::EndWrite (void)
+    {
+    long OldMiddle = TR_AtomicExchange (&Middle, (long)WriteIndex | NEW_FRAME_FLAG);
+    WriteIndex = (int)(OldMiddle & BUFFER_INDEX_MASK);
+    FramesWritten++;
+    }
+
+void CRateTransition::Write (const void* aFrame)
+    {
+    memcpy (BeginWrite (), aFrame, FrameSize);
+    EndWrite ();
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Functions:  Read
+//      If a new frame is waiting in the middle buffer, the reader swaps its own
+//      buffer into the middle (without the new-frame flag) and takes the new frame.
+//      Otherwise it keeps the frame it already has, which is still the latest.  The
+//      first version returns a pointer to the frame; the second copies it to the
+//      caller's buffer and returns TRUE if the frame is one not read before.
+
+const void* CRateTransition::Read (void)
+    {
+    if ((Middle & NEW_FRAME_FLAG) != 0L)
+        {
+        long OldMiddle = TR_AtomicExchange (&Middle, (long)ReadIndex);
+        ReadIndex = (int)(OldMiddle & BUFFER_INDEX_MASK);
+        FramesRead++;
+        }
+    return ((const void*)(Buffers + (ReadIndex * FrameSize)));
+    }
+
+boolean CRateTransition::Read (void* aFrame)
+    {
+    unsigned long OldCount = FramesRead;
+
+    memcpy (aFrame, Read (), FrameSize);
+    return ((FramesRead != OldCount) ? TRUE : FALSE);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  NewFrameAvailable
+//      This function returns TRUE if the writer has finished a frame which the reader
+//      hasn't picked up yet.  It only looks at the flag, so it doesn't change anything.
+
+boolean CRateTransition::NewFrameAvailable (void)
+    {
+    return (((Middle & NEW_FRAME_FLAG) != 0L) ? TRUE : FALSE);
+    }
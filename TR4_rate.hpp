@@ -0,0 +1,70 @@
+//*************************************************************************************
+//  TR4_rate.hpp
+//      This is the header for rate-transition blocks, which pass data from a task
+//      running at one rate to a task running at another without a critical section.
+//      A fast timer-interrupt task can hand frames to a slow sample-time task (or the
+//      other way around) and neither one ever waits for the other.
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//*************************************************************************************
+
+#ifndef TR4_RATE_HPP
+    #define  TR4_RATE_HPP                   //  Variable to prevent multiple inclusions
+
+//  Atomic exchange:  Store a new value and return the old one as one indivisible
+//  operation.  Under Win32 and GCC this uses the processor's interlocked exchange so
+//  it works between real threads; in DOS interrupt modes it disables interrupts for
+//  the two instructions needed.  This is the only synchronization the block uses.
+long TR_AtomicExchange (volatile long*, long);
+
+
+//=====================================================================================
+//  Class: CRateTransition
+//      This class implements a triple buffer.  One buffer belongs to the writer, one
+//      to the reader, and the third is the "middle" buffer which holds the latest
+//      complete frame.  The writer fills its own buffer and then swaps it with the
+//      middle one; the reader swaps its buffer with the middle one only if a new
+//      frame has arrived.  Each swap is a single atomic exchange, so writing and
+//      reading are wait-free, and the reader always sees the latest whole frame and
+//      never a partly written one.  There must be just one writer and one reader.
+//=====================================================================================
+
+class CRateTransition
+    {
+    private:
+        char* Buffers;                      //  Memory for all three frame buffers
+        unsigned FrameSize;                 //  Size of one frame in bytes
+        int WriteIndex;                     //  Buffer owned by the writer
+        int ReadIndex;                      //  Buffer owned by the reader
+        volatile long Middle;               //  Middle buffer index and new-frame flag
+        unsigned long FramesWritten;        //  Number of frames completed by writer
+        unsigned long FramesRead;           //  Number of new frames taken by reader
+
+    public:
+        CRateTransition (unsigned);         //  Constructor is given size of a frame
+        ~CRateTransition (void);            //  Destructor frees buffer memory
+
+        //  Writer side:  BeginWrite() returns a pointer to the writer's own buffer; after
+        //  filling it, call EndWrite() to make it the latest frame.  Write() does both.
+        void* BeginWrite (void);
+        void EndWrite (void);
+        void Write (const void*);
+
+        //  Reader side:  Read() returns a pointer to the latest complete frame, which
+        //  stays valid and unchanged until the next call to Read().  The version which
+        //  takes a pointer copies the frame out and returns TRUE if it's a new one.
+        const void* Read (void);
+        boolean Read (void*);
+        boolean NewFrameAvailable (void);   //  TRUE if a frame arrived since Read()
+
+        unsigned GetFrameSize (void)        //  Function returns the size of one
+            { return (FrameSize); }         //    frame in bytes
+        unsigned long GetFramesWritten (void)   //  Returns number of frames which
+            { return (FramesWritten); }         //    the writer has finished
+        unsigned long GetFramesRead (void)      //  Returns number of new frames
+            { return (FramesRead); }            //    the reader has picked up
+    };
+
+#endif      //  End of multiple-inclusion protection
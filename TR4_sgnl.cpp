@@ -0,0 +1,129 @@
+//*************************************************************************************
+//  TR4_sgnl.cpp
+//      This file contains the implementation of signals, which pass values between
+//      tasks a sweep at a time.  See TR4_sgnl.hpp.
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//*************************************************************************************
+
+#include <stdlib.h>
+#include <string.h>
+#include <TranRun4.hpp>
+
+
+//=====================================================================================
+//  Class: CBasicSignal
+//      A double-buffered value.  The copy which isn't committed belongs to the task
+//      which writes the signal during a sweep; nobody else looks at it until the
+//      master commits the signal, between sweeps.
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+//  Constructor:  CBasicSignal
+//      The constructor saves the name and allocates both copies of the value, which
+//      start out as zeros unless SetInitial() is called.
+
+CBasicSignal::CBasicSignal (const char* aName, unsigned aSize)
+    {
+    if ((Name = new char[strlen (aName) + 1]) != NULL)
+        strcpy (Name, aName);
+
+    Size = aSize;
+    Committed = 0;
+    Written = FALSE;
+    CommitCount = 0L;
+
+    if ((Values = new char[2 * aSize]) == NULL)
+        {
+        TR_Exit ("Unable to allocate memory for signal \"%s\"", aName);
+        return;
+        }
+    memset (Values, 0, 2 * aSize);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Destructor:  ~CBasicSignal
+
+CBasicSignal::~CBasicSignal (void)
+    {
+    DELETE_ARRAY Values;
+    DELETE_ARRAY Name;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  BeginWrite
+//      This function returns a pointer to the copy of the value which is to be
+//      committed at the end of the sweep.  The first time it's called in a sweep, the
+//      committed value is copied into it, so whatever isn't changed stays the same.
+
+void* CBasicSignal::BeginWrite (void)
+    {
+    char* pNext = Values + (1 - Committed) * Size;
+
+    if (Written == FALSE)
+        {
+        memcpy (pNext, Values + Committed * Size, Size);
+        Written = TRUE;
+        }
+
+    return ((void*)pNext);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  Write
+//      Copy a whole new value into the copy which is to be committed at the end of
+//      the sweep.  If it's written more than once in a sweep, the last value counts.
+
+void CBasicSignal::Write (const void* aValue)
+    {
+    memcpy (Values + (1 - Committed) * Size, aValue, Size);
+    Written = TRUE;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  SetInitial
+//      Set both copies of the value, so that it's seen by readers at once.  This is
+//      meant to be called while setting up, before the scheduler runs.
+
+void CBasicSignal::SetInitial (const void* aValue)
+    {
+    memcpy (Values, aValue, Size);
+    memcpy (Values + Size, aValue, Size);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  Commit
+//      The master calls this function for each signal at the end of each sweep.  If
+//      the signal was written during the sweep, the copies trade places, so readers
+//      see the new value from now on.
+
+void CBasicSignal::Commit (void)
+    {
+    if (Written == TRUE)
+        {
+        Committed = 1 - Committed;
+        Written = FALSE;
+        CommitCount++;
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  Checkpoint
+//      Checkpoints are saved between sweeps, when every signal has been committed,
+//      so only the committed value and the count of values need to be saved.
+
+void CBasicSignal::Checkpoint (CCheckpoint* aCheckpoint)
+    {
+    aCheckpoint->Name (Name);
+    aCheckpoint->Count ((int)Size, "bytes in signal");
+    aCheckpoint->Data (Values + Committed * Size, Size);
+    aCheckpoint->Data (&CommitCount, sizeof (unsigned long));
+    }
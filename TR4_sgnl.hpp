@@ -0,0 +1,105 @@
+//*************************************************************************************
+//  TR4_sgnl.hpp
+//      This is the header for signals, which pass values between tasks one sweep at a
+//      time.  A signal holds two copies of its value.  During a sweep, every task
+//      which reads the signal sees the value committed at the start of the sweep,
+//      while the task which writes it fills in the other copy.  At the end of the
+//      sweep the master commits each signal which was written, by swapping the two
+//      copies, and the new value is seen by everyone from the next sweep on.
+//
+//      So what a task reads doesn't depend on whether the writer ran before or after
+//      it in the sweep, and tasks which pass data to each other only through signals
+//      may be run in any order, or at the same time in a parallel sweep (see
+//      TR4_pswp.hpp) without being put in the same group.  Each signal must have just
+//      one task which writes it.  In parallel simulation (TR_TIME_EXTSIM), signals are
+//      committed at the end of each time window instead, as data bus samples are.
+//
+//      The typed CSignal<> template is normally used:
+//
+//          CSignal<double>* pSpeed = new CSignal<double> ("Speed", 0.0);
+//          TheMaster->InsertSignal (pSpeed);
+//          ...
+//          pSpeed->Write (Measured);               //  In the writer's Action()
+//          if (pSpeed->Read () > Limit) ...        //  In a reader's functions
+//
+//      The value is copied byte for byte, so it must be a plain structure or number
+//      without pointers to memory of its own.  The master deletes its signals when
+//      it's deleted, so they must be created with new.
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//*************************************************************************************
+
+#ifndef TR4_SGNL_HPP
+    #define  TR4_SGNL_HPP                   //  Variable to prevent multiple inclusions
+
+
+//=====================================================================================
+//  Class: CBasicSignal
+//      A signal whose value is a block of bytes of a given size.  The two copies of
+//      the value are kept in one block of memory; Committed says which one the
+//      readers see.  Committing a signal just changes that number, so it takes the
+//      same time however big the value is.
+//=====================================================================================
+
+class CBasicSignal
+    {
+    private:
+        char* Name;                         //  Name of this signal
+        unsigned Size;                      //  Size of the value in bytes
+        char* Values;                       //  The two copies of the value
+        int Committed;                      //  Copy which readers see, 0 or 1
+        boolean Written;                    //  TRUE if written during this sweep
+        unsigned long CommitCount;          //  Number of new values committed
+
+    public:
+        CBasicSignal (const char*, unsigned);   //  Constructor is given the name and
+        virtual ~CBasicSignal (void);           //    size of the value
+
+        const void* Read (void)             //  Get the value committed at the start
+            { return (Values + Committed * Size); }     //  of this sweep
+        void* BeginWrite (void);            //  Get the copy to be written, holding
+                                            //    what's been written this sweep
+        void Write (const void*);           //  Copy in the value to be committed
+        void SetInitial (const void*);      //  Set both copies, before running
+        void Commit (void);                 //  Master makes the new value seen
+
+        const char* GetName (void)          //  Function returns a pointer to the
+            { return (Name); }              //    name of this signal
+        unsigned GetSize (void)             //  Function returns the size in bytes
+            { return (Size); }              //    of the signal's value
+        unsigned long GetCommitCount (void) //  Returns the number of new values
+            { return (CommitCount); }       //    which have been committed
+        void Checkpoint (CCheckpoint*);     //  Save or restore the committed value
+    };
+
+
+//=====================================================================================
+//  Class: CSignal
+//      A signal whose value is of the type given as the template argument.  Read()
+//      returns the committed value; Write() gives the value to be committed at the
+//      end of the sweep.  Modify() returns the copy which is to be committed, holding
+//      the committed value until something is written, so part of a structure can be
+//      changed in place.
+//=====================================================================================
+
+template <class TValue> class CSignal : public CBasicSignal
+    {
+    public:
+        CSignal (const char* aName)
+            : CBasicSignal (aName, sizeof (TValue))
+            { }
+        CSignal (const char* aName, const TValue& aInitial)
+            : CBasicSignal (aName, sizeof (TValue))
+            { SetInitial ((const void*)&aInitial); }
+
+        const TValue& Read (void)
+            { return (*((const TValue*)CBasicSignal::Read ())); }
+        void Write (const TValue& aValue)
+            { CBasicSignal::Write ((const void*)&aValue); }
+        TValue& Modify (void)
+            { return (*((TValue*)BeginWrite ())); }
+    };
+
+#endif      //  End of multiple-inclusion protection
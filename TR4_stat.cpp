@@ -1,383 +1,973 @@
-//*************************************************************************************
-//  TR4_stat.cpp
-//      This is the implementation for the Transition Logic state class used in the
-//      TranRun4 project.
-//
-//  Copyright (c) 1994-1996, D.M.Auslander and J.R.Ridgely
-//      May be used and distributed for any non-commercial purposes as long as this
-//      copyright notice is included.
-//
-//  Version
-//       5-22-95  JR   Original version
-//      12-21-96  JR   Changed to TranRun4 version
-//*************************************************************************************
-
-#include <stdlib.h>
-#include <string.h>
-#include <TranRun4.hpp>
-
-
-//=====================================================================================
-//  Class: CState
-//      This class implements a transition logic state.  A task contains a list of
-//      states; each state must have at least one of the following:
-//        - Entry function, run when the task enters the given state
-//        - Action function, run again and again while the task remains in a state
-//        - Test function(s) which determine if task will enter a new state
-//=====================================================================================
-
-//-------------------------------------------------------------------------------------
-//  Constructor:  CState
-//      This constructor builds a state object.  The state has a name and a set of
-//      functions (Entry(), Action(),...) which it can run.  CState is used as a base
-//      class so that the user can define his own states which exhibit the behavior
-//      desired in a state-transition-logic based program.  The user must have over-
-//      ridden at least one of the Entry, Action, or Transition Test functions; so
-//      the constructor checks to see that at least one has been overridden and if
-//      none has, it dumps out of the program with an error message.
-
-CState::CState (const char *aName)
-    {
-    //  Make some space and save the name of this object
-    Name = new char[strlen (aName) + 1];
-    if (Name != NULL)
-        strcpy (Name, aName);
-
-    //  Set the FirstTimeRun variable to TRUE so that a test will be performed to
-    //  verify that user has overloaded at least one entry, action, or test functions
-    FirstTimeRun = TRUE;
-
-    //  'EnteringThisState' is TRUE when we're going to enter this state from 
-    //  another state.  It's true now, since we haven't even run the scheduler yet
-    EnteringThisState = TRUE;
-
-    //  This state hasn't been inserted into a task's list, so serial number is bunk
-    SerialNumber = -1;
-
-    //  Create the objects which will keep execution time data for each function
-    EntryProfiler = new CProfiler ();
-    ActionProfiler = new CProfiler ();
-    TestProfiler = new CProfiler ();
-    DoProfile = FALSE;                      //  Profiler is activated by ProfileOn()
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Destructor:  CState
-//      This destructor just frees up any memory allocated for the state object.
-
-CState::~CState (void)
-    {
-    DELETE_ARRAY Name;
-    delete EntryProfiler;
-    delete ActionProfiler;
-    delete TestProfiler;
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function:  Schedule
-//      This is the supervisory function which runs the Entry(), Action(), and
-//      TransitionTest() functions when they need to be run.
-
-CState* CState::Schedule (void)
-    {
-    CState* TheNextState;                   //  Points to state to which we transition
-
-    #if defined (TR_THREAD_MULTI) || defined (TR_TIME_FREE)
-        real_time BeginTime;                //  Used for measuring execution times
-    #endif
-
-    //  If this state is being entered, run the Entry() function
-    if (EnteringThisState == TRUE)
-        {
-        EnteringThisState = FALSE;
-
-        #if defined (TR_THREAD_MULTI) || defined (TR_TIME_FREE)
-            if (DoProfile == TRUE)  BeginTime = GetTimeNowUnprotected ();
-        #endif
-
-        EnableInterrupts ();                //  Turn interrupts on (in multithreading
-        Entry ();                           //  modes only) so that this function can
-        DisableInterrupts ();               //  be pre-empted by higher priority tasks
-
-        #if defined (TR_THREAD_MULTI) || defined (TR_TIME_FREE)
-            if (DoProfile == TRUE)
-                EntryProfiler->SaveData (GetTimeNowUnprotected () - BeginTime);
-        #endif
-        }
-        
-    //  We're remaining within this state, so run the Action() function
-    #if defined (TR_THREAD_MULTI) || defined (TR_TIME_FREE)
-        if (DoProfile == TRUE)  BeginTime = GetTimeNowUnprotected ();
-    #endif
-
-    EnableInterrupts ();
-    Action ();
-    DisableInterrupts ();
-
-    #if defined (TR_THREAD_MULTI) || defined (TR_TIME_FREE)
-        if (DoProfile == TRUE)
-            ActionProfiler->SaveData (GetTimeNowUnprotected () - BeginTime);
-    #endif
-
-    //  Run the transition test function and save the next state
-    #if defined (TR_THREAD_MULTI) || defined (TR_TIME_FREE)
-        if (DoProfile == TRUE)  BeginTime = GetTimeNowUnprotected ();
-    #endif
-
-    EnableInterrupts ();
-    TheNextState = TransitionTest ();
-    DisableInterrupts ();
-
-    #if defined (TR_THREAD_MULTI) || defined (TR_TIME_FREE)
-        if (DoProfile == TRUE)
-            TestProfiler->SaveData (GetTimeNowUnprotected () - BeginTime);
-    #endif
-
-    //  If a transition has been called for, set the entering variable TRUE so the
-    //  Entry() function runs next time this state's Schedule() function is called
-    if (TheNextState != NULL)
-        EnteringThisState = TRUE;
-
-    //  Return a pointer to the state which will be run the next time around
-    return (TheNextState);
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function:  Entry
-//      The entry function is called when the parent task enters this state after a
-//      transition.  The user may override this function; if not, it adds 1 to the
-//      count of non-overloaded functions which have been run.
-
-void CState::Entry (void)
-    {
-    static boolean FirstTimeRun = FALSE;
-    if (FirstTimeRun == TRUE)
-        {
-        NonOverloadedCount++;
-        FirstTimeRun = FALSE;
-        }
-    Idle ();
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function:  Action
-//      The action function runs repeatedly while the parent task remainins in this
-//      state.
-
-void CState::Action (void)
-    {
-    static boolean FirstTimeRun = FALSE;
-    if (FirstTimeRun == TRUE)
-        {
-        NonOverloadedCount++;
-        FirstTimeRun = FALSE;
-        }
-    Idle ();
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function:  TransitionTest
-//      The transition test function is called at end of every scan and returns the
-//      value of a new state to be entered next scan (or it returns NULL for no
-//      transition).  If not overloaded, this function always returns NULL.
-
-CState *CState::TransitionTest (void)
-    {
-    static boolean FirstTimeRun = FALSE;
-    if (FirstTimeRun == TRUE)
-        {
-        NonOverloadedCount++;
-        FirstTimeRun = FALSE;
-        }
-    Idle ();
-    return (NULL);
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function:  SetSampleTime
-//      This function calls the parent task's SetSampleTime method.  It's placed here
-//      so the user doesn't have to worry about parent task pointers to adjust the
-//      sample time.  If there is no parent task, it doesn't set anything.
-
-void CState::SetSampleTime (real_time aTime)
-    {
-    if (pParent != NULL)
-        ((CTask *)pParent)->SetSampleTime (aTime);
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function:  GetSampleTime
-//      A user might wish to get the sample time from within a state too; this func-
-//      tion does that.  If no parent task has been set, it returns zero.
-
-real_time CState::GetSampleTime (void)
-    {
-    if (pParent != NULL)
-        return (((CTask *)pParent)->GetSampleTime ());
-    else
-        return ((real_time)0.0);
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function:  GetPriority
-//      This function is used to get the priority of a state's parent task.  If the
-//      parent task has been set, it returns the priority as given by the parent; if
-//      not, it returns -1, which is an invalid priority for which the user can test.
-
-int CState::GetPriority (void)
-    {
-    if (pParent != NULL)
-        return (((CTask *)pParent)->GetPriority ());
-    else
-        return (-1);
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function:  Idle
-//      If you're writing a sample-time or event task, you must call the Idle() func-
-//      tion to stop the action function's execution until the next time step.  This
-//      function calls the Idle() method of the parent task of this state for you.
-
-void CState::Idle (void)
-    {
-    if (pParent != NULL)
-        ((CTask *)pParent)->Idle ();
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function:  Deactivate
-//      Tasks have the methods Deactivate() and Reactivate() to stop and restart exe-
-//      cution of the task's functions - all of them.  Call this function to halt the
-//      running of the parent task.
-
-void CState::Deactivate (void)
-    {
-    if (pParent != NULL)
-        ((CTask *)pParent)->Deactivate ();
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function:  Reactivate
-//      If you have called the above function, Deactivate(), to stop the parent task
-//      from running this state, you may call either that task's Reactivate() function
-//      or this state's Reactivate() function; either one will wake the task up again.
-
-void CState::Reactivate (void)
-    {
-    if (pParent != NULL)
-        ((CTask *)pParent)->Reactivate ();
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function:  ProfileOn (version which sets histogram parameters)
-//      This function activates execution-time profiling and sets the number of bins
-//      used for keeping a histogram as well as the minimum and maximum bins.
-//      The version of this function which takes no parameters is declared inline. 
-
-void CState::ProfileOn (int aNum, real_time aMin, real_time aMax)
-    {
-    EntryProfiler->SetBins (aNum, aMin, aMax);
-    ActionProfiler->SetBins (aNum, aMin, aMax);
-    TestProfiler->SetBins (aNum, aMin, aMax);
-    DoProfile = TRUE;
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function:  DumpProfile
-//      This function writes information about how long the Entry(), Action(), and
-//      TransitionTest() functions of this state took to run.  Average and maximum
-//      times are reported as well as standard deviation and a table of frequencies
-//      which can be used to plot a histogram.
-
-void CState::DumpProfile (FILE* aFile, const char* aTaskName)
-    {
-    //  Create a string to hold headers for functions' timing printouts
-    char Header[128];
-
-	//  Call profiler objects which belong to the entry, action, and test functions
-    //  and tell them to print their timing information
-    sprintf (Header, "----- Task \"%s\" State \"%s\" Entry Function ",
-             aTaskName, Name);
-    for (int Index = strlen (Header); Index < PAGE_WIDTH; Index++)
-        strcat (Header, "-");
-    fprintf (aFile, "%s\n", Header);
-    EntryProfiler->DumpProfile (aFile);
-
-    sprintf (Header, "----- Task \"%s\" State \"%s\" Action Function ",
-             aTaskName, Name);
-    for (int Index = strlen (Header); Index < PAGE_WIDTH; Index++)
-        strcat (Header, "-");
-    fprintf (aFile, "%s\n", Header);
-    ActionProfiler->DumpProfile (aFile);
-
-    sprintf (Header, "----- Task \"%s\" State \"%s\" Test Function ",
-             aTaskName, Name);
-    for (int Index = strlen (Header); Index < PAGE_WIDTH; Index++)
-        strcat (Header, "-");
-    fprintf (aFile, "%s\n", Header);
-    TestProfiler->DumpProfile (aFile);
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function:  DumpDurations
-//      This function writes up to three files, each containing a histogram table for
-//      the Entry(), Action(), or TransitionTest() function's run time.  If any of
-//      the filenames given is a NULL string, or if any files cannot be opened, these
-//      functions' profiles will not be written.  
-
-void CState::DumpDurations (const char* aEntryName, const char* aActionName,
-                            const char* aTestName)
-    {
-    FILE* EntryFile;                        //  Pointers to the files to which the
-    FILE* ActionFile;                       //  frequency tables will be written
-    FILE* TestFile;
-
-    //  Attempt to open the files; if one can't be opened, no problem
-    if (aEntryName != NULL)  EntryFile = fopen (aEntryName, "w");
-    if (aActionName != NULL) ActionFile = fopen (aActionName, "w");
-    if (aTestName != NULL)   TestFile = fopen (aTestName, "w");
-
-    //  If any file was successfully opened, write to it and close it
-    if (EntryFile != NULL)
-        {
-        EntryProfiler->DumpHistogram (EntryFile);
-        fclose (EntryFile);
-        }
-
-    if (ActionFile != NULL)
-        {
-        ActionProfiler->DumpHistogram (ActionFile);
-        fclose (ActionFile);
-        }
-
-    if (TestFile != NULL)
-        {
-        TestProfiler->DumpHistogram (TestFile);
-        fclose (TestFile);
-        }
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function:  DumpLatencies
-//      This function isn't yet implemented.  I'll get to it sometime...
-
-void CState::DumpLatencies (const char* aEntryName, const char* aActionName,
-                            const char* aTestName)
-    {
-    }
-
+//*************************************************************************************
+//  TR4_stat.cpp
+//      This is the implementation for the Transition Logic state class used in the
+//      TranRun4 project.
+//
+//  Copyright (c) 1994-1996, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//
+//  Version
+//       5-22-95  JR   Original version
+//      12-21-96  JR   Changed to TranRun4 version
+//*************************************************************************************
+
+#include <stdlib.h>
+#include <string.h>
+#include <TranRun4.hpp>
+
+//  Bits in a state's Measured variable which say which functions were timed in a scan
+#define  MEASURED_ENTRY      0x01
+#define  MEASURED_ACTION     0x02
+#define  MEASURED_TEST       0x04
+
+
+//=====================================================================================
+//  Class: CState
+//      This class implements a transition logic state.  A task contains a list of
+//      states; each state must have at least one of the following:
+//        - Entry function, run when the task enters the given state
+//        - Action function, run again and again while the task remains in a state
+//        - Test function(s) which determine if task will enter a new state
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+//  Constructor:  CState
+//      This constructor builds a state object.  The state has a name and a set of
+//      functions (Entry(), Action(),...) which it can run.  CState is used as a base
+//      class so that the user can define his own states which exhibit the behavior
+//      desired in a state-transition-logic based program.  The user must have over-
+//      ridden at least one of the Entry, Action, or Transition Test functions; so
+//      the constructor checks to see that at least one has been overridden and if
+//      none has, it dumps out of the program with an error message.
+
+CState::CState (const char *aName)
+    {
+    Configure (aName, NULL);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Constructor:  CState (version for nested states)
+//      This constructor makes a state nested within the given superstate.  The first
+//      substate made within a superstate becomes its initial substate.
+
+CState::CState (const char *aName, CState* aSuperState)
+    {
+    Configure (aName, aSuperState);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  Configure
+//      Both constructors call this function to save the name and set up the state.
+
+void CState::Configure (const char *aName, CState* aSuperState)
+    {
+    //  Make some space and save the name of this object
+    Name = new char[strlen (aName) + 1];
+    if (Name != NULL)
+        strcpy (Name, aName);
+
+    //  Set the FirstTimeRun variable to TRUE so that a test will be performed to
+    //  verify that user has overloaded at least one entry, action, or test functions
+    FirstTimeRun = TRUE;
+
+    //  'EnteringThisState' is TRUE when we're going to enter this state from 
+    //  another state.  It's true now, since we haven't even run the scheduler yet
+    EnteringThisState = TRUE;
+
+    //  This state hasn't been inserted into a task's list, so serial number is bunk
+    SerialNumber = -1;
+
+    //  Create the objects which will keep execution time data for each function
+    EntryProfiler = new CProfiler ();
+    ActionProfiler = new CProfiler ();
+    TestProfiler = new CProfiler ();
+    DoProfile = FALSE;                      //  Profiler is activated by ProfileOn()
+    Sampling = FALSE;                       //  With sampled profiling, the first
+    SampleCountdown = 1;                    //    scan after ProfileOn() is timed
+    Measured = 0;
+    pExecTime = NULL;                       //  Functions take no simulated time
+
+    //  Note the superstate, if any.  The path from the outermost state is found by
+    //  the task when it first runs
+    pSuperState = aSuperState;
+    pInitialSubState = NULL;
+    if ((pSuperState != NULL) && (pSuperState->pInitialSubState == NULL))
+        pSuperState->pInitialSubState = this;
+    pPath = NULL;
+    Depth = 0;
+    pInitialLeaf = this;
+
+    //  There are no guards yet, so the transition test function does all the testing
+    Guards = NULL;
+    NumGuards = 0;
+    GuardArraySize = 0;
+    DoTest = TRUE;
+
+    //  Time spent in the state goes into a histogram which covers a second unless the
+    //  user sets other bins
+    DwellProfiler = new CProfiler (DWELL_BINS, (real_time)0.0, DWELL_MAXIMUM);
+    EnteredAt = (real_time)0.0;
+
+    //  The state runs every scan unless it's told to wait for events
+    EventOnly = FALSE;
+    Events = NULL;
+    NumEvents = 0;
+    EventArraySize = 0;
+    WaitsForTrigger = FALSE;
+
+    //  There's no timeout until WaitForTimeout() or SetTimeoutTransition() makes one
+    pTimeoutTarget = NULL;
+    TimeoutDelay = (real_time)0.0;
+    TimeoutDeadline = (real_time)0.0;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Destructor:  CState
+//      This destructor just frees up any memory allocated for the state object.
+
+CState::~CState (void)
+    {
+    DELETE_ARRAY Name;
+    delete EntryProfiler;
+    delete ActionProfiler;
+    delete TestProfiler;
+    delete DwellProfiler;
+    DELETE_ARRAY pPath;
+    DELETE_ARRAY Guards;
+    for (int Index = 0; Index < NumEvents; Index++)
+        DELETE_ARRAY Events[Index].pCopy;
+    DELETE_ARRAY Events;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  Schedule
+//      This is the supervisory function which runs the Entry(), Action(), and
+//      TransitionTest() functions when they need to be run.  If the scan is to be
+//      profiled, the profile clock is read here and then after each function; with
+//      TR_PROFILE_OFF, the functions are simply called.
+
+CState* CState::Schedule (void)
+    {
+    CState* TheNextState;                   //  Points to state to which we transition
+    ProfileTicks* pMark = NULL;             //  Points to last clock reading, if any
+
+    #if defined (TR_PROFILE_TIMING)
+        ProfileTicks Mark;                  //  Profile clock when last function ended
+
+        if (ProfileThisScan () == TRUE)
+            {
+            Mark = ReadProfileClock ();
+            pMark = &Mark;
+            }
+    #endif
+
+    //  If this state is being entered, run the Entry() function
+    if (EnteringThisState == TRUE)
+        {
+        EnteringThisState = FALSE;
+        RunEntry (pMark);
+        }
+
+    //  We're remaining within this state, so run the Action() function; then run
+    //  the transition test function and save the next state
+    RunAction (pMark);
+    TheNextState = RunTest (pMark);
+
+    #if defined (TR_PROFILE_TIMING)
+        if (pMark != NULL)
+            SaveProfiles ();
+    #endif
+
+    //  If a transition has been called for, set the entering variable TRUE so the
+    //  Entry() function runs next time this state's Schedule() function is called
+    if (TheNextState != NULL)
+        EnteringThisState = TRUE;
+
+    //  In simulation, the functions take as long as the execution-time model says
+    #if defined (TR_TIME_SIM)
+        if ((pExecTime != NULL) && (pParent != NULL))
+            pParent->UseTime (pExecTime->Sample ());
+    #endif
+
+    //  Return a pointer to the state which will be run the next time around
+    return (TheNextState);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  RunEntry
+//      Run the Entry() function with interrupts turned on (in multithreading modes
+//      only) so that it can be pre-empted by higher priority tasks.  If the scan is
+//      being profiled, the caller gives a pointer to the profile clock's reading at
+//      the end of the last function; the clock is read once more, the difference is
+//      kept for SaveProfiles(), and the new reading becomes the mark for the next
+//      function.  RunAction() and RunTest() are the same for the Action() and
+//      TransitionTest() functions.  The pointer isn't used when nothing is timed.
+
+#if defined (TR_PROFILE_TIMING)
+void CState::RunEntry (ProfileTicks* aMark)
+#else
+void CState::RunEntry (ProfileTicks*)
+#endif
+    {
+    EnableInterrupts ();
+    Entry ();
+    DisableInterrupts ();
+
+    #if defined (TR_PROFILE_TIMING)
+        if (aMark != NULL)
+            {
+            ProfileTicks Now = ReadProfileClock ();
+            EntryTicks = Now - *aMark;
+            *aMark = Now;
+            Measured |= MEASURED_ENTRY;
+            }
+    #endif
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  RunAction
+
+#if defined (TR_PROFILE_TIMING)
+void CState::RunAction (ProfileTicks* aMark)
+#else
+void CState::RunAction (ProfileTicks*)
+#endif
+    {
+    EnableInterrupts ();
+    Action ();
+    DisableInterrupts ();
+
+    #if defined (TR_PROFILE_TIMING)
+        if (aMark != NULL)
+            {
+            ProfileTicks Now = ReadProfileClock ();
+            ActionTicks = Now - *aMark;
+            *aMark = Now;
+            Measured |= MEASURED_ACTION;
+            }
+    #endif
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  RunTest
+//      The guard table is checked first, and the test function is run only if no
+//      guard passes.  Where the signal is compared with the threshold is found as 0
+//      (below), 1 (equal), or 2 (above), and the guard's test has a bit for each, so
+//      checking a guard takes the same few instructions whatever its test is.  The
+//      time taken by the guards is profiled along with the test function.
+
+#if defined (TR_PROFILE_TIMING)
+CState* CState::RunTest (ProfileTicks* aMark)
+#else
+CState* CState::RunTest (ProfileTicks*)
+#endif
+    {
+    CState* TheNextState = NULL;            //  State to which the test says to go
+    TransitionGuard* pGuard;                //  Each guard in the table
+    TransitionGuard* pEnd = Guards + NumGuards;
+    double Value;                           //  Value of a guard's signal
+    int Side;                               //  Which side of the threshold it's on
+
+    for (pGuard = Guards; pGuard < pEnd; pGuard++)
+        {
+        Value = *(pGuard->pSignal);
+        Side = (Value > pGuard->Threshold) + (Value >= pGuard->Threshold);
+        if (((pGuard->Test >> Side) & 1) != 0)
+            {
+            TheNextState = pGuard->pTarget;
+            break;
+            }
+        }
+
+    if ((TheNextState == NULL) && (DoTest == TRUE))
+        {
+        EnableInterrupts ();
+        TheNextState = TransitionTest ();
+        DisableInterrupts ();
+        }
+
+    #if defined (TR_PROFILE_TIMING)
+        if (aMark != NULL)
+            {
+            ProfileTicks Now = ReadProfileClock ();
+            TestTicks = Now - *aMark;
+            *aMark = Now;
+            Measured |= MEASURED_TEST;
+            }
+    #endif
+
+    return (TheNextState);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  ProfileThisScan
+//      Decide whether this scan's functions are to be timed.  With full profiling,
+//      they are whenever profiling is on; with sampled profiling, in one scan of
+//      every PROFILE_SAMPLE_INTERVAL.  Without function timing, they never are.
+
+boolean CState::ProfileThisScan (void)
+    {
+    Sampling = DoProfile;
+
+    #if !defined (TR_PROFILE_TIMING)
+        Sampling = FALSE;
+    #elif defined (TR_PROFILE_SAMPLED)
+        if ((Sampling == TRUE) && (--SampleCountdown > 0))
+            Sampling = FALSE;
+        else if (Sampling == TRUE)
+            SampleCountdown = PROFILE_SAMPLE_INTERVAL;
+    #endif
+
+    return (Sampling);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  SaveProfiles
+//      After a timed scan, give the times of the functions which ran to the state's
+//      profilers.  In a scan of nested states, the clock is read for every state's
+//      functions, but only those states which chose to be timed keep their times.
+
+void CState::SaveProfiles (void)
+    {
+    if (Sampling == TRUE)
+        {
+        if ((Measured & MEASURED_ENTRY) != 0)
+            EntryProfiler->SaveData (ProfileTicksToTime (EntryTicks));
+        if ((Measured & MEASURED_ACTION) != 0)
+            ActionProfiler->SaveData (ProfileTicksToTime (ActionTicks));
+        if ((Measured & MEASURED_TEST) != 0)
+            TestProfiler->SaveData (ProfileTicksToTime (TestTicks));
+        }
+
+    Measured = 0;
+    Sampling = FALSE;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  RunExit
+//      Run the Exit() function as the task leaves a nested state or superstate.  The
+//      exit function isn't profiled.
+
+void CState::RunExit (void)
+    {
+    EnableInterrupts ();
+    Exit ();
+    DisableInterrupts ();
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  Entry
+//      The entry function is called when the parent task enters this state after a
+//      transition.  The user may override this function; if not, it adds 1 to the
+//      count of non-overloaded functions which have been run.
+
+void CState::Entry (void)
+    {
+    static boolean FirstTimeRun = FALSE;
+    if (FirstTimeRun == TRUE)
+        {
+        NonOverloadedCount++;
+        FirstTimeRun = FALSE;
+        }
+    Idle ();
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  Action
+//      The action function runs repeatedly while the parent task remainins in this
+//      state.
+
+void CState::Action (void)
+    {
+    static boolean FirstTimeRun = FALSE;
+    if (FirstTimeRun == TRUE)
+        {
+        NonOverloadedCount++;
+        FirstTimeRun = FALSE;
+        }
+    Idle ();
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  TransitionTest
+//      The transition test function is called at end of every scan and returns the
+//      value of a new state to be entered next scan (or it returns NULL for no
+//      transition).  If not overloaded, this function always returns NULL.
+
+CState *CState::TransitionTest (void)
+    {
+    static boolean FirstTimeRun = FALSE;
+    if (FirstTimeRun == TRUE)
+        {
+        NonOverloadedCount++;
+        FirstTimeRun = FALSE;
+        }
+    Idle ();
+    return (NULL);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  Exit
+//      The exit function is called when the parent task leaves this nested state or
+//      superstate.  Unlike the other functions, it does nothing if not overridden.
+
+void CState::Exit (void)
+    {
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  SetInitialSubState
+//      When a transition goes to a superstate, the task goes on into the super-
+//      state's initial substate.  That's the first substate made unless this function
+//      is called with another one.
+
+void CState::SetInitialSubState (CState* aState)
+    {
+    if ((aState == NULL) || (aState->pSuperState != this))
+        TR_Exit ("State \"%s\" isn't a substate of \"%s\"",
+                 (aState == NULL) ? "(none)" : aState->Name, Name);
+    else
+        pInitialSubState = aState;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  AddGuard
+//      Add a guard to the end of this state's table.  When the state's transitions are
+//      tested, if the given variable passes the given test against the threshold, the
+//      task goes to the target state.  The variable must still exist whenever the
+//      state runs.
+
+void CState::AddGuard (double* aSignal, GuardTest aTest, double aThreshold,
+                       CState* aTarget)
+    {
+    int Index;                              //  Counts through guards
+
+    if ((aSignal == NULL) || (aTarget == NULL))
+        {
+        TR_Exit ("Guard for state \"%s\" needs a variable and a target state", Name);
+        return;
+        }
+
+    //  If the table is full, make a new one twice as big and copy the guards into it
+    if (NumGuards >= GuardArraySize)
+        {
+        int NewSize = (GuardArraySize < 4) ? 4 : (GuardArraySize * 2);
+        TransitionGuard* NewGuards = new TransitionGuard[NewSize];
+        if (NewGuards == NULL)
+            {
+            TR_Exit ("Unable to allocate memory for %d guards in state \"%s\"",
+                     NewSize, Name);
+            return;
+            }
+        for (Index = 0; Index < NumGuards; Index++)
+            NewGuards[Index] = Guards[Index];
+        DELETE_ARRAY Guards;
+        Guards = NewGuards;
+        GuardArraySize = NewSize;
+        }
+
+    Guards[NumGuards].pSignal = aSignal;
+    Guards[NumGuards].Threshold = aThreshold;
+    Guards[NumGuards].Test = (int)aTest;
+    Guards[NumGuards].pTarget = aTarget;
+    NumGuards++;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Functions:  WaitForTrigger, WaitForData, WaitForSignal, WaitForChange,
+//              WaitForTimeout
+//      Each of these functions makes the state event-only and adds one thing to the
+//      list of those for which it waits.  They're usually called from the user's
+//      state's constructor.  A subscriber's new data wakes the task until it's read,
+//      so the state should read it each time it runs.  A signal wakes the task when
+//      a new value is committed after the task began to wait.  A variable is watched
+//      by keeping a copy of it when the task begins to wait, so it must stay where
+//      it is.  A timeout is the state's one timeout (see SetTimeoutTransition()) with
+//      no state to go to, so it wakes the task once each time the state is entered.
+
+void CState::WaitForTrigger (void)
+    {
+    EventOnly = TRUE;
+    WaitsForTrigger = TRUE;
+    }
+
+void CState::WaitForData (CSubscriber* aSubscriber)
+    {
+    StateEvent* pEvent;
+
+    EventOnly = TRUE;
+    if ((pEvent = AddEvent ()) != NULL)
+        pEvent->pSubscriber = aSubscriber;
+    }
+
+void CState::WaitForSignal (CBasicSignal* aSignal)
+    {
+    StateEvent* pEvent;
+
+    EventOnly = TRUE;
+    if ((pEvent = AddEvent ()) != NULL)
+        {
+        pEvent->pSignal = aSignal;
+        pEvent->SeenCount = aSignal->GetCommitCount ();
+        }
+    }
+
+void CState::WaitForChange (void* aVariable, unsigned aSize)
+    {
+    StateEvent* pEvent;
+
+    EventOnly = TRUE;
+    if ((pEvent = AddEvent ()) != NULL)
+        {
+        pEvent->pVariable = aVariable;
+        pEvent->Size = aSize;
+        if ((pEvent->pCopy = new char[aSize]) == NULL)
+            TR_Exit ("Unable to allocate memory for event in state \"%s\"", Name);
+        else
+            memcpy (pEvent->pCopy, aVariable, aSize);
+        }
+    }
+
+void CState::WaitForTimeout (real_time aTime)
+    {
+    if (aTime <= (real_time)0.0)
+        {
+        TR_Exit ("Timeout for state \"%s\" must be longer than zero", Name);
+        return;
+        }
+
+    EventOnly = TRUE;
+    pTimeoutTarget = NULL;
+    TimeoutDelay = aTime;
+    TimeoutDeadline = (real_time)9E99;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  SetTimeoutTransition
+//      Give this state a timeout transition:  when the given time has passed since
+//      the task entered the state, the task goes to the given state.  This takes the
+//      place of any timeout given by WaitForTimeout(), and a NULL target takes the
+//      timeout away.  It's usually called from the constructor; if it's called while
+//      the task is in the state, it counts from the next entry.
+
+void CState::SetTimeoutTransition (real_time aTime, CState* aTarget)
+    {
+    if ((aTarget != NULL) && (aTime <= (real_time)0.0))
+        {
+        TR_Exit ("Timeout for state \"%s\" must be longer than zero", Name);
+        return;
+        }
+
+    pTimeoutTarget = aTarget;
+    TimeoutDelay = (aTarget != NULL) ? aTime : (real_time)0.0;
+    TimeoutDeadline = (real_time)9E99;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  AddEvent
+//      Add an empty entry to the end of the array of events, making the array twice
+//      as big when it's full, and return a pointer to the new entry.
+
+StateEvent* CState::AddEvent (void)
+    {
+    StateEvent* pEvent;                     //  The new entry
+    int Index;                              //  Counts through events
+
+    if (NumEvents >= EventArraySize)
+        {
+        int NewSize = (EventArraySize < 4) ? 4 : (EventArraySize * 2);
+        StateEvent* NewEvents = new StateEvent[NewSize];
+        if (NewEvents == NULL)
+            {
+            TR_Exit ("Unable to allocate memory for %d events in state \"%s\"",
+                     NewSize, Name);
+            return (NULL);
+            }
+        for (Index = 0; Index < NumEvents; Index++)
+            NewEvents[Index] = Events[Index];
+        DELETE_ARRAY Events;
+        Events = NewEvents;
+        EventArraySize = NewSize;
+        }
+
+    pEvent = Events + NumEvents++;
+    pEvent->pSubscriber = NULL;
+    pEvent->pSignal = NULL;
+    pEvent->SeenCount = 0L;
+    pEvent->pVariable = NULL;
+    pEvent->Size = 0;
+    pEvent->pCopy = NULL;
+    return (pEvent);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  StartWaiting
+//      The task calls this function when it begins to wait in this state.  The values
+//      of the variables being watched, and the signals' commit counts, are copied so
+//      a change can be seen later.  The state's timeout is in the process's timeout
+//      queue, which wakes the task itself.
+
+void CState::StartWaiting (void)
+    {
+    StateEvent* pEvent;
+    StateEvent* pEnd = Events + NumEvents;
+
+    for (pEvent = Events; pEvent < pEnd; pEvent++)
+        {
+        if (pEvent->pSignal != NULL)
+            pEvent->SeenCount = pEvent->pSignal->GetCommitCount ();
+        if (pEvent->pVariable != NULL)
+            memcpy (pEvent->pCopy, pEvent->pVariable, pEvent->Size);
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  EventHasFired
+//      The task calls this function each scan while it waits, to find out if any of
+//      this state's events have happened.  It's told whether its TriggerEvent() has
+//      been called.  This is much cheaper than running Action() and TransitionTest().
+
+boolean CState::EventHasFired (boolean aTriggered)
+    {
+    StateEvent* pEvent;
+    StateEvent* pEnd = Events + NumEvents;
+
+    if ((aTriggered == TRUE) && (WaitsForTrigger == TRUE))
+        return (TRUE);
+
+    for (pEvent = Events; pEvent < pEnd; pEvent++)
+        {
+        if ((pEvent->pSubscriber != NULL)
+            && (pEvent->pSubscriber->NewDataAvailable () == TRUE))
+            return (TRUE);
+        if ((pEvent->pSignal != NULL)
+            && (pEvent->pSignal->GetCommitCount () != pEvent->SeenCount))
+            return (TRUE);
+        if ((pEvent->pVariable != NULL)
+            && (memcmp (pEvent->pCopy, pEvent->pVariable, pEvent->Size) != 0))
+            return (TRUE);
+        }
+
+    return (FALSE);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  IsWithin
+//      This function returns TRUE if this state is the given state or is nested,
+//      at any depth, within it.  Once the task has run, the state's path is used.
+
+boolean CState::IsWithin (CState* aState)
+    {
+    CState* pAbove;                         //  Each of this state's superstates
+
+    if (aState == NULL)
+        return (FALSE);
+
+    if (pPath != NULL)
+        return (((aState->Depth <= Depth) && (pPath[aState->Depth] == aState))
+                ? TRUE : FALSE);
+
+    for (pAbove = this; pAbove != NULL; pAbove = pAbove->pSuperState)
+        if (pAbove == aState)
+            return (TRUE);
+
+    return (FALSE);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  SetSampleTime
+//      This function calls the parent task's SetSampleTime method.  It's placed here
+//      so the user doesn't have to worry about parent task pointers to adjust the
+//      sample time.  If there is no parent task, it doesn't set anything.
+
+void CState::SetSampleTime (real_time aTime)
+    {
+    if (pParent != NULL)
+        ((CTask *)pParent)->SetSampleTime (aTime);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  GetSampleTime
+//      A user might wish to get the sample time from within a state too; this func-
+//      tion does that.  If no parent task has been set, it returns zero.
+
+real_time CState::GetSampleTime (void)
+    {
+    if (pParent != NULL)
+        return (((CTask *)pParent)->GetSampleTime ());
+    else
+        return ((real_time)0.0);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  GetPriority
+//      This function is used to get the priority of a state's parent task.  If the
+//      parent task has been set, it returns the priority as given by the parent; if
+//      not, it returns -1, which is an invalid priority for which the user can test.
+
+int CState::GetPriority (void)
+    {
+    if (pParent != NULL)
+        return (((CTask *)pParent)->GetPriority ());
+    else
+        return (-1);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  Idle
+//      If you're writing a sample-time or event task, you must call the Idle() func-
+//      tion to stop the action function's execution until the next time step.  This
+//      function calls the Idle() method of the parent task of this state for you.
+
+void CState::Idle (void)
+    {
+    if (pParent != NULL)
+        ((CTask *)pParent)->Idle ();
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  Deactivate
+//      Tasks have the methods Deactivate() and Reactivate() to stop and restart exe-
+//      cution of the task's functions - all of them.  Call this function to halt the
+//      running of the parent task.
+
+void CState::Deactivate (void)
+    {
+    if (pParent != NULL)
+        ((CTask *)pParent)->Deactivate ();
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  Reactivate
+//      If you have called the above function, Deactivate(), to stop the parent task
+//      from running this state, you may call either that task's Reactivate() function
+//      or this state's Reactivate() function; either one will wake the task up again.
+
+void CState::Reactivate (void)
+    {
+    if (pParent != NULL)
+        ((CTask *)pParent)->Reactivate ();
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  ProfileOn (version which sets histogram parameters)
+//      This function activates execution-time profiling and sets the number of bins
+//      used for keeping a histogram as well as the minimum and maximum bins.
+//      The version of this function which takes no parameters is declared inline. 
+
+void CState::ProfileOn (int aNum, real_time aMin, real_time aMax)
+    {
+    EntryProfiler->SetBins (aNum, aMin, aMax);
+    ActionProfiler->SetBins (aNum, aMin, aMax);
+    TestProfiler->SetBins (aNum, aMin, aMax);
+    DoProfile = TRUE;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  DumpProfile
+//      This function writes information about how long the Entry(), Action(), and
+//      TransitionTest() functions of this state took to run.  Average and maximum
+//      times are reported as well as standard deviation and a table of frequencies
+//      which can be used to plot a histogram.
+
+void CState::DumpProfile (FILE* aFile, const char* aTaskName)
+    {
+    //  Create a string to hold headers for functions' timing printouts
+    char Header[128];
+
+	//  Call profiler objects which belong to the entry, action, and test functions
+    //  and tell them to print their timing information
+    sprintf (Header, "----- Task \"%s\" State \"%s\" Entry Function ",
+             aTaskName, Name);
+    for (int Index = strlen (Header); Index < PAGE_WIDTH; Index++)
+        strcat (Header, "-");
+    fprintf (aFile, "%s\n", Header);
+    EntryProfiler->DumpProfile (aFile);
+
+    sprintf (Header, "----- Task \"%s\" State \"%s\" Action Function ",
+             aTaskName, Name);
+    for (int Index = strlen (Header); Index < PAGE_WIDTH; Index++)
+        strcat (Header, "-");
+    fprintf (aFile, "%s\n", Header);
+    ActionProfiler->DumpProfile (aFile);
+
+    sprintf (Header, "----- Task \"%s\" State \"%s\" Test Function ",
+             aTaskName, Name);
+    for (int Index = strlen (Header); Index < PAGE_WIDTH; Index++)
+        strcat (Header, "-");
+    fprintf (aFile, "%s\n", Header);
+    TestProfiler->DumpProfile (aFile);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  DumpDurations
+//      This function writes up to three files, each containing a histogram table for
+//      the Entry(), Action(), or TransitionTest() function's run time.  If any of
+//      the filenames given is a NULL string, or if any files cannot be opened, these
+//      functions' profiles will not be written.  
+
+void CState::DumpDurations (const char* aEntryName, const char* aActionName,
+                            const char* aTestName)
+    {
+    FILE* EntryFile;                        //  Pointers to the files to which the
+    FILE* ActionFile;                       //  frequency tables will be written
+    FILE* TestFile;
+
+    //  Attempt to open the files; if one can't be opened, no problem
+    if (aEntryName != NULL)  EntryFile = fopen (aEntryName, "w");
+    if (aActionName != NULL) ActionFile = fopen (aActionName, "w");
+    if (aTestName != NULL)   TestFile = fopen (aTestName, "w");
+
+    //  If any file was successfully opened, write to it and close it
+    if (EntryFile != NULL)
+        {
+        EntryProfiler->DumpHistogram (EntryFile);
+        fclose (EntryFile);
+        }
+
+    if (ActionFile != NULL)
+        {
+        ActionProfiler->DumpHistogram (ActionFile);
+        fclose (ActionFile);
+        }
+
+    if (TestFile != NULL)
+        {
+        TestProfiler->DumpHistogram (TestFile);
+        fclose (TestFile);
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  DumpLatencies
+//      This function isn't yet implemented.  I'll get to it sometime...
+
+void CState::DumpLatencies (const char* aEntryName, const char* aActionName,
+                            const char* aTestName)
+    {
+    }
+
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  SetDwellBins
+//      Set the number of bins and the shortest and longest times in the histogram of
+//      times spent in this state.  Any data kept so far is cleared.
+
+void CState::SetDwellBins (int aNum, real_time aMin, real_time aMax)
+    {
+    DwellProfiler->SetBins (aNum, aMin, aMax);
+    DwellProfiler->ClearData ();
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  DumpDwellTime
+//      This function writes how many times the state was left, and the average,
+//      standard deviation, and longest of the times spent in it.
+
+void CState::DumpDwellTime (FILE* aFile, const char* aTaskName)
+    {
+    char Header[128];
+
+    sprintf (Header, "----- Task \"%s\" State \"%s\" Time in State ", aTaskName, Name);
+    for (int Index = strlen (Header); Index < PAGE_WIDTH; Index++)
+        strcat (Header, "-");
+    fprintf (aFile, "%s\n", Header);
+    DwellProfiler->DumpProfile (aFile);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  DumpDwellHistogram
+//      This function writes the histogram table of times spent in this state to a
+//      file, as DumpDurations() does for the functions' run times.
+
+void CState::DumpDwellHistogram (const char* aFileName)
+    {
+    FILE* aFile;
+
+    if ((aFile = fopen (aFileName, "w")) == NULL)
+        TR_Exit ("Unable to open file \"%s\" for time in state histogram", aFileName);
+    else
+        {
+        DwellProfiler->DumpHistogram (aFile);
+        fclose (aFile);
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  Checkpoint
+//      This function saves the state's scheduling flags and execution-time profiles
+//      in a checkpoint, or restores them; then it calls CheckpointData() so that a
+//      state derived from this one can save or restore its own data too.
+
+void CState::Checkpoint (CCheckpoint* aCheckpoint)
+    {
+    aCheckpoint->Name (Name);
+    aCheckpoint->Data (&FirstTimeRun, sizeof (boolean));
+    aCheckpoint->Data (&EnteringThisState, sizeof (boolean));
+    EntryProfiler->Checkpoint (aCheckpoint);
+    ActionProfiler->Checkpoint (aCheckpoint);
+    TestProfiler->Checkpoint (aCheckpoint);
+    DwellProfiler->Checkpoint (aCheckpoint);
+    aCheckpoint->Data (&EnteredAt, sizeof (real_time));
+
+    //  The state's timeout and the values of the variables and signals it watches
+    aCheckpoint->Data (&TimeoutDeadline, sizeof (real_time));
+    aCheckpoint->Count (NumEvents, "state events");
+    for (int Index = 0; Index < NumEvents; Index++)
+        {
+        if (Events[Index].pSignal != NULL)
+            aCheckpoint->Data (&(Events[Index].SeenCount), sizeof (unsigned long));
+        if (Events[Index].pVariable != NULL)
+            aCheckpoint->Data (Events[Index].pCopy, Events[Index].Size);
+        }
+
+    CheckpointData (aCheckpoint);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  CheckpointData
+//      A user's state which keeps data of its own should override this function and
+//      pass each item to the checkpoint's Data() function.  This version does nothing,
+//      for states which keep no data between scans.
+
+void CState::CheckpointData (CCheckpoint*)
+    {
+    }
@@ -1,87 +1,257 @@
-//*************************************************************************************
-//  TR4_stat.hpp
-//      This is the header for the T.L. state classes used in the TranRun4 project.
-//
-//  Copyright (c) 1994-1996, D.M.Auslander and J.R.Ridgely
-//      May be used and distributed for any non-commercial purposes as long as this
-//      copyright notice is included.
-//*************************************************************************************
-
-#ifndef TR4_STAT_HPP
-    #define  TR4_STAT_HPP                   //  Variable to prevent multiple inclusions
-
-//  Forward declaration of CTask (needed because states keep pointers to parent tasks)
-class CTask;
-
-
-//=====================================================================================
-//  Class: CState
-//      This class implements a transition logic state.  A task contains a list of
-//      states; each state must have at least one of the following:
-//        - Entry function, run when the task enters the given state
-//        - Action function, run again and again while the task remains in a state
-//        - Test function(s) which determine if task will enter a new state
-//=====================================================================================
-
-class CState
-    {
-    private:
-        char* Name;                     //  String holds the name of this state
-        int NonOverloadedCount;         //  Count of functions not yet overloaded
-        boolean FirstTimeRun;           //  Is this the first time this state's run?
-        boolean EnteringThisState;      //  True when entering this state
-        int SerialNumber;               //  Number of this state in task's state list
-        boolean DoProfile;              //  True if we are keeping run duration data
-        CProfiler* EntryProfiler;       //  These are the execution time profiler
-        CProfiler* ActionProfiler;      //  objects for the entry, action, and tran-
-        CProfiler* TestProfiler;        //  sition test functions
-
-    protected:
-        CTask* pParent;                 //  Pointer to parent task
-
-    public:
-        //  Constructor is given a name for the new state
-        CState (const char*);
-        virtual ~CState (void);
-
-        //  This function returns a pointer to the state's name, which is in a string
-        const char* GetName (void) { return (Name); }
-
-        //  Entry function is called when the parent task enters this state; Action
-        //  function runs repeatedly while remaining in this state; Transition Test
-        //  function is called at end of every scan and returns the value of a new
-        //  state to be entered next scan (or it returns NULL for no transition).
-        //  Schedule() is the function which calls these functions.
-        virtual void Entry (void);
-        virtual void Action (void);
-        virtual CState* TransitionTest (void);
-        CState* Schedule (void);
-
-        void SetSampleTime (real_time);     //  Function resets interval between runs
-        real_time GetSampleTime (void);     //  To get sample time of parent task
-        int GetPriority (void);             //  Function gets priority of parent task
-        int GetSerialNumber (void)          //  This function returns the serial num-
-            { return (SerialNumber); }      //    ber of this state in the task's list
-        void SetSerialNumber (int aNumber)  //  The task calls this function to set
-            { SerialNumber = aNumber; }     //    the number of this state in its list
-        void Idle (void);                   //  Parent task idles 'til next sample time
-        void Deactivate (void);             //  Task stops running until re-activated
-        void Reactivate (void);             //  To start a de-activated task up again
-        void SetParent (CTask* aPtr)        //  Function called by the task object to
-            { pParent = aPtr; }             //    set pointer to parent task object
-        void ProfileOff (void)              //  Function to turn execution time pro-
-            { DoProfile = FALSE; }          //    filing back off
-        void DumpProfile (FILE*,            //  Function writes information about how
-                            const char*);   //    long state functions took to run
-
-        //  Write histogram tables of run times and latencies to the given files
-        void DumpDurations (const char*, const char*, const char*);
-        void DumpLatencies (const char*, const char*, const char*);
-
-        //  Turn execution-time profiling on with default and user-given parameters
-        void ProfileOn (void) { DoProfile = TRUE; }
-        void ProfileOn (int, real_time, real_time);
-    };
-
-#endif      //  End of multiple-inclusion protection
-
+//*************************************************************************************
+//  TR4_stat.hpp
+//      This is the header for the T.L. state classes used in the TranRun4 project.
+//
+//  Copyright (c) 1994-1996, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//*************************************************************************************
+
+#ifndef TR4_STAT_HPP
+    #define  TR4_STAT_HPP                   //  Variable to prevent multiple inclusions
+
+//  Forward declaration of CTask (needed because states keep pointers to parent tasks)
+class CTask;
+class CState;
+class CSubscriber;
+class CBasicSignal;
+
+//  Comparisons which a guard can make between a signal and its threshold.  Each value
+//  is a set of bits meaning "below" (1), "equal" (2), and "above" (4), so the guard
+//  fires if the bit for where the signal is relative to the threshold is set
+enum GuardTest
+    {
+    GUARD_BELOW = 1,    //  Signal < threshold
+    GUARD_EQUAL = 2,    //  Signal == threshold
+    GUARD_AT_MOST = 3,  //  Signal <= threshold
+    GUARD_ABOVE = 4,    //  Signal > threshold
+    GUARD_NOT_EQUAL = 5,//  Signal != threshold
+    GUARD_AT_LEAST = 6  //  Signal >= threshold
+    };
+
+//  One entry in a state's guard table:  if the signal passes the test against the
+//  threshold, the task goes to the target state
+struct TransitionGuard
+    {
+    double* pSignal;                //  Variable which is tested
+    double Threshold;               //  Value against which it's tested
+    int Test;                       //  A GuardTest value
+    CState* pTarget;                //  State to go to if the test passes
+    };
+
+//  One thing for which an event-only state waits:  new data for a subscriber, or a
+//  change in the value of a variable
+struct StateEvent
+    {
+    CSubscriber* pSubscriber;       //  Subscriber which is to get new data, or NULL
+    CBasicSignal* pSignal;          //  Signal which is to get a new value, or NULL
+    unsigned long SeenCount;        //  Its commit count when the task began waiting
+    void* pVariable;                //  Variable which is to change, or NULL
+    unsigned Size;                  //  Size of the variable in bytes
+    char* pCopy;                    //  Its value when the task began waiting
+    };
+
+
+//=====================================================================================
+//  Class: CState
+//      This class implements a transition logic state.  A task contains a list of
+//      states; each state must have at least one of the following:
+//        - Entry function, run when the task enters the given state
+//        - Action function, run again and again while the task remains in a state
+//        - Test function(s) which determine if task will enter a new state
+//
+//      States may be nested.  A state made with a superstate is a substate of it; the
+//      task is then in both at once, and the superstate's functions run along with the
+//      substate's each scan, outer states first.  A superstate's transition test thus
+//      covers all its substates, so e.g. a fault which may happen in any of a dozen
+//      substates is tested for once.  The first transition test which calls for a
+//      transition wins.  When a transition leaves a superstate, each state which is
+//      left has its Exit() function run, innermost first; each state which is entered
+//      has its Entry() function run in the next scan, outermost first.  A transition
+//      to a superstate goes on into its initial substate, which is the first substate
+//      made unless SetInitialSubState() chooses another.  Superstates must be inserted
+//      into the task like any other state.  A superstate's Action() which isn't
+//      overridden calls Idle(), as a substate's does.
+//
+//      A state may also have a table of guards, each of which compares a variable
+//      with a threshold and names the state to go to if the comparison passes.  The
+//      guards are checked in the order in which they were added, before the transition
+//      test function; the first one which passes makes the transition, and the test
+//      function is only run if none passes.  A state whose transitions are all in its
+//      guard table should call TransitionTestOff() so that its test isn't run at all.
+//
+//      A state which has nothing to do until something happens can say what it waits
+//      for:  a call to its task's TriggerEvent(), new data on the bus for one of its
+//      subscribers, a change in a variable, or a timeout after the state is entered.
+//      The state is then event-only.  After each scan in which it doesn't make a
+//      transition, the task waits, and its Action() and TransitionTest() aren't run
+//      again until one of the events happens.  A sample time task then runs at its
+//      next sample time.  Nested states only wait if all their superstates are
+//      event-only too, and any one of their events wakes the task.
+//
+//      A state may have one timeout, which ends a given time after the task enters
+//      the state.  SetTimeoutTransition() makes the task go to another state then,
+//      in place of that scan's Action() and TransitionTest(); WaitForTimeout() just
+//      wakes an event-only state for a scan.  The state doesn't poll the clock; the
+//      task puts the timeout into its process's timeout queue (see TR4_tque.hpp) and
+//      the process wakes the task when the time comes, even if it's waiting or
+//      between sample times.  A state which does nothing but wait for its timeout
+//      transition should call EventOnlyOn() as well, so that it isn't scanned at all
+//      in the meantime.
+//=====================================================================================
+
+class CState
+    {
+    private:
+        char* Name;                     //  String holds the name of this state
+        int NonOverloadedCount;         //  Count of functions not yet overloaded
+        boolean FirstTimeRun;           //  Is this the first time this state's run?
+        boolean EnteringThisState;      //  True when entering this state
+        int SerialNumber;               //  Number of this state in task's state list
+        boolean DoProfile;              //  True if we are keeping run duration data
+        boolean Sampling;               //  TRUE if this scan's functions are timed
+        int SampleCountdown;            //  Scans until the next one is sampled
+        int Measured;                   //  Which functions were timed this scan
+        ProfileTicks EntryTicks;        //  How long the functions took this scan;
+        ProfileTicks ActionTicks;       //    they're given to the profilers after
+        ProfileTicks TestTicks;         //    the scan so that isn't timed too
+        CExecTimeModel* pExecTime;      //  Simulated time the functions take, if any
+        CProfiler* EntryProfiler;       //  These are the execution time profiler
+        CProfiler* ActionProfiler;      //  objects for the entry, action, and tran-
+        CProfiler* TestProfiler;        //  sition test functions
+        CState* pSuperState;            //  State within which this one is nested
+        CState* pInitialSubState;       //  Substate entered when this one is entered
+        CState** pPath;                 //  States from outermost down to this one
+        int Depth;                      //  How many superstates this state has
+        CState* pInitialLeaf;           //  Innermost state entered with this one
+        TransitionGuard* Guards;        //  Table of guards checked before the test
+        int NumGuards;                  //  Number of guards in the table
+        int GuardArraySize;             //  How many fit before the table must grow
+        boolean DoTest;                 //  TRUE if TransitionTest() is to be run
+        CProfiler* DwellProfiler;       //  Keeps times spent in this state
+        real_time EnteredAt;            //  Time at which the state was last entered
+        boolean EventOnly;              //  TRUE if the state waits for events
+        StateEvent* Events;             //  Subscribers and variables it waits on
+        int NumEvents;                  //  Number of them in the array
+        int EventArraySize;             //  How many fit before the array must grow
+        boolean WaitsForTrigger;        //  TRUE if TriggerEvent() wakes the task
+        CState* pTimeoutTarget;         //  State to go to when time's up, or NULL
+        real_time TimeoutDelay;         //  Time from entry until timeout, or 0
+        real_time TimeoutDeadline;      //  Time at which the timeout ends
+
+        void Configure (const char*, CState*);  //  Constructors call this to set up
+        void RunEntry (ProfileTicks*);  //  These run the entry, action, transition
+        void RunAction (ProfileTicks*); //  test, and exit functions, with profiling
+        CState* RunTest (ProfileTicks*);//  and interrupts enabled, for Schedule()
+        void RunExit (void);            //  and for the task's nested states
+        boolean ProfileThisScan (void); //  Decide whether to time this scan
+        void SaveProfiles (void);       //  Give this scan's times to the profilers
+        StateEvent* AddEvent (void);    //  Make room for one more event
+        void StartWaiting (void);       //  Note variables' values as task waits
+        boolean EventHasFired (boolean);//  Has anything happened to end the wait?
+
+    protected:
+        CTask* pParent;                 //  Pointer to parent task
+
+    public:
+        //  Constructor is given a name for the new state and, for a nested state, the
+        //  superstate within which it's nested
+        CState (const char*);
+        CState (const char*, CState*);
+        virtual ~CState (void);
+
+        //  This function returns a pointer to the state's name, which is in a string
+        const char* GetName (void) { return (Name); }
+
+        //  Entry function is called when the parent task enters this state; Action
+        //  function runs repeatedly while remaining in this state; Transition Test
+        //  function is called at end of every scan and returns the value of a new
+        //  state to be entered next scan (or it returns NULL for no transition).
+        //  Schedule() is the function which calls these functions.
+        virtual void Entry (void);
+        virtual void Action (void);
+        virtual CState* TransitionTest (void);
+        CState* Schedule (void);
+
+        //  Exit function is called when the task leaves this state for one which isn't
+        //  nested in it.  It's only called for nested states and their superstates
+        virtual void Exit (void);
+
+        CState* GetSuperState (void)        //  Find the state within which this one
+            { return (pSuperState); }       //    is nested, or NULL
+        void SetInitialSubState (CState*);  //  Choose substate entered with this one
+        boolean IsWithin (CState*);         //  Is this state the given one or nested
+                                            //    within it?
+
+        //  Add a guard, given the variable, the test, the threshold, and the state to
+        //  go to; and say whether the transition test function runs after the guards
+        void AddGuard (double*, GuardTest, double, CState*);
+        void TransitionTestOn (void) { DoTest = TRUE; }
+        void TransitionTestOff (void) { DoTest = FALSE; }
+
+        //  Make this state event-only, waiting for the given events
+        void WaitForTrigger (void);         //  Task's TriggerEvent() is called
+        void WaitForData (CSubscriber*);    //  Subscriber has new data to read
+        void WaitForSignal (CBasicSignal*); //  Signal has a new value committed
+        void WaitForChange (void*,          //  Variable of the given size changes
+                            unsigned);
+        void WaitForTimeout (real_time);    //  Time passes after state is entered
+        void EventOnlyOn (void)             //  Make state event-only, or let it
+            { EventOnly = TRUE; }           //    be scanned again even though it
+        void EventOnlyOff (void)            //    has events
+            { EventOnly = FALSE; }
+        boolean IsEventOnly (void)          //  Find out if the state waits for
+            { return (EventOnly); }         //    events
+
+        //  Go to the given state if the task is still in this one after the given time
+        void SetTimeoutTransition (real_time, CState*);
+        CState* GetTimeoutTarget (void)     //  Find the state which the timeout
+            { return (pTimeoutTarget); }    //    transition goes to, or NULL
+
+        void SetSampleTime (real_time);     //  Function resets interval between runs
+        real_time GetSampleTime (void);     //  To get sample time of parent task
+        int GetPriority (void);             //  Function gets priority of parent task
+        int GetSerialNumber (void)          //  This function returns the serial num-
+            { return (SerialNumber); }      //    ber of this state in the task's list
+        void SetSerialNumber (int aNumber)  //  The task calls this function to set
+            { SerialNumber = aNumber; }     //    the number of this state in its list
+        void Idle (void);                   //  Parent task idles 'til next sample time
+        void Deactivate (void);             //  Task stops running until re-activated
+        void Reactivate (void);             //  To start a de-activated task up again
+        void SetParent (CTask* aPtr)        //  Function called by the task object to
+            { pParent = aPtr; }             //    set pointer to parent task object
+        void SetExecTime (CExecTimeModel*   //  Say how long the functions take to
+            aModel) { pExecTime = aModel; } //    run on the target, in simulation
+        void ProfileOff (void)              //  Function to turn execution time pro-
+            { DoProfile = FALSE; }          //    filing back off
+        void DumpProfile (FILE*,            //  Function writes information about how
+                            const char*);   //    long state functions took to run
+
+        //  Write histogram tables of run times and latencies to the given files
+        void DumpDurations (const char*, const char*, const char*);
+        void DumpLatencies (const char*, const char*, const char*);
+
+        //  The task keeps track of how long it stays in this state each time it's
+        //  entered, while profiling is on.  These functions set the histogram's bins,
+        //  and write the statistics or the histogram table
+        void SetDwellBins (int, real_time, real_time);
+        void DumpDwellTime (FILE*, const char*);
+        void DumpDwellHistogram (const char*);
+        CProfiler* GetDwellProfiler (void)
+            { return (DwellProfiler); }
+
+        //  Turn execution-time profiling on with default and user-given parameters
+        void ProfileOn (void) { DoProfile = TRUE; }
+        void ProfileOn (int, real_time, real_time);
+
+        //  Save or restore this state in a checkpoint.  The user may override
+        //  CheckpointData() to save and restore the state's own data as well
+        void Checkpoint (CCheckpoint*);
+        virtual void CheckpointData (CCheckpoint*);
+
+    //  The task runs nested states' functions itself, and finds their paths
+    friend class CTask;
+    };
+
+#endif      //  End of multiple-inclusion protection
+
@@ -1,651 +1,1501 @@
-//*************************************************************************************
-//  TR4_task.cpp
-//      This is the implementation file for task object classes.  These objects imple-
-//      ment tasks for the ctl_exec scheduler; the task objects know how (and when)
-//      to run themselves, dump their status, etc. etc.
-//
-//  Tasks and States
-//      Version 3 - when compiled in state-based mode, tasks must be given lists of
-//                  state objects.  States are defined in TR3_stat.hpp/cpp.
-//      Version 4 - tasks may or may not have lists of states.  If you do not use a
-//                  list of states for a given task, you must overload the Run()
-//                  function for that task.  
-//
-//  Copyright (c) 1994-1996, D.M.Auslander and J.R.Ridgely
-//      May be used and distributed for any non-commercial purposes as long as this 
-//      copyright notice is included.  
-//      Original program 11-94 by DMA 
-//      11-21-94  JR   New class structure
-//       1-15-95  JR   Event type tasks added
-//       3-05-95  JR   Scheduler works for food
-//       3-08-95  JR   Added stuff for profiler
-//       5-20-95  JR   Changed to TranRun3 project
-//       6-01-95  JR   Added TaskData pointer and handlers
-//       6-09-95  JR   Removed TaskData pointer; now it's inherited by CStates
-//       8-17-95  JR   Timer Interrupt tasks get multiple scans and must call Idle()
-//       9-02-95  JR   Interrupt protection for task list manipulations
-//       9-18-95  JR   Merged CTL_EXEC code into this file with #if defined's etc.
-//      12-21-96  JR   Changed to TranRun4, to allow mixing of state and task based   
-//*************************************************************************************
-
-#include <dos.h>
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <TranRun4.hpp>
-
-
-//-------------------------------------------------------------------------------------
-//  Task type Names and Status Names:  These arrays of character strings hold some
-//  names corresponding to task types and statuses given above.  These arrays must
-//  match the enumerations, i.e. be in the same order.  They're used in the status
-//  dumping functions.
-
-const char *TaskTypeNames[6] = {"Hardware", "Timer Int.", "Preemptible",
-                                "Sample Time", "Event", "Continuous"};
-const char *TaskStatusNames[6] = {"Idle", "Ready", "Pending", "Running", "Pre-empted",
-                                  "Deactivated"};
-
-
-//=====================================================================================
-//  Class: CTask
-//      Here we implement the basic behavior which is common to all kinds of tasks.
-//      Tasks can run themselves (they know how to check if it's time to do so), give
-//      out pointers to their names, dump their status, and suspend themselves.
-//=====================================================================================
-
-//-------------------------------------------------------------------------------------
-//  Constructor: CTask (Version for timer interrupt type tasks)
-//      A new C++ style task object is created and the fields are filled in.  No task
-//      priority is given, as this is a timer interrupt task which doesn't need it.
-
-CTask::CTask (const char *aName, TaskType aType, real_time aTimeInt) : CBasicList ()
-    {
-    if (aType != TIMER_INT)
-        TR_Exit ("Task \"%s\" constructed with wrong parameters", aName);
-
-    //  Call configure function for the task; give it a null task function pointer 
-    Configure (aName, aType, 0, aTimeInt);
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Constructor: CTask (Version for sample time tasks)
-//      A new task object is created and the fields are filled in with the name, task 
-//      function, etc.  It makes no sense to call this when constructing another type 
-//      of task, as other types don't have priority; if the user tries to, complain.  
-
-CTask::CTask (const char *aName, TaskType aType, int aPriority, real_time aTimeInt)
-    : CBasicList ()
-    {
-    if ((aType != SAMPLE_TIME) && (aType != PREEMPTIBLE))
-        TR_Exit ("Task \"%s\" constructed with wrong parameters", aName);
-
-    //  Call the function which does the work of copying member data, etc.
-    Configure (aName, aType, aPriority, aTimeInt);
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Constructor: CTask (Version for event tasks)
-//      A new task event object is created and the fields are filled in with the name,
-//      task function, etc.  This version must be used for event tasks only.
-
-CTask::CTask (const char *aName, TaskType aType, int aPriority) : CBasicList ()
-    {
-    if (aType != EVENT)
-        TR_Exit ("Task \"%s\" constructed with wrong parameters", aName);
-
-    //  Call the function which does the work of copying member data, etc.
-    Configure (aName, aType, aPriority, (real_time)0.0);
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Constructor: CTask (version for continuous tasks only)
-//      A new task object is created and filled.  Since no timing information is given,
-//      this must be for a continuous task.
-
-CTask::CTask (const char *aName, TaskType aType) : CBasicList ()
-    {
-    if (aType != CONTINUOUS)
-        TR_Exit ("Task \"%s\" constructed with wrong parameters", aName);
-
-    Configure (aName, aType, 0, (real_time)0.0);
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function: Configure
-//      All the task constructors have to copy the member data from argument lists and
-//      allocate some memory, so those functions are performed here.
-
-void CTask::Configure (const char* aName, TaskType aType, int aPriority,
-real_time aTimeInt)
-    {
-    //  Make some space and save the name of this object
-    if ((Name = new char[strlen (aName) + 1]) != NULL)
-        strcpy (Name, aName);
-
-    TheType = aType;                //  Save type of task
-    MyPriority = aPriority;         //  Save priority, which is sort key for task list
-    TimeInterval = aTimeInt;        //  and time interval
-    TimesRun = (long)0;             //  Task hasn't run yet
-    Do_TL_Trace = TRUE;             //  Default is state transition tracing on
-    SerialNumber = -1;              //  Serial number of this task in process: invalid
-    State = 0L;                     //  Set the initial state to 0 (user can override)
-    FirstTimeRun = TRUE;            //  This will be true during the first run only
-    pInitialState = NULL;           //  Don't have an initial state yet
-    pCurrentState = NULL;           //  Nor have we transitioned into any state
-    InsertStateCounter = 0;         //  The first state inserted will be number 0
-
-    //  If this is a preemptible, sample time or event task, its initial status is
-    //  IDLE, waiting for a reason to run.  Otherwise the status is READY.
-    if ((TheType == SAMPLE_TIME) || (TheType == EVENT) || (TheType == TIMER_INT)
-        || (TheType == PREEMPTIBLE))
-        Status = TS_IDLE;
-    else
-        Status = TS_READY;
-
-    //  Set timing tolerance (the time by which a task can run late without problems)
-    TimingTolerance = (double)LATE_TIME_FRACTION * (double)TimeInterval;
-
-    //  The first time to run this task will be a random time between 0 and aTimeInt
-    NextTime = aTimeInt * (real_time)rand () / RAND_MAX;
-
-    //  Create an execution time profiler object; profiling is off by default 
-    RunProfiler = new CProfiler ();
-    DoProfile = FALSE;
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Destructor:  ~CTask
-//      This destructor frees up memory used by the task item.  Since a TranRun3 task
-//      contains a bunch of states, this destructor deletes the states one by one.
-
-CTask::~CTask (void)
-    {
-    //  Delete all states which are under this task
-    for (void* pCur = GetHead (); pCur != NULL; pCur = GetNext ())
-        delete (CState*)(GetCurrent ());
-
-    DELETE_ARRAY Name;                      //  Also delete arrays and objects 
-    delete RunProfiler;
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function: SetSampleTime
-//      Here we change the time interval between task runs.  It will take effect after
-//      the next call to Schedule().  The tolerance is also adjusted.
-
-void CTask::SetSampleTime (real_time aNewTime)
-    {
-    TimeInterval = aNewTime;
-    TimingTolerance = (double)LATE_TIME_FRACTION * (double)TimeInterval;
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function: Schedule
-//      This is the function where the task decides whether or not to execute its Run()
-//      method.  The task checks to see if it's supposed to run at this time (which
-//      depends on the time and on what kind of task it is); if it's time to run, the
-//      Run() method is called.  The task then checks to see if the transition logic
-//      state has changed; if so, it writes state-change information to the transition
-//      logic trace file if the trace file is writeable.
-
-TaskStatus CTask::Schedule (void)
-    {
-    long OldState;                      //  State number before we run Run()
-    real_time BeginTime;                //  Time when Run() function starts
-
-    #if defined (TR_TIME_SIM)           //  If there's no hardware to keep time (as
-        TheTimer->Increment ();         //  in simulation mode), increment time now
-    #endif
-
-    //  If this task is already running or has been pre-empted or deactivated, don't
-    //  start it now; instead, return the state
-    if ((Status == TS_RUNNING) || (Status == TS_PREEMPTED)
-                               || (Status == TS_DEACTIVATED))
-        return (Status);
-
-    //  If the task is of type TIMER_INT or SAMPLE_TIME and if its status is IDLE,
-    //  check to see if it's time to run yet.  If it's time to run again, update
-    //  the next time register; if not, return without running yet
-    if (((TheType == TIMER_INT) || (TheType == SAMPLE_TIME)) && (Status == TS_IDLE)
-        || (TheType == PREEMPTIBLE))
-        {
-        if (GetTimeNowUnprotected () < NextTime)
-            return (TS_IDLE);
-
-        //  Here we check to see if the task has been delayed way too much and missed
-        //  its execution time; if it has, complain and exit
-        if (GetTimeNowUnprotected () > (NextTime + TimingTolerance))
-            {
-            TR_Exit ("Unable to run task \"%s\" on time", Name);
-            return (TS_DEACTIVATED);            //  Here in case function is modified
-            }
-
-        //  The task is going to run, so update status and next-run-time register
-        Status = TS_READY;
-        NextTime += TimeInterval;
-        }
-
-    //  If this is an IDLE event task, don't run.  A non-idle event task, including
-    //  one which has been set to PENDING by TriggerEvent(), will run.
-    if ((TheType == EVENT) && (Status == TS_IDLE))
-        return (TS_IDLE);
-
-    Status = TS_RUNNING;                //  Set status flag to indicate it's going
-
-    //  Saves old T.L. state, record the time, and enable interrupts before Run() runs
-    OldState = State;
-    if (DoProfile)  BeginTime = GetTimeNowUnprotected ();
-    #if defined (TR_THREAD_MULTI)
-        EnableInterrupts ();
-    #endif
-
-    Run ();                             //  Run the task's Run() function
-
-    //  Disable interrupts after running Run()
-    #if defined (TR_THREAD_MULTI)
-        DisableInterrupts ();
-    #endif
-
-    //  If in task-based mode and profiling is on, save the function's run time
-    if (DoProfile)  RunProfiler->SaveData (GetTimeNowUnprotected () - BeginTime);
-
-    //  Do a transition-logic trace
-    if (OldState != State)  TL_TraceLine (this, OldState, State);
-
-    TimesRun++;                         //  Increment count of times we've run
-
-    if (Status == TS_IDLE)              //  If the user has just called Idle() during
-        return (TS_IDLE);               //  this execution, return idle code now
-
-    if (Status == TS_RUNNING)           //  Set status of task which has been running
-        Status = TS_READY;              //  to ready; idle task will remain idle
-
-    return (TS_READY);
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function: Run (Version for state-based TranRun3 scheduler)
-//      This function calls the Entry(), Action(), and/or TransitionTest() functions
-//      associated with the state in which this task is currently running.  If the
-//      user is writing his own task, he'll override this Run() function.
-
-void CTask::Run (void)
-    {
-    CState* pNextState;                     //  Pointer to the next state to be run
-
-    //  If this is very first time to run (or restart), go to specified initial state
-    if (FirstTimeRun == TRUE)
-        {
-        FirstTimeRun = FALSE;               //  Well it's not gonna be true next time
-
-        //  If no initial state has been specified, we can't run; so exit
-        if (pInitialState == NULL)
-            TR_Exit ("No initial state specified for task \"%s\"", Name);
-        //  Else, an initial state was given, so go to its location in the list
-        else
-            pCurrentState = pInitialState;
-        }
-
-    //  Make sure there really is a state to run; if not, complain and exit
-    if (pCurrentState == NULL)
-        {
-        TR_Exit ("No stats or Run() function specified for task \"%s\"", Name);
-        }
-    else
-        {
-        //  The CState::Schedule() method returns a pointer to the next state, or
-        //  NULL if no transition is going to occur this time
-        if ((pNextState = pCurrentState->Schedule ()) != NULL)
-            {
-            //  If transition logic tracing is enabled, write a line in the trace file
-            if (Do_TL_Trace == TRUE)
-                TL_TraceLine (this, pCurrentState, pNextState);
-
-            pCurrentState = pNextState;
-            }
-        }
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function: Idle
-//      This function sets the status of the task to IDLE if it's a pre-emptive task.
-//      If the task's not pre-emptive type, it does nothing, because other types of
-//      tasks run only once per sample time anyway, so idling means nothing to them.
-
-void CTask::Idle (void)
-    {
-    if ((TheType == SAMPLE_TIME) || (TheType == EVENT) || (TheType == TIMER_INT)
-        || (TheType == PREEMPTIBLE))
-        Status = TS_IDLE;
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function: TriggerEvent
-//      This function is used to set the event flag of an event task so that this task 
-//      will run as soon as it gets a chance.  It returns FALSE if everything is OK,
-//      that is the task is an event task and there's no event previously pending.  If 
-//      the task is another type or there was a previously pending event which hasn't 
-//      yet been serviced, this function returns TRUE, meaning there was an error.  
-
-boolean CTask::TriggerEvent (void)
-    {
-    if ((TheType == EVENT) && (Status == TS_IDLE))
-        {
-        Status = TS_PENDING;
-        return (FALSE);
-        }
-    return (TRUE);
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function: Deactivate 
-//      This function suspends the execution of the task until it's activated.  The 
-//      sample time won't make it run; only an Activate() call will.  
-
-void CTask::Deactivate (void)
-    {
-    Status = TS_DEACTIVATED; 
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function: Reactivate 
-//      This function wakes a deactivated task back up so it can continue running.  
-
-void CTask::Reactivate (void)
-    {
-    //  If the task is interrupt or sample time, restart the sample-time counter; 
-    //  otherwise, the task would run many times to make up for the times it missed. 
-    if ((TheType == SAMPLE_TIME) || (TheType == TIMER_INT))
-        {
-        Status = TS_IDLE;
-        NextTime = GetTimeNowUnprotected ();
-        }
-    else
-        Status = TS_READY;              //  Otherwise, it will run as soon as it can
-    }
-
-
-
-//-------------------------------------------------------------------------------------
-//  Function: InsertState
-//      The user will have created a class of state object, deriving his custom class
-//      from class CState.  He also declared a pointer to a state object.  He then
-//      calls this function to add that new state to this task's state list.
-
-void CTask::InsertState (CState *pNew)
-    {
-    //  Call CListObj's method to insert this thing into the list
-    CBasicList::Insert ((void*)pNew, 0);
-    pNew->SetParent (this);
-
-    //  Tell the state what its number in the state list is
-    pNew->SetSerialNumber (++InsertStateCounter);
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function:  SetInitialState
-//      This function must be called by the user to choose the state in which the
-//      scheduler will begin running.  Note that this has nothing to do with the num-
-//      ber of the state in the list.
-
-void CTask::SetInitialState (CState *aState)
-    {
-    pInitialState = (CState *)aState;
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function: DumpConfiguration
-//      This function writes a "configuration dump" for a task.  The idea is that it
-//      writes one line containing task name, type, priority, timing and so on and
-//      puts state names in a column at the right of that line.  This way when the
-//      process asks for a configuration dump, it can get a bunch of task config.
-//      dumps and put them in an easy-to-read matrix.  It does nothing for the task
-//      based CTL_EXEC scheduler, because CTL_EXEC doesn't define state objects.
-
-void CTask::DumpConfiguration (FILE* aFile)
-    {
-    char SampleTimeBuf[32];                 //  Buffer to hold sample time in string
-    char PriorityBuf[8];                    //  This buffer holds task's priority
-
-    //  If task has priority or sample time, make strings containing them; if not,
-    //  just put a " - " there to indicate they're not available or interesting or...
-    if ((TheType == SAMPLE_TIME) || (TheType == EVENT) || (TheType == PREEMPTIBLE))
-        sprintf (PriorityBuf, "%4d", MyPriority);
-    else
-        strcpy (PriorityBuf, "    -");
-
-    if ((TheType == TIMER_INT) || (TheType == SAMPLE_TIME) || (TheType == PREEMPTIBLE))
-        sprintf (SampleTimeBuf, "%9.3lf", (double)TimeInterval);
-    else
-        strcpy (SampleTimeBuf, "  -  ");
-
-    //  Print the stuff.  This includes info for the task and the name of the
-    //  first state in the list (that's what the GetHead() is up to).
-    fprintf (aFile, "\n%-24s %9s %4s  %11s  ", Name, TaskTypeNames[(int)TheType],
-             PriorityBuf, SampleTimeBuf);
-
-    //  Print the list of state names - there are none for task-based scheduling
-    if (GetHead () != NULL)
-        fprintf (aFile, "%-24s\n", ((CState*)GetHead())->GetName ());
-    else
-        fprintf (aFile, "%-24s\n", " - ");
-
-    //  Now look for more states; if they're there put their names under first one
-    CState* pState;
-    while ((pState = (CState *)GetNext ()) != NULL)
-        {
-        fprintf (aFile,
-                 "                                                        %s\n",
-             pState->GetName ());
-        }
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function: DumpStatus
-//      This function sends a status dump for the task to the file object specified in
-//      its argument.  This dump string is intended for diagnostic use.
-
-void CTask::DumpStatus (FILE* aFile)
-    {
-    fprintf (aFile, "        Name: %-18s  Type: %-16s  Time: %lg\n",
-             Name, TaskTypeNames[(int)TheType], (double)GetTimeNowUnprotected ());
-
-    fprintf (aFile, "        Status: %-16s  Runs: %u\n",
-             TaskStatusNames[(int)Status], TimesRun);
-
-    if ((TheType == SAMPLE_TIME) || (TheType == TIMER_INT))
-        fprintf (aFile, "        Sample Time: %-11lg", (double)TimeInterval);
-
-    if ((TheType == SAMPLE_TIME) || (TheType == EVENT))
-        fprintf (aFile, "  Priority: %d", MyPriority);
-
-    fprintf (aFile, "\n\n");
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Functions:  ProfileOn/Off
-//      These functions turn execution-time profiling on or off for this task.  If the
-//      task is using state-based scheduling, they turn profiling on or off for all
-//      the states as well.  The states have ProfileOn()/Off() methods you can use if
-//      you wish to profile just one state.  Note that these functions must be called
-//      AFTER the tasks and states have all been set up. 
-
-void CTask::ProfileOn (void)
-    {
-    //  If the initial state is NULL, this is a task which contains no state objects
-    //  but has a Run() function, so turn profiling for the state on
-    if (pInitialState == NULL)
-        DoProfile = TRUE;
-
-    //  If the initial state isn't null, this task has states; turn their profilers on
-    else
-        {
-        CState* pCur;
-        for (pCur = (CState*)GetHead (); pCur != NULL; pCur = (CState*)GetNext ())
-            pCur->ProfileOn ();
-        }
-    }
-
-void CTask::ProfileOff (void)
-    {
-    //  When turning profiling off, do so for this task and any existing states
-    DoProfile = FALSE;
-    for (CState* pCur = (CState*)GetHead (); pCur != NULL; pCur = (CState*)GetNext ())
-        pCur->ProfileOff ();
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Functions: DumpProfile
-//      These functions write information to the given file about how long the Run()
-//      function of this task took to run.  If there are state objects belonging to
-//      this task, they print information about how long the Entry(), Action(), and
-//      TransitionTest() functions of each state take to run.  If in state-based
-//      scheduling mode, they call the DumpProcess() methods for all the states in
-//      the state list to do so.  The version of this function which takes a file name
-//      is intended to be called by the user program; the one which takes a pointer is
-//      intended to be called by the task list (and above that, the process).  
-
-void CTask::DumpProfile (const char* aFileName)
-    {
-    FILE* aFile;                            //  Handle of the file to which we write
-
-    //  Attempt to open the file.  If it can't be opened, complain and exit
-    if ((aFile = fopen (aFileName, "w")) == NULL)
-        TR_Exit ("Unable to open file \"%s\" for task profile dump", aFileName);
-
-    //  If the file was successfully opened, write to it and close it
-    else
-        {
-        DumpProfile (aFile);
-        fclose (aFile);
-        }
-    }
-
-void CTask::DumpProfile (FILE* aFile)
-    {
-    CState *pCur;                           //  Pointer to the state currently dumping
-    char Header[128];                       //  Place to store header lines for file
-
-    //  If the first state in the list is NULL, this means we're in task based mode,
-    //  so print out the Run() function's timing data
-    if ((pCur = (CState*) GetHead ()) == NULL)
-        {
-        sprintf (Header, "----- Task \"%s\" Run Function ", Name);
-        for (int Index = strlen (Header); Index < PAGE_WIDTH; Index++)
-            strcat (Header, "-");
-        fprintf (aFile, "%s\n", Header);
-        RunProfiler->DumpProfile (aFile);
-        }
-    //  If in state-based mode, do the same state timing information print for the
-    //  states.  Each state will print out Entry(), Action() and Run() information
-    else
-        {
-        while (pCur != NULL)
-            {
-            pCur->DumpProfile (aFile, Name);
-            pCur = (CState*) GetNext ();
-            }
-        }
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function:  DumpDurations
-//      This function causes a file to be printed which contains a table of Run()
-//      function execution times, if the task is in task-based execution mode.
-
-void CTask::DumpDurations (const char* aFileName)
-    {
-    //  Attempt to open the file.  If it can't be opened, complain and exit
-    FILE* aFile;
-    if ((aFile = fopen (aFileName, "w")) == NULL)
-        TR_Exit ("Unable to open file \"%s\" for task run times dump", aFileName);
-
-    //  If the file was successfully opened, write to it and close it
-    else
-        {
-        //  If the initial state's not NULL, there are states so we can't print table
-        if (pInitialState != NULL)
-            {
-            fprintf (aFile, "ERROR!  Task \"%s\" is state based.\n", Name);
-            fprintf (aFile, "        Run() function timing is not available\n");
-            }
-        else
-            RunProfiler->DumpHistogram (aFile);
-            
-        fclose (aFile);
-        }
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Function:  DumpLatencies
-//      This function causes a file to be printed which contains a table of latencies
-//      as seen by the Run() function.  These indicate how long it has been since each
-//      previous run of the Run() function.
-//
-//      OK, there's a little problem in that this function isn't yet implemented.  
-
-void CTask::DumpLatencies (const char* aFileName)
-    {
-    }
-
-
-
-//-------------------------------------------------------------------------------------
-//  Friend function: TL_TraceLine (records pointers for a state-based task)
-//      When the user calls this function, the name and state information for a given
-//      transition are saved by the data logger object.  This information consists of:
-//      - The current time
-//      - A pointer to the process in which the transition occurred
-//      - A pointer to the task
-//      - State from which transition originated
-//      - State to which transition transitioned
-
-void TL_TraceLine (void *pTask, void *aFromState, void *aToState)
-    {
-    if (TheMaster->TraceLogger != NULL)
-        {
-        SaveLoggerData (TheMaster->TraceLogger, (double)GetTimeNowUnprotected (),
-                     TheMaster->GetCurrent (), pTask, aFromState, aToState, -1, -1);
-        }
-    }
-
-
-//-------------------------------------------------------------------------------------
-//  Friend function: TL_TraceLine (records state state numbers for a task-based task)
-//      When the user calls this function, the name and state information for a given
-//      transition are saved by the data logger object.  This information consists of:
-//      - The current time
-//      - A pointer to the process in which the transition occurred
-//      - A pointer to the task
-//      - State from which transition originated
-//      - State to which transition transitioned
-
-void TL_TraceLine (void *pTask, long aFromState, long aToState)
-    {
-    if (TheMaster->TraceLogger != NULL)
-        {
-        SaveLoggerData (TheMaster->TraceLogger, (double)GetTimeNowUnprotected (),
-                  TheMaster->GetCurrent(), pTask, NULL, NULL, aFromState, aToState);
-        }
-    }
-
+//*************************************************************************************
+//  TR4_task.cpp
+//      This is the implementation file for task object classes.  These objects imple-
+//      ment tasks for the ctl_exec scheduler; the task objects know how (and when)
+//      to run themselves, dump their status, etc. etc.
+//
+//  Tasks and States
+//      Version 3 - when compiled in state-based mode, tasks must be given lists of
+//                  state objects.  States are defined in TR3_stat.hpp/cpp.
+//      Version 4 - tasks may or may not have lists of states.  If you do not use a
+//                  list of states for a given task, you must overload the Run()
+//                  function for that task.  
+//
+//  Copyright (c) 1994-1996, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this 
+//      copyright notice is included.  
+//      Original program 11-94 by DMA 
+//      11-21-94  JR   New class structure
+//       1-15-95  JR   Event type tasks added
+//       3-05-95  JR   Scheduler works for food
+//       3-08-95  JR   Added stuff for profiler
+//       5-20-95  JR   Changed to TranRun3 project
+//       6-01-95  JR   Added TaskData pointer and handlers
+//       6-09-95  JR   Removed TaskData pointer; now it's inherited by CStates
+//       8-17-95  JR   Timer Interrupt tasks get multiple scans and must call Idle()
+//       9-02-95  JR   Interrupt protection for task list manipulations
+//       9-18-95  JR   Merged CTL_EXEC code into this file with #if defined's etc.
+//      12-21-96  JR   Changed to TranRun4, to allow mixing of state and task based   
+//*************************************************************************************
+
+#include <dos.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <TranRun4.hpp>
+
+
+//-------------------------------------------------------------------------------------
+//  Task type Names and Status Names:  These arrays of character strings hold some
+//  names corresponding to task types and statuses given above.  These arrays must
+//  match the enumerations, i.e. be in the same order.  They're used in the status
+//  dumping functions.
+
+const char *TaskTypeNames[6] = {"Hardware", "Timer Int.", "Preemptible",
+                                "Sample Time", "Event", "Continuous"};
+const char *TaskStatusNames[7] = {"Idle", "Ready", "Pending", "Running", "Pre-empted",
+                                  "Deactivated", "Waiting"};
+
+
+//=====================================================================================
+//  Class: CTask
+//      Here we implement the basic behavior which is common to all kinds of tasks.
+//      Tasks can run themselves (they know how to check if it's time to do so), give
+//      out pointers to their names, dump their status, and suspend themselves.
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+//  Constructor: CTask (Version for timer interrupt type tasks)
+//      A new C++ style task object is created and the fields are filled in.  No task
+//      priority is given, as this is a timer interrupt task which doesn't need it.
+
+CTask::CTask (const char *aName, TaskType aType, real_time aTimeInt) : CBasicList ()
+    {
+    if (aType != TIMER_INT)
+        TR_Exit ("Task \"%s\" constructed with wrong parameters", aName);
+
+    //  Call configure function for the task; give it a null task function pointer 
+    Configure (aName, aType, 0, aTimeInt);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Constructor: CTask (Version for sample time tasks)
+//      A new task object is created and the fields are filled in with the name, task 
+//      function, etc.  It makes no sense to call this when constructing another type 
+//      of task, as other types don't have priority; if the user tries to, complain.  
+
+CTask::CTask (const char *aName, TaskType aType, int aPriority, real_time aTimeInt)
+    : CBasicList ()
+    {
+    if ((aType != SAMPLE_TIME) && (aType != PREEMPTIBLE))
+        TR_Exit ("Task \"%s\" constructed with wrong parameters", aName);
+
+    //  Call the function which does the work of copying member data, etc.
+    Configure (aName, aType, aPriority, aTimeInt);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Constructor: CTask (Version for event tasks)
+//      A new task event object is created and the fields are filled in with the name,
+//      task function, etc.  This version must be used for event tasks only.
+
+CTask::CTask (const char *aName, TaskType aType, int aPriority) : CBasicList ()
+    {
+    if (aType != EVENT)
+        TR_Exit ("Task \"%s\" constructed with wrong parameters", aName);
+
+    //  Call the function which does the work of copying member data, etc.
+    Configure (aName, aType, aPriority, (real_time)0.0);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Constructor: CTask (version for continuous tasks only)
+//      A new task object is created and filled.  Since no timing information is given,
+//      this must be for a continuous task.
+
+CTask::CTask (const char *aName, TaskType aType) : CBasicList ()
+    {
+    if (aType != CONTINUOUS)
+        TR_Exit ("Task \"%s\" constructed with wrong parameters", aName);
+
+    Configure (aName, aType, 0, (real_time)0.0);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Configure
+//      All the task constructors have to copy the member data from argument lists and
+//      allocate some memory, so those functions are performed here.
+
+void CTask::Configure (const char* aName, TaskType aType, int aPriority,
+real_time aTimeInt)
+    {
+    //  Make some space and save the name of this object
+    if ((Name = new char[strlen (aName) + 1]) != NULL)
+        strcpy (Name, aName);
+
+    TheType = aType;                //  Save type of task
+    MyPriority = aPriority;         //  Save priority, which is sort key for task list
+    TimeInterval = aTimeInt;        //  and time interval
+    TimesRun = (long)0;             //  Task hasn't run yet
+    Do_TL_Trace = TRUE;             //  Default is state transition tracing on
+    SerialNumber = -1;              //  Serial number of this task in process: invalid
+    State = 0L;                     //  Set the initial state to 0 (user can override)
+    FirstTimeRun = TRUE;            //  This will be true during the first run only
+    pInitialState = NULL;           //  Don't have an initial state yet
+    pCurrentState = NULL;           //  Nor have we transitioned into any state
+    InsertStateCounter = 0;         //  The first state inserted will be number 0
+
+    //  If this is a preemptible, sample time or event task, its initial status is
+    //  IDLE, waiting for a reason to run.  Otherwise the status is READY.
+    if ((TheType == SAMPLE_TIME) || (TheType == EVENT) || (TheType == TIMER_INT)
+        || (TheType == PREEMPTIBLE))
+        Status = TS_IDLE;
+    else
+        Status = TS_READY;
+
+    //  Set timing tolerance (the time by which a task can run late without problems)
+    TimingTolerance = (double)LATE_TIME_FRACTION * (double)TimeInterval;
+
+    //  The first time to run this task will be a random time between 0 and aTimeInt.
+    //  The context's own random numbers are used so each simulation is repeatable
+    NextTime = aTimeInt * (real_time)(GetCurrentContext ()->Random ())
+               / (real_time)TR_RANDOM_MAX;
+
+    //  Create an execution time profiler object; profiling is off by default 
+    RunProfiler = new CProfiler ();
+    DoProfile = FALSE;
+
+    //  Run() takes no simulated time, and the task isn't in a process yet
+    pExecTime = NULL;
+    pProcess = NULL;
+
+    //  Processor time is only measured while the master is calibrating
+    DoCalibrate = FALSE;
+    CalibrationCost = (real_time)0.0;
+    CalibrationRuns = 0L;
+
+    //  Nested states' paths are found when the task first runs
+    NestingFound = FALSE;
+    Nested = FALSE;
+    StateTable = NULL;
+    TableSize = 0;
+    CommonLevels = NULL;
+
+    //  The task isn't waiting for events, so it can't have been triggered
+    Triggered = FALSE;
+
+    //  No timeout is running until the task enters a state which has one
+    TimeoutSlot = -1;
+    pTimingState = NULL;
+    TimedOut = FALSE;
+    TimeoutsChanged = FALSE;
+
+    //  Time in states and transitions are only counted while profiling is on
+    DoStatistics = FALSE;
+    TransitionCounts = NULL;
+    CountsSize = 0;
+
+    //  Until told otherwise, a task may share data with any other task
+    Group = 0;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Destructor:  ~CTask
+//      This destructor frees up memory used by the task item.  Since a TranRun3 task
+//      contains a bunch of states, this destructor deletes the states one by one.
+
+CTask::~CTask (void)
+    {
+    //  Take the task's timeout, if any, out of the process's queue
+    if ((TimeoutSlot >= 0) && (pProcess != NULL))
+        pProcess->GetTimeoutQueue ()->Disarm (this);
+
+    //  Delete all states which are under this task
+    for (void* pCur = GetHead (); pCur != NULL; pCur = GetNext ())
+        delete (CState*)(GetCurrent ());
+
+    DELETE_ARRAY Name;                      //  Also delete arrays and objects 
+    DELETE_ARRAY StateTable;
+    DELETE_ARRAY CommonLevels;
+    DELETE_ARRAY TransitionCounts;
+    delete RunProfiler;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: SetSampleTime
+//      Here we change the time interval between task runs.  It will take effect after
+//      the next call to Schedule().  The tolerance is also adjusted.
+
+void CTask::SetSampleTime (real_time aNewTime)
+    {
+    TimeInterval = aNewTime;
+    TimingTolerance = (double)LATE_TIME_FRACTION * (double)TimeInterval;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: SetGroup
+//      This function puts the task into a group for parallel sweeps (see TR4_pswp.hpp).
+//      Tasks which share data, including through the data bus or by triggering each
+//      other, must be in the same group; a task in group 0 may share data with any
+//      other task, so it always runs by itself.  Data passed through signals doesn't
+//      count, as long as each signal is written by only one task.
+
+void CTask::SetGroup (int aGroup)
+    {
+    Group = aGroup;
+
+    if ((pProcess != NULL) && (pProcess->GetParallelSweep () != NULL))
+        pProcess->GetParallelSweep ()->Invalidate ();
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Schedule
+//      This is the function where the task decides whether or not to execute its Run()
+//      method.  The task checks to see if it's supposed to run at this time (which
+//      depends on the time and on what kind of task it is); if it's time to run, the
+//      Run() method is called.  The task then checks to see if the transition logic
+//      state has changed; if so, it writes state-change information to the transition
+//      logic trace file if the trace file is writeable.
+
+TaskStatus CTask::Schedule (void)
+    {
+    long OldState;                      //  State number before we run Run()
+    #if !defined (TR_PROFILE_OFF)
+        ProfileTicks BeginTicks;        //  Profile clock when Run() starts
+    #endif
+    clock_t BeginClock;                 //  Processor time when Run() starts
+
+    //  If this task is already running or has been pre-empted or deactivated, don't
+    //  start it now; instead, return the state
+    if ((Status == TS_RUNNING) || (Status == TS_PREEMPTED)
+                               || (Status == TS_DEACTIVATED))
+        return (Status);
+
+    //  If the task's state is waiting for events, just check for them; a task which
+    //  is still waiting looks idle to the task list
+    if (Status == TS_WAITING)
+        {
+        if (EventHasFired () == FALSE)
+            return (TS_IDLE);
+        StopWaiting ();
+        }
+
+    //  If the task is of type TIMER_INT or SAMPLE_TIME and if its status is IDLE,
+    //  check to see if it's time to run yet.  If it's time to run again, update
+    //  the next time register; if not, return without running yet
+    if (((TheType == TIMER_INT) || (TheType == SAMPLE_TIME)) && (Status == TS_IDLE)
+        || (TheType == PREEMPTIBLE))
+        {
+        if (GetTimeNowUnprotected () < NextTime)
+            return (TS_IDLE);
+
+        //  Here we check to see if the task has been delayed way too much and missed
+        //  its execution time; if it has, complain and exit
+        if (GetTimeNowUnprotected () > (NextTime + TimingTolerance))
+            {
+            TR_Exit ("Unable to run task \"%s\" on time", Name);
+            return (TS_DEACTIVATED);            //  Here in case function is modified
+            }
+
+        //  The task is going to run, so update status and next-run-time register
+        Status = TS_READY;
+        NextTime += TimeInterval;
+        }
+
+    //  If this is an IDLE event task, don't run.  A non-idle event task, including
+    //  one which has been set to PENDING by TriggerEvent(), will run.
+    if ((TheType == EVENT) && (Status == TS_IDLE))
+        return (TS_IDLE);
+
+    Status = TS_RUNNING;                //  Set status flag to indicate it's going
+
+    //  Saves old T.L. state, record the time, and enable interrupts before Run() runs
+    OldState = State;
+    #if !defined (TR_PROFILE_OFF)
+        if (DoProfile)  BeginTicks = ReadProfileClock ();
+    #endif
+    if (DoCalibrate)  BeginClock = clock ();
+    #if defined (TR_THREAD_MULTI)
+        EnableInterrupts ();
+    #endif
+
+    Run ();                             //  Run the task's Run() function
+
+    //  Disable interrupts after running Run()
+    #if defined (TR_THREAD_MULTI)
+        DisableInterrupts ();
+    #endif
+
+    //  After a transition, the process's timeout queue gets the new state's timeout
+    if (TimeoutsChanged == TRUE)
+        ArmTimeout ();
+
+    //  In simulation, Run() takes as long as the execution-time model says
+    #if defined (TR_TIME_SIM)
+        if (pExecTime != NULL)
+            UseTime (pExecTime->Sample ());
+    #endif
+
+    //  If the master is calibrating, add up the processor time which Run() used
+    if (DoCalibrate)
+        {
+        CalibrationCost += (real_time)(clock () - BeginClock) / (real_time)CLOCKS_PER_SEC;
+        CalibrationRuns++;
+        }
+
+    //  If in task-based mode and profiling is on, save the function's run time
+    #if !defined (TR_PROFILE_OFF)
+        if (DoProfile)
+            RunProfiler->SaveData (ProfileTicksToTime (ReadProfileClock () - BeginTicks));
+    #endif
+
+    //  Do a transition-logic trace, and note the transition in the journal if any
+    if (OldState != State)
+        {
+        TL_TraceLine (this, OldState, State);
+        if (TheMaster->GetJournal () != NULL)
+            TheMaster->GetJournal ()->Check (JR_STATE, (long)SerialNumber, State);
+        }
+
+    TimesRun++;                         //  Increment count of times we've run
+
+    if ((Status == TS_IDLE)             //  If the user has just called Idle() during
+        || (Status == TS_WAITING))      //  this execution, or the task has begun to
+        return (TS_IDLE);               //  wait, return idle code now
+
+    if (Status == TS_RUNNING)           //  Set status of task which has been running
+        Status = TS_READY;              //  to ready; idle task will remain idle
+
+    return (TS_READY);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: GetNextRunTime
+//      This function returns the earliest time at which Schedule() could run this
+//      task's function, going by what's in the task right now.  A task which would
+//      run at its very next scan returns zero; one which is waiting for its next
+//      sample time returns that time; and one which won't run until somebody else
+//      triggers or re-activates it returns a very large number.  The master uses this
+//      to find stretches of simulated time in which no task can possibly run.
+
+real_time CTask::GetNextRunTime (void)
+    {
+    //  Tasks which are running, preempted, or asleep won't start from Schedule()
+    if ((Status == TS_RUNNING) || (Status == TS_PREEMPTED)
+                               || (Status == TS_DEACTIVATED))
+        return ((real_time)9E99);
+
+    //  A waiting task whose event has happened is ready now.  Otherwise only its
+    //  timeout, which the process finds in its timeout queue, can wake it; only a
+    //  running task can trigger it or change what it's watching
+    if (Status == TS_WAITING)
+        return ((EventHasFired () == TRUE) ? (real_time)0.0 : (real_time)9E99);
+
+    //  Preemptible tasks and idle timer or sample time tasks wait for NextTime
+    if ((((TheType == TIMER_INT) || (TheType == SAMPLE_TIME)) && (Status == TS_IDLE))
+        || (TheType == PREEMPTIBLE))
+        return (NextTime);
+
+    //  Idle event tasks wait for TriggerEvent(); anything else is ready right now
+    if ((TheType == EVENT) && (Status == TS_IDLE))
+        return ((real_time)9E99);
+
+    return ((real_time)0.0);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Run (Version for state-based TranRun3 scheduler)
+//      This function calls the Entry(), Action(), and/or TransitionTest() functions
+//      associated with the state in which this task is currently running.  If the
+//      user is writing his own task, he'll override this Run() function.
+
+void CTask::Run (void)
+    {
+    CState* pNextState;                     //  Pointer to the next state to be run
+    CState* pState;                         //  The initial state and its superstates
+    real_time Now;                          //  Time of a transition
+
+    //  If any states are nested, find their paths before running any of them
+    if (NestingFound == FALSE)
+        SetUpNesting ();
+
+    //  If this is very first time to run (or restart), go to specified initial state
+    if (FirstTimeRun == TRUE)
+        {
+        FirstTimeRun = FALSE;               //  Well it's not gonna be true next time
+
+        //  If no initial state has been specified, we can't run; so exit
+        if (pInitialState == NULL)
+            TR_Exit ("No initial state specified for task \"%s\"", Name);
+        //  Else, an initial state was given, so go to its location in the list (or
+        //  if it's a superstate, to its initial substate)
+        else
+            {
+            pCurrentState = pInitialState->pInitialLeaf;
+            for (pState = pCurrentState; pState != NULL; pState = pState->pSuperState)
+                pState->EnteredAt = GetTimeNowUnprotected ();
+            StartTimeouts (pCurrentState, NULL);
+            }
+        }
+
+    //  Make sure there really is a state to run; if not, complain and exit
+    if (pCurrentState == NULL)
+        {
+        TR_Exit ("No stats or Run() function specified for task \"%s\"", Name);
+        }
+    else if (Nested == TRUE)
+        RunNested ();
+    else
+        {
+        //  If the state's timeout transition is due, it's made instead of the scan
+        //  (the entry function still runs if the state was just entered).  Otherwise
+        //  CState::Schedule() returns a pointer to the next state, or NULL if no
+        //  transition is going to occur this time
+        pNextState = (TimedOut == TRUE) ? TakeTimeout () : NULL;
+        if (pNextState != NULL)
+            {
+            if (pCurrentState->EnteringThisState == TRUE)
+                pCurrentState->RunEntry (NULL);
+            pCurrentState->EnteringThisState = TRUE;
+            }
+        else
+            pNextState = pCurrentState->Schedule ();
+
+        if (pNextState != NULL)
+            {
+            //  If transition logic tracing is enabled, write a line in the trace file
+            if (Do_TL_Trace == TRUE)
+                TL_TraceLine (this, pCurrentState, pNextState);
+
+            //  If the run is being recorded or replayed, note the transition
+            if (TheMaster->GetJournal () != NULL)
+                TheMaster->GetJournal ()->Check (JR_STATE, (long)SerialNumber,
+                                                 (long)pNextState->GetSerialNumber ());
+
+            //  While profiling, note how long the task was in the old state
+            if (DoStatistics == TRUE)
+                {
+                Now = GetTimeNowUnprotected ();
+                pCurrentState->DwellProfiler->SaveData (Now - pCurrentState->EnteredAt);
+                pNextState->EnteredAt = Now;
+                CountTransition (pCurrentState, pNextState);
+                }
+
+            StartTimeouts (pNextState, NULL);
+            pCurrentState = pNextState;
+            }
+
+        //  If the state is event-only, it waits for its events before running again
+        else if (pCurrentState->EventOnly == TRUE)
+            StartWaiting ();
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: RunNested
+//      When some of the task's states are nested, the current state is always an
+//      innermost one, and this function runs one scan through it and all the states
+//      within which it's nested.  Entry functions of states being entered run first,
+//      then all the action functions, then the transition tests until one calls for a
+//      transition; each group runs from the outermost state in.  On a transition, the
+//      states being left run their exit functions from the innermost out, up to the
+//      innermost state common to both paths; the states being entered, from there
+//      down to the new state's innermost initial substate, are marked to run their
+//      entry functions next scan.  The common level for each pair of states was found
+//      by SetUpNesting(), so no superstate pointers are followed here.  If any of the
+//      states is to be profiled this scan, the profile clock is read once at the
+//      start and once after each function, whichever state it belongs to.
+
+void CTask::RunNested (void)
+    {
+    CState** pPath = pCurrentState->pPath;  //  States from outermost to current one
+    int Depth = pCurrentState->Depth;       //  Index of current state in the path
+    CState* pNextState = NULL;              //  State to which a test says to go
+    CState* pNewState;                      //  Innermost state which will be entered
+    int Common;                             //  Level of innermost state not left
+    int Level;
+    real_time Now;                          //  Time of the transition
+    ProfileTicks* pMark = NULL;             //  Points to last clock reading, if any
+
+    #if defined (TR_PROFILE_TIMING)
+        ProfileTicks Mark;                  //  Profile clock when last function ended
+
+        for (Level = 0; Level <= Depth; Level++)
+            if (pPath[Level]->ProfileThisScan () == TRUE)
+                pMark = &Mark;
+        if (pMark != NULL)
+            Mark = ReadProfileClock ();
+    #endif
+
+    for (Level = 0; Level <= Depth; Level++)
+        if (pPath[Level]->EnteringThisState == TRUE)
+            {
+            pPath[Level]->EnteringThisState = FALSE;
+            pPath[Level]->RunEntry (pMark);
+            }
+
+    //  If the timeout of one of the states has ended, its transition is made in
+    //  place of the actions and tests; a timeout without one just lets them run
+    if (TimedOut == TRUE)
+        pNextState = TakeTimeout ();
+    if (pNextState == NULL)
+        {
+        for (Level = 0; Level <= Depth; Level++)
+            pPath[Level]->RunAction (pMark);
+
+        for (Level = 0; (Level <= Depth) && (pNextState == NULL); Level++)
+            pNextState = pPath[Level]->RunTest (pMark);
+
+        //  In simulation, each state's functions take as long as its model says
+        #if defined (TR_TIME_SIM)
+            for (Level = 0; Level <= Depth; Level++)
+                if (pPath[Level]->pExecTime != NULL)
+                    UseTime (pPath[Level]->pExecTime->Sample ());
+        #endif
+        }
+
+    #if defined (TR_PROFILE_TIMING)
+        if (pMark != NULL)
+            for (Level = 0; Level <= Depth; Level++)
+                pPath[Level]->SaveProfiles ();
+    #endif
+
+    //  If the current state and all its superstates are event-only, wait for events
+    if (pNextState == NULL)
+        {
+        for (Level = 0; Level <= Depth; Level++)
+            if (pPath[Level]->EventOnly == FALSE)
+                return;
+        StartWaiting ();
+        return;
+        }
+
+    if ((pNextState->pParent != this) || (pNextState->pPath == NULL))
+        {
+        TR_Exit ("State \"%s\" isn't in task \"%s\"", pNextState->GetName (), Name);
+        return;
+        }
+
+    //  Leave the states which aren't common to both paths, and mark those which are
+    //  being entered
+    Common = CommonLevels[(pCurrentState->SerialNumber - 1) * TableSize
+                          + pNextState->SerialNumber - 1];
+    for (Level = Depth; Level > Common; Level--)
+        pPath[Level]->RunExit ();
+
+    pNewState = pNextState->pInitialLeaf;
+    for (Level = Common + 1; Level <= pNewState->Depth; Level++)
+        pNewState->pPath[Level]->EnteringThisState = TRUE;
+
+    //  While profiling, note how long the task was in each state it left
+    if (DoStatistics == TRUE)
+        {
+        Now = GetTimeNowUnprotected ();
+        for (Level = Depth; Level > Common; Level--)
+            pPath[Level]->DwellProfiler->SaveData (Now - pPath[Level]->EnteredAt);
+        for (Level = Common + 1; Level <= pNewState->Depth; Level++)
+            pNewState->pPath[Level]->EnteredAt = Now;
+        CountTransition (pCurrentState, pNewState);
+        }
+
+    StartTimeouts (pNewState, (Common >= 0) ? pPath[Common] : NULL);
+
+    //  Trace and journal the transition as for states which aren't nested
+    if (Do_TL_Trace == TRUE)
+        TL_TraceLine (this, pCurrentState, pNewState);
+
+    if (TheMaster->GetJournal () != NULL)
+        TheMaster->GetJournal ()->Check (JR_STATE, (long)SerialNumber,
+                                         (long)pNewState->GetSerialNumber ());
+
+    pCurrentState = pNewState;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: SetUpNesting
+//      This function looks for nested states.  If there are any, it makes each state's
+//      path, the list of states from the outermost one in which it's nested down to
+//      itself, and finds the innermost state entered when each state is entered.  Then
+//      for every pair of states it finds the deepest level at which a transition from
+//      one to the other leaves the paths the same.  That's the level of the innermost
+//      state within which both are nested; but a state isn't counted as nested in
+//      itself, so a transition to a superstate (or from a state to itself) leaves and
+//      re-enters it.  It's -1 if the paths have nothing in common.  The table takes
+//      one int for each pair of states, which is little enough for any machine drawn
+//      by hand.  This is run when the task first runs and after states are inserted.
+
+void CTask::SetUpNesting (void)
+    {
+    CState* pState;                         //  Each state in the task's list
+    CState* pAbove;                         //  Each of a state's superstates
+    CState* pFrom;                          //  States from and to which a transition
+    CState* pTo;                            //    might be made
+    int Index, From, To, Level, Deepest;
+
+    NestingFound = TRUE;
+    Nested = FALSE;
+    DELETE_ARRAY StateTable;
+    DELETE_ARRAY CommonLevels;
+    StateTable = NULL;
+    CommonLevels = NULL;
+
+    for (pState = (CState*)GetHead (); pState != NULL; pState = (CState*)GetNext ())
+        if (pState->pSuperState != NULL)
+            Nested = TRUE;
+    if (Nested == FALSE)
+        return;
+
+    //  Make a table of the states in order of serial number
+    TableSize = InsertStateCounter;
+    StateTable = new CState*[TableSize];
+    CommonLevels = new int[TableSize * TableSize];
+    if ((StateTable == NULL) || (CommonLevels == NULL))
+        {
+        TR_Exit ("Unable to allocate memory for nested states of task \"%s\"", Name);
+        return;
+        }
+    for (pState = (CState*)GetHead (); pState != NULL; pState = (CState*)GetNext ())
+        StateTable[pState->SerialNumber - 1] = pState;
+
+    //  Make each state's path, checking that its superstates are in this task
+    for (Index = 0; Index < TableSize; Index++)
+        {
+        pState = StateTable[Index];
+        pState->Depth = 0;
+        for (pAbove = pState->pSuperState; pAbove != NULL; pAbove = pAbove->pSuperState)
+            {
+            if ((pAbove->pParent != this) || (pState->Depth >= TableSize))
+                {
+                TR_Exit ("Superstates of state \"%s\" aren't all in task \"%s\"",
+                         pState->Name, Name);
+                return;
+                }
+            pState->Depth++;
+            }
+
+        DELETE_ARRAY pState->pPath;
+        pState->pPath = new CState*[pState->Depth + 1];
+        for (Level = pState->Depth, pAbove = pState; pAbove != NULL;
+             Level--, pAbove = pAbove->pSuperState)
+            pState->pPath[Level] = pAbove;
+
+        for (pAbove = pState; pAbove->pInitialSubState != NULL;
+             pAbove = pAbove->pInitialSubState);
+        if (pAbove->pParent != this)
+            {
+            TR_Exit ("Initial substate \"%s\" isn't in task \"%s\"", pAbove->Name, Name);
+            return;
+            }
+        pState->pInitialLeaf = pAbove;
+        }
+
+    //  For each pair, find the deepest level at which the paths are the same, but no
+    //  deeper than the destination's superstate
+    for (From = 0; From < TableSize; From++)
+        for (To = 0; To < TableSize; To++)
+            {
+            pFrom = StateTable[From];
+            pTo = StateTable[To];
+            Deepest = (pFrom->Depth < pTo->Depth - 1) ? pFrom->Depth : pTo->Depth - 1;
+            for (Level = 0; (Level <= Deepest)
+                 && (pFrom->pPath[Level] == pTo->pPath[Level]); Level++);
+            CommonLevels[From * TableSize + To] = Level - 1;
+            }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: StartWaiting
+//      The task's current state is event-only and no transition was made, so the task
+//      waits.  Each of the states it's in notes the values of the variables which it
+//      watches.  Waiting overrides any Idle() the state called.
+
+void CTask::StartWaiting (void)
+    {
+    for (CState* pState = pCurrentState; pState != NULL; pState = pState->pSuperState)
+        pState->StartWaiting ();
+
+    Triggered = FALSE;
+    Status = TS_WAITING;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: EventHasFired
+//      Find out if any event for which the current state or its superstates are
+//      waiting has happened.
+
+boolean CTask::EventHasFired (void)
+    {
+    for (CState* pState = pCurrentState; pState != NULL; pState = pState->pSuperState)
+        if (pState->EventHasFired (Triggered) == TRUE)
+            return (TRUE);
+
+    return (FALSE);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: StopWaiting
+//      One of the events has happened, so the task gets ready to run as it would have
+//      if it had been idle.  An event task runs right away.  A timer interrupt, sample
+//      time, or preemptible task runs at its next sample time; the times it missed
+//      while waiting are skipped, so it keeps to the same phase and isn't late.
+
+void CTask::StopWaiting (void)
+    {
+    real_time Now = GetTimeNowUnprotected ();
+
+    Triggered = FALSE;
+    if ((TheType == SAMPLE_TIME) || (TheType == TIMER_INT) || (TheType == PREEMPTIBLE))
+        {
+        Status = TS_IDLE;
+        if ((NextTime < Now) && (TimeInterval > (real_time)0.0))
+            NextTime += TimeInterval * ceil ((Now - NextTime) / TimeInterval);
+        }
+    else if (TheType == EVENT)
+        Status = TS_PENDING;
+    else
+        Status = TS_READY;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: StartTimeouts
+//      On a transition, each state being entered which has a timeout has its deadline
+//      set, counting from now.  The states entered are the given one and
+//      its superstates, up to but not including the given superstate (or all of them
+//      if it's NULL).  The queue is updated by ArmTimeout() after Run() has finished.
+
+void CTask::StartTimeouts (CState* aEntered, CState* aCommon)
+    {
+    real_time Now = GetTimeNowUnprotected ();
+
+    for (CState* pState = aEntered; pState != aCommon; pState = pState->pSuperState)
+        if (pState->TimeoutDelay > (real_time)0.0)
+            pState->TimeoutDeadline = Now + pState->TimeoutDelay;
+
+    TimeoutsChanged = TRUE;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: ArmTimeout
+//      Find the earliest deadline of the current state and its superstates, and put
+//      it into the process's timeout queue in place of any which was there; if none
+//      of the states has a timeout running, take the task out of the queue.  A
+//      timeout which ended for a state which has since been left is forgotten.
+
+void CTask::ArmTimeout (void)
+    {
+    real_time Due = (real_time)9E99;        //  Earliest deadline found so far
+
+    TimeoutsChanged = FALSE;
+    TimedOut = FALSE;
+    pTimingState = NULL;
+    for (CState* pState = pCurrentState; pState != NULL; pState = pState->pSuperState)
+        if ((pState->TimeoutDelay > (real_time)0.0) && (pState->TimeoutDeadline < Due))
+            {
+            Due = pState->TimeoutDeadline;
+            pTimingState = pState;
+            }
+
+    if (pProcess == NULL)
+        return;
+    if (pTimingState != NULL)
+        pProcess->GetTimeoutQueue ()->Arm (this, Due);
+    else
+        pProcess->GetTimeoutQueue ()->Disarm (this);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: FireTimeout
+//      The process's timeout queue calls this function when the task's timeout has
+//      ended.  The task is made ready to run right away, even if it's waiting for
+//      events or for its next sample time, so that the transition is made on time;
+//      its sample times stay where they were.  A preemptible task still runs only at
+//      its sample times, and a deactivated task makes the transition when it's
+//      reactivated.
+
+void CTask::FireTimeout (void)
+    {
+    TimedOut = TRUE;
+
+    if (Status == TS_WAITING)
+        StopWaiting ();
+    if (Status == TS_IDLE)
+        Status = (TheType == EVENT) ? TS_PENDING : TS_READY;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: TakeTimeout
+//      Run() calls this function when the task's timeout has ended.  The timeout has
+//      done its job, so it won't end again until its state is entered again, and the
+//      queue gets the next one of the other states' timeouts, if any, after Run().
+//      It returns the state to which the timeout transition goes, or NULL if the
+//      timeout was given by WaitForTimeout() and just wakes the state for a scan.
+
+CState* CTask::TakeTimeout (void)
+    {
+    TimedOut = FALSE;
+    if (pTimingState == NULL)
+        return (NULL);
+
+    pTimingState->TimeoutDeadline = (real_time)9E99;
+    TimeoutsChanged = TRUE;
+    return (pTimingState->pTimeoutTarget);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: UseTime
+//      In simulation mode, this function moves the clock ahead by the given time, as
+//      though the task had been busy for that long.  The process runs any tasks which
+//      would preempt this one meanwhile.  It's called for the execution-time models
+//      of the task and its states, and may be called by a task or state which works
+//      out for itself how long it would take.  In other modes it does nothing.
+
+void CTask::UseTime (real_time aTime)
+    {
+    #if defined (TR_TIME_SIM)
+        if (aTime <= (real_time)0.0)
+            return;
+
+        //  Tasks running alongside each other in a parallel sweep share the clock
+        if (GetRunningSweep () != NULL)
+            {
+            TR_Exit ("Task \"%s\" uses simulated time, so it must be in group 0", Name);
+            return;
+            }
+
+        if (pProcess != NULL)
+            pProcess->UseTime (this, aTime);
+        else
+            TheTimer->AdvanceTo (GetTimeNowUnprotected () + aTime);
+    #else
+        (void)aTime;                            //  Not used in this mode
+    #endif
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Idle
+//      This function sets the status of the task to IDLE if it's a pre-emptive task.
+//      If the task's not pre-emptive type, it does nothing, because other types of
+//      tasks run only once per sample time anyway, so idling means nothing to them.
+
+void CTask::Idle (void)
+    {
+    if ((TheType == SAMPLE_TIME) || (TheType == EVENT) || (TheType == TIMER_INT)
+        || (TheType == PREEMPTIBLE))
+        Status = TS_IDLE;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: TriggerEvent
+//      This function is used to set the event flag of an event task so that this task 
+//      will run as soon as it gets a chance.  It returns FALSE if everything is OK,
+//      that is the task is an event task and there's no event previously pending.  If 
+//      the task is another type or there was a previously pending event which hasn't 
+//      yet been serviced, this function returns TRUE, meaning there was an error.  
+
+boolean CTask::TriggerEvent (void)
+    {
+    boolean Result = TRUE;                  //  TRUE unless the event is accepted
+
+    if ((TheType == EVENT) && (Status == TS_IDLE))
+        {
+        Status = TS_PENDING;
+        Result = FALSE;
+        }
+
+    //  A task which is waiting for events notes the trigger; its state decides if it's
+    //  one of the events for which it waits
+    else if (Status == TS_WAITING)
+        {
+        Triggered = TRUE;
+        Result = FALSE;
+        }
+
+    //  If the run is being recorded or replayed, note the event in the journal
+    if (TheMaster->GetJournal () != NULL)
+        TheMaster->GetJournal ()->Check (JR_EVENT, (long)SerialNumber, (long)Result);
+
+    return (Result);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Deactivate 
+//      This function suspends the execution of the task until it's activated.  The 
+//      sample time won't make it run; only an Activate() call will.  
+
+void CTask::Deactivate (void)
+    {
+    Status = TS_DEACTIVATED; 
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: Reactivate 
+//      This function wakes a deactivated task back up so it can continue running.  
+
+void CTask::Reactivate (void)
+    {
+    //  If the task is interrupt or sample time, restart the sample-time counter; 
+    //  otherwise, the task would run many times to make up for the times it missed. 
+    if ((TheType == SAMPLE_TIME) || (TheType == TIMER_INT))
+        {
+        Status = TS_IDLE;
+        NextTime = GetTimeNowUnprotected ();
+        }
+    else
+        Status = TS_READY;              //  Otherwise, it will run as soon as it can
+    }
+
+
+
+//-------------------------------------------------------------------------------------
+//  Function: InsertState
+//      The user will have created a class of state object, deriving his custom class
+//      from class CState.  He also declared a pointer to a state object.  He then
+//      calls this function to add that new state to this task's state list.
+
+void CTask::InsertState (CState *pNew)
+    {
+    //  Call CListObj's method to insert this thing into the list
+    CBasicList::Insert ((void*)pNew, 0);
+    pNew->SetParent (this);
+
+    //  Tell the state what its number in the state list is
+    pNew->SetSerialNumber (++InsertStateCounter);
+
+    //  If the states are nested, their paths will have to be found again
+    NestingFound = FALSE;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  SetInitialState
+//      This function must be called by the user to choose the state in which the
+//      scheduler will begin running.  Note that this has nothing to do with the num-
+//      ber of the state in the list.
+
+void CTask::SetInitialState (CState *aState)
+    {
+    pInitialState = (CState *)aState;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: DumpConfiguration
+//      This function writes a "configuration dump" for a task.  The idea is that it
+//      writes one line containing task name, type, priority, timing and so on and
+//      puts state names in a column at the right of that line.  This way when the
+//      process asks for a configuration dump, it can get a bunch of task config.
+//      dumps and put them in an easy-to-read matrix.  It does nothing for the task
+//      based CTL_EXEC scheduler, because CTL_EXEC doesn't define state objects.
+
+void CTask::DumpConfiguration (FILE* aFile)
+    {
+    char SampleTimeBuf[32];                 //  Buffer to hold sample time in string
+    char PriorityBuf[8];                    //  This buffer holds task's priority
+
+    //  If task has priority or sample time, make strings containing them; if not,
+    //  just put a " - " there to indicate they're not available or interesting or...
+    if ((TheType == SAMPLE_TIME) || (TheType == EVENT) || (TheType == PREEMPTIBLE))
+        sprintf (PriorityBuf, "%4d", MyPriority);
+    else
+        strcpy (PriorityBuf, "    -");
+
+    if ((TheType == TIMER_INT) || (TheType == SAMPLE_TIME) || (TheType == PREEMPTIBLE))
+        sprintf (SampleTimeBuf, "%9.3lf", (double)TimeInterval);
+    else
+        strcpy (SampleTimeBuf, "  -  ");
+
+    //  Print the stuff.  This includes info for the task and the name of the
+    //  first state in the list (that's what the GetHead() is up to).
+    fprintf (aFile, "\n%-24s %9s %4s  %11s  ", Name, TaskTypeNames[(int)TheType],
+             PriorityBuf, SampleTimeBuf);
+
+    //  Print the list of state names - there are none for task-based scheduling
+    if (GetHead () != NULL)
+        fprintf (aFile, "%-24s\n", ((CState*)GetHead())->GetName ());
+    else
+        fprintf (aFile, "%-24s\n", " - ");
+
+    //  Now look for more states; if they're there put their names under first one
+    CState* pState;
+    while ((pState = (CState *)GetNext ()) != NULL)
+        {
+        fprintf (aFile,
+                 "                                                        %s\n",
+             pState->GetName ());
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function: DumpStatus
+//      This function sends a status dump for the task to the file object specified in
+//      its argument.  This dump string is intended for diagnostic use.
+
+void CTask::DumpStatus (FILE* aFile)
+    {
+    fprintf (aFile, "        Name: %-18s  Type: %-16s  Time: %lg\n",
+             Name, TaskTypeNames[(int)TheType], (double)GetTimeNowUnprotected ());
+
+    fprintf (aFile, "        Status: %-16s  Runs: %u\n",
+             TaskStatusNames[(int)Status], TimesRun);
+
+    if ((TheType == SAMPLE_TIME) || (TheType == TIMER_INT))
+        fprintf (aFile, "        Sample Time: %-11lg", (double)TimeInterval);
+
+    if ((TheType == SAMPLE_TIME) || (TheType == EVENT))
+        fprintf (aFile, "  Priority: %d", MyPriority);
+
+    fprintf (aFile, "\n\n");
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Functions:  ProfileOn/Off
+//      These functions turn execution-time profiling on or off for this task.  If the
+//      task is using state-based scheduling, they turn profiling on or off for all
+//      the states as well.  The states have ProfileOn()/Off() methods you can use if
+//      you wish to profile just one state.  Note that these functions must be called
+//      AFTER the tasks and states have all been set up. 
+
+void CTask::ProfileOn (void)
+    {
+    //  If the initial state is NULL, this is a task which contains no state objects
+    //  but has a Run() function, so turn profiling for the state on
+    if (pInitialState == NULL)
+        DoProfile = TRUE;
+
+    //  If the initial state isn't null, this task has states; turn their profilers on
+    else
+        {
+        CState* pCur;
+        for (pCur = (CState*)GetHead (); pCur != NULL; pCur = (CState*)GetNext ())
+            pCur->ProfileOn ();
+        DoStatistics = TRUE;
+        }
+    }
+
+void CTask::ProfileOff (void)
+    {
+    //  When turning profiling off, do so for this task and any existing states
+    DoProfile = FALSE;
+    DoStatistics = FALSE;
+    for (CState* pCur = (CState*)GetHead (); pCur != NULL; pCur = (CState*)GetNext ())
+        pCur->ProfileOff ();
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  CountTransition
+//      Add one to the count of transitions from one state to another.  The counts are
+//      kept in a square table, by serial number, which is made when the first count
+//      is made and made bigger if states are inserted after that.
+
+void CTask::CountTransition (CState* aFrom, CState* aTo)
+    {
+    long* NewCounts;                        //  A bigger table, when one is needed
+    int NewSize;                            //  and its size
+    int From, To;
+
+    if ((aFrom->SerialNumber > CountsSize) || (aTo->SerialNumber > CountsSize))
+        {
+        NewSize = InsertStateCounter;
+        if ((NewCounts = new long[NewSize * NewSize]) == NULL)
+            {
+            TR_Exit ("Unable to allocate transition counts for task \"%s\"", Name);
+            return;
+            }
+        for (From = 0; From < NewSize; From++)
+            for (To = 0; To < NewSize; To++)
+                NewCounts[From * NewSize + To] = ((From < CountsSize) && (To < CountsSize))
+                    ? TransitionCounts[From * CountsSize + To] : 0L;
+        DELETE_ARRAY TransitionCounts;
+        TransitionCounts = NewCounts;
+        CountsSize = NewSize;
+        }
+
+    TransitionCounts[(aFrom->SerialNumber - 1) * CountsSize + aTo->SerialNumber - 1]++;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  GetTransitionCount
+//      Find how many transitions the task has made from one state to another while
+//      profiling was on.
+
+long CTask::GetTransitionCount (CState* aFrom, CState* aTo)
+    {
+    if ((aFrom->SerialNumber > CountsSize) || (aTo->SerialNumber > CountsSize)
+        || (aFrom->SerialNumber < 1) || (aTo->SerialNumber < 1))
+        return (0L);
+
+    return (TransitionCounts[(aFrom->SerialNumber - 1) * CountsSize
+                             + aTo->SerialNumber - 1]);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  DumpStatistics
+//      This function writes how long the task stayed in each of its states and how
+//      many times it went from each state to each other one, as measured while
+//      profiling was on.  Only pairs of states between which transitions were made
+//      are listed.  A task with no states writes nothing.
+
+void CTask::DumpStatistics (FILE* aFile)
+    {
+    CState* pFrom;                          //  Each state in the list
+    char Header[128];
+    int From, To;
+
+    if ((pFrom = (CState*)GetHead ()) == NULL)
+        return;
+
+    for ( ; pFrom != NULL; pFrom = (CState*)GetNext ())
+        pFrom->DumpDwellTime (aFile, Name);
+
+    sprintf (Header, "----- Task \"%s\" Transitions ", Name);
+    for (int Index = strlen (Header); Index < PAGE_WIDTH; Index++)
+        strcat (Header, "-");
+    fprintf (aFile, "%s\n", Header);
+
+    for (From = 0; From < CountsSize; From++)
+        for (To = 0; To < CountsSize; To++)
+            if (TransitionCounts[From * CountsSize + To] != 0L)
+                fprintf (aFile, "%-24s -> %-24s %10ld\n",
+                         FindState (From + 1)->GetName (), FindState (To + 1)->GetName (),
+                         TransitionCounts[From * CountsSize + To]);
+    fprintf (aFile, "\n");
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  CalibrateOn
+//      The master calls this function when it starts calibrating the simulated clock.
+//      From then until CalibrateOff(), the processor time used by each run of this
+//      task is measured.  The clock() function is used, as it works the same way on
+//      every system; its resolution is poor, but over many runs the errors average out.
+
+void CTask::CalibrateOn (void)
+    {
+    DoCalibrate = TRUE;
+    CalibrationCost = (real_time)0.0;
+    CalibrationRuns = 0L;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  CalibratedLoad
+//      After calibration, this function works out what share of the target's processor
+//      this task would use.  It's given the simulated time which the calibration took
+//      and the number of times slower the target is than this computer.  Continuous
+//      tasks soak up whatever time is left over, so they don't count.  If a run of the
+//      task would take longer than its sample time on the target, the task can never
+//      keep up, and the user is warned.
+
+real_time CTask::CalibratedLoad (real_time aTime, double aSlowdown)
+    {
+    real_time RunCost;                      //  Time each run would take on the target
+
+    if ((TheType == CONTINUOUS) || (CalibrationRuns == 0L) || (aTime <= (real_time)0.0))
+        return ((real_time)0.0);
+
+    RunCost = CalibrationCost * (real_time)aSlowdown / (real_time)CalibrationRuns;
+    if ((TheType != EVENT) && (RunCost > TimeInterval))
+        TR_Message ("Warning:  Task \"%s\" would take %g sec to run on the target, "
+                    "longer than its sample time of %g sec\n", Name, (double)RunCost,
+                    (double)TimeInterval);
+
+    return (RunCost * (real_time)CalibrationRuns / aTime);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Functions: DumpProfile
+//      These functions write information to the given file about how long the Run()
+//      function of this task took to run.  If there are state objects belonging to
+//      this task, they print information about how long the Entry(), Action(), and
+//      TransitionTest() functions of each state take to run.  If in state-based
+//      scheduling mode, they call the DumpProcess() methods for all the states in
+//      the state list to do so.  The version of this function which takes a file name
+//      is intended to be called by the user program; the one which takes a pointer is
+//      intended to be called by the task list (and above that, the process).  
+
+void CTask::DumpProfile (const char* aFileName)
+    {
+    FILE* aFile;                            //  Handle of the file to which we write
+
+    //  Attempt to open the file.  If it can't be opened, complain and exit
+    if ((aFile = fopen (aFileName, "w")) == NULL)
+        TR_Exit ("Unable to open file \"%s\" for task profile dump", aFileName);
+
+    //  If the file was successfully opened, write to it and close it
+    else
+        {
+        DumpProfile (aFile);
+        fclose (aFile);
+        }
+    }
+
+void CTask::DumpProfile (FILE* aFile)
+    {
+    CState *pCur;                           //  Pointer to the state currently dumping
+    char Header[128];                       //  Place to store header lines for file
+
+    //  If the first state in the list is NULL, this means we're in task based mode,
+    //  so print out the Run() function's timing data
+    if ((pCur = (CState*) GetHead ()) == NULL)
+        {
+        sprintf (Header, "----- Task \"%s\" Run Function ", Name);
+        for (int Index = strlen (Header); Index < PAGE_WIDTH; Index++)
+            strcat (Header, "-");
+        fprintf (aFile, "%s\n", Header);
+        RunProfiler->DumpProfile (aFile);
+        }
+    //  If in state-based mode, do the same state timing information print for the
+    //  states.  Each state will print out Entry(), Action() and Run() information
+    else
+        {
+        while (pCur != NULL)
+            {
+            pCur->DumpProfile (aFile, Name);
+            pCur = (CState*) GetNext ();
+            }
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  DumpDurations
+//      This function causes a file to be printed which contains a table of Run()
+//      function execution times, if the task is in task-based execution mode.
+
+void CTask::DumpDurations (const char* aFileName)
+    {
+    //  Attempt to open the file.  If it can't be opened, complain and exit
+    FILE* aFile;
+    if ((aFile = fopen (aFileName, "w")) == NULL)
+        TR_Exit ("Unable to open file \"%s\" for task run times dump", aFileName);
+
+    //  If the file was successfully opened, write to it and close it
+    else
+        {
+        //  If the initial state's not NULL, there are states so we can't print table
+        if (pInitialState != NULL)
+            {
+            fprintf (aFile, "ERROR!  Task \"%s\" is state based.\n", Name);
+            fprintf (aFile, "        Run() function timing is not available\n");
+            }
+        else
+            RunProfiler->DumpHistogram (aFile);
+            
+        fclose (aFile);
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  DumpLatencies
+//      This function causes a file to be printed which contains a table of latencies
+//      as seen by the Run() function.  These indicate how long it has been since each
+//      previous run of the Run() function.
+//
+//      OK, there's a little problem in that this function isn't yet implemented.  
+
+void CTask::DumpLatencies (const char* aFileName)
+    {
+    }
+
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  FindState
+//      This function returns a pointer to the state in this task's list which has the
+//      given serial number, or NULL if there's no such state.
+
+CState* CTask::FindState (int aNumber)
+    {
+    CState* pState;
+
+    for (pState = (CState*)GetHead (); pState != NULL; pState = (CState*)GetNext ())
+        if (pState->GetSerialNumber () == aNumber)
+            return (pState);
+
+    return (NULL);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  Checkpoint
+//      This function saves everything the scheduler knows about the task in a check-
+//      point, or restores it:  status, timing, the number of times run, the current
+//      state (saved as its serial number), and the profiler's data.  Then each state
+//      is saved or restored, and finally the task's own data, if the user's task
+//      class overrides CheckpointData().
+
+void CTask::Checkpoint (CCheckpoint* aCheckpoint)
+    {
+    CState* pState;                         //  Each state in the task's list
+    int StateNumber;                        //  Serial number of the current state
+    int SavedSize;                          //  Size of table of transition counts
+    boolean Armed;                          //  TRUE if a timeout is in the queue
+
+
+    aCheckpoint->Name (Name);
+    aCheckpoint->Data (&Status, sizeof (TaskStatus));
+    aCheckpoint->Data (&TimeInterval, sizeof (real_time));
+    aCheckpoint->Data (&NextTime, sizeof (real_time));
+    aCheckpoint->Data (&TimingTolerance, sizeof (double));
+    aCheckpoint->Data (&TimesRun, sizeof (long));
+    aCheckpoint->Data (&FirstTimeRun, sizeof (boolean));
+    aCheckpoint->Data (&State, sizeof (long));
+
+    //  A pointer to the current state means nothing in another run of the program,
+    //  so the state's serial number is saved and the state is found from that
+    StateNumber = (pCurrentState == NULL) ? -1 : pCurrentState->GetSerialNumber ();
+    aCheckpoint->Data (&StateNumber, sizeof (int));
+    if (aCheckpoint->Restoring () == TRUE)
+        {
+        pCurrentState = FindState (StateNumber);
+        if ((pCurrentState == NULL) && (StateNumber != -1))
+            TR_Exit ("Task \"%s\" has no state number %d to restore", Name, StateNumber);
+        }
+
+    RunProfiler->Checkpoint (aCheckpoint);
+
+    //  The table of transition counts may have been made in this run and not the
+    //  other, so its size is saved and it's made again to match when restoring
+    aCheckpoint->Data (&Triggered, sizeof (boolean));
+    aCheckpoint->Data (&DoStatistics, sizeof (boolean));
+    SavedSize = CountsSize;
+    aCheckpoint->Data (&SavedSize, sizeof (int));
+    if ((aCheckpoint->Restoring () == TRUE) && (SavedSize != CountsSize))
+        {
+        DELETE_ARRAY TransitionCounts;
+        TransitionCounts = (SavedSize > 0) ? new long[SavedSize * SavedSize] : NULL;
+        CountsSize = SavedSize;
+        }
+    if (CountsSize > 0)
+        aCheckpoint->Data (TransitionCounts, CountsSize * CountsSize * sizeof (long));
+
+    //  The timeout queue holds pointers, so it isn't saved; the state whose timeout
+    //  is running is saved by number and the task puts its timeout back into the
+    //  queue once the states' deadlines have been restored
+    aCheckpoint->Data (&TimedOut, sizeof (boolean));
+    aCheckpoint->Data (&TimeoutsChanged, sizeof (boolean));
+    StateNumber = (pTimingState == NULL) ? -1 : pTimingState->GetSerialNumber ();
+    aCheckpoint->Data (&StateNumber, sizeof (int));
+    Armed = (TimeoutSlot >= 0) ? TRUE : FALSE;
+    aCheckpoint->Data (&Armed, sizeof (boolean));
+
+    aCheckpoint->Count (HowMany (), "states");
+    for (pState = (CState*)GetHead (); pState != NULL; pState = (CState*)GetNext ())
+        pState->Checkpoint (aCheckpoint);
+
+    if (aCheckpoint->Restoring () == TRUE)
+        {
+        pTimingState = FindState (StateNumber);
+        if (pProcess == NULL)
+            ;
+        else if ((Armed == TRUE) && (pTimingState != NULL))
+            pProcess->GetTimeoutQueue ()->Arm (this, pTimingState->TimeoutDeadline);
+        else
+            pProcess->GetTimeoutQueue ()->Disarm (this);
+        }
+
+    CheckpointData (aCheckpoint);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  CheckpointData
+//      A user's task which keeps data of its own should override this function and
+//      pass each item to the checkpoint's Data() function.  This version does nothing.
+
+void CTask::CheckpointData (CCheckpoint*)
+    {
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Friend function: TL_TraceLine (records pointers for a state-based task)
+//      When the user calls this function, the name and state information for a given
+//      transition are saved by the data logger object.  This information consists of:
+//      - The current time
+//      - A pointer to the process in which the transition occurred
+//      - A pointer to the task
+//      - State from which transition originated
+//      - State to which transition transitioned
+
+void TL_TraceLine (void *pTask, void *aFromState, void *aToState)
+    {
+    //  In parallel simulation, the process saves the line; the master logs it later
+    #if defined (TR_TIME_EXTSIM)
+        if (GetRunningProcess () != NULL)
+            {
+            GetRunningProcess ()->SaveTraceLine (pTask, aFromState, aToState, -1, -1);
+            return;
+            }
+    #endif
+
+    //  In a parallel sweep, the thread saves the line; the sweep logs it in order
+    #if defined (TR_PARALLEL_SWEEP)
+        if (SaveSweepTraceLine (pTask, aFromState, aToState, -1, -1) == TRUE)
+            return;
+    #endif
+
+    if (TheMaster->TraceLogger != NULL)
+        {
+        SaveLoggerData (TheMaster->TraceLogger, (double)GetTimeNowUnprotected (),
+                     TheMaster->GetCurrent (), pTask, aFromState, aToState, -1, -1);
+        }
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Friend function: TL_TraceLine (records state state numbers for a task-based task)
+//      When the user calls this function, the name and state information for a given
+//      transition are saved by the data logger object.  This information consists of:
+//      - The current time
+//      - A pointer to the process in which the transition occurred
+//      - A pointer to the task
+//      - State from which transition originated
+//      - State to which transition transitioned
+
+void TL_TraceLine (void *pTask, long aFromState, long aToState)
+    {
+    #if defined (TR_TIME_EXTSIM)
+        if (GetRunningProcess () != NULL)
+            {
+            GetRunningProcess ()->SaveTraceLine (pTask, NULL, NULL, aFromState,
+                                                 aToState);
+            return;
+            }
+    #endif
+
+    #if defined (TR_PARALLEL_SWEEP)
+        if (SaveSweepTraceLine (pTask, NULL, NULL, aFromState, aToState) == TRUE)
+            return;
+    #endif
+
+    if (TheMaster->TraceLogger != NULL)
+        {
+        SaveLoggerData (TheMaster->TraceLogger, (double)GetTimeNowUnprotected (),
+                  TheMaster->GetCurrent(), pTask, NULL, NULL, aFromState, aToState);
+        }
+    }
+
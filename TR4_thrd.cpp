@@ -0,0 +1,307 @@
+//*************************************************************************************
+//  TR4_thrd.cpp
+//      This file contains the implementation of the thread, mutex, and barrier
+//      classes used by the parallel external-simulation mode.  Each class has a
+//      Win32 version, a POSIX version, and a do-nothing version for systems which
+//      have no threads; see TR4_thrd.hpp for how the version is chosen.
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//*************************************************************************************
+
+#if defined (__WIN32__)
+    #include <windows.h>                //  For threads, critical sections, semaphores
+#endif
+
+#include <stdlib.h>
+#include <TranRun4.hpp>
+
+#if defined (TR_POSIX_THREADS)
+    #include <pthread.h>
+#endif
+
+
+//-------------------------------------------------------------------------------------
+//  Operating-system data
+//      The header file keeps the operating system's objects behind void pointers so
+//      that every file which includes TranRun4.hpp doesn't need windows.h or
+//      pthread.h.  These structures are what the pointers really point to.
+
+#if defined (__WIN32__)
+    struct TR_BarrierData
+        {
+        CRITICAL_SECTION Lock;              //  Protects the count of waiting threads
+        HANDLE Gate[2];                     //  Semaphores released on alternate phases
+        };
+#endif
+
+#if defined (TR_POSIX_THREADS)
+    struct TR_BarrierData
+        {
+        pthread_mutex_t Lock;               //  Protects the count of waiting threads
+        pthread_cond_t Opened;              //  Signaled when all threads have arrived
+        };
+#endif
+
+
+//=====================================================================================
+//  Class: CMutex
+//      A simple mutual-exclusion lock.
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+//  Constructor and destructor:  CMutex
+//      Create and destroy the operating system's lock object.
+
+CMutex::CMutex (void)
+    {
+    pHandle = NULL;
+
+    #if defined (__WIN32__)
+        pHandle = (void*)(new CRITICAL_SECTION);
+        InitializeCriticalSection ((CRITICAL_SECTION*)pHandle);
+    #elif defined (TR_POSIX_THREADS)
+        pHandle = (void*)(new pthread_mutex_t);
+        pthread_mutex_init ((pthread_mutex_t*)pHandle, NULL);
+    #endif
+    }
+
+CMutex::~CMutex (void)
+    {
+    #if defined (__WIN32__)
+        DeleteCriticalSection ((CRITICAL_SECTION*)pHandle);
+        delete (CRITICAL_SECTION*)pHandle;
+    #elif defined (TR_POSIX_THREADS)
+        pthread_mutex_destroy ((pthread_mutex_t*)pHandle);
+        delete (pthread_mutex_t*)pHandle;
+    #endif
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Functions:  Lock and Unlock
+//      Lock() waits until no other thread holds the mutex, then takes it.  Unlock()
+//      gives it back.  Without threads there's nobody to wait for.
+
+void CMutex::Lock (void)
+    {
+    #if defined (__WIN32__)
+        EnterCriticalSection ((CRITICAL_SECTION*)pHandle);
+    #elif defined (TR_POSIX_THREADS)
+        pthread_mutex_lock ((pthread_mutex_t*)pHandle);
+    #endif
+    }
+
+void CMutex::Unlock (void)
+    {
+    #if defined (__WIN32__)
+        LeaveCriticalSection ((CRITICAL_SECTION*)pHandle);
+    #elif defined (TR_POSIX_THREADS)
+        pthread_mutex_unlock ((pthread_mutex_t*)pHandle);
+    #endif
+    }
+
+
+//=====================================================================================
+//  Class: CBarrier
+//      A reusable barrier.  The last thread to arrive resets the count and opens the
+//      barrier for the others.  The phase number changes each time the barrier
+//      opens, so a fast thread which comes around to wait again can't slip through
+//      on the previous opening.
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+//  Constructor and destructor:  CBarrier
+//      Create and destroy the operating system's signaling objects.  Under Win32 we
+//      use one semaphore for even phases and another for odd ones.
+
+CBarrier::CBarrier (int aThreads)
+    {
+    if (aThreads < 1)
+        TR_Exit ("A barrier needs at least one thread");
+
+    NumThreads = aThreads;
+    Waiting = 0;
+    Phase = 0;
+    pHandle = NULL;
+
+    #if defined (__WIN32__)
+        TR_BarrierData* pData = new TR_BarrierData;
+        InitializeCriticalSection (&(pData->Lock));
+        pData->Gate[0] = CreateSemaphore (NULL, 0, aThreads, NULL);
+        pData->Gate[1] = CreateSemaphore (NULL, 0, aThreads, NULL);
+        pHandle = (void*)pData;
+    #elif defined (TR_POSIX_THREADS)
+        TR_BarrierData* pData = new TR_BarrierData;
+        pthread_mutex_init (&(pData->Lock), NULL);
+        pthread_cond_init (&(pData->Opened), NULL);
+        pHandle = (void*)pData;
+    #endif
+    }
+
+CBarrier::~CBarrier (void)
+    {
+    #if defined (__WIN32__)
+        TR_BarrierData* pData = (TR_BarrierData*)pHandle;
+        CloseHandle (pData->Gate[0]);
+        CloseHandle (pData->Gate[1]);
+        DeleteCriticalSection (&(pData->Lock));
+        delete pData;
+    #elif defined (TR_POSIX_THREADS)
+        TR_BarrierData* pData = (TR_BarrierData*)pHandle;
+        pthread_cond_destroy (&(pData->Opened));
+        pthread_mutex_destroy (&(pData->Lock));
+        delete pData;
+    #endif
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  Wait
+//      Each thread calls this function when it gets to the barrier.  All but the last
+//      one wait; the last one to arrive lets them all go.
+
+void CBarrier::Wait (void)
+    {
+    #if defined (__WIN32__)
+        TR_BarrierData* pData = (TR_BarrierData*)pHandle;
+        int MyPhase;
+
+        EnterCriticalSection (&(pData->Lock));
+        MyPhase = Phase;
+        if (++Waiting == NumThreads)
+            {
+            Waiting = 0;
+            Phase = 1 - Phase;
+            if (NumThreads > 1)
+                ReleaseSemaphore (pData->Gate[MyPhase], NumThreads - 1, NULL);
+            LeaveCriticalSection (&(pData->Lock));
+            }
+        else
+            {
+            LeaveCriticalSection (&(pData->Lock));
+            WaitForSingleObject (pData->Gate[MyPhase], INFINITE);
+            }
+
+    #elif defined (TR_POSIX_THREADS)
+        TR_BarrierData* pData = (TR_BarrierData*)pHandle;
+        int MyPhase;
+
+        pthread_mutex_lock (&(pData->Lock));
+        MyPhase = Phase;
+        if (++Waiting == NumThreads)
+            {
+            Waiting = 0;
+            Phase = 1 - Phase;
+            pthread_cond_broadcast (&(pData->Opened));
+            }
+        else
+            {
+            while (Phase == MyPhase)
+                pthread_cond_wait (&(pData->Opened), &(pData->Lock));
+            }
+        pthread_mutex_unlock (&(pData->Lock));
+    #endif
+    }
+
+
+//=====================================================================================
+//  Class: CThread
+//      A thread which runs one function with one argument.
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+//  Function:  TR_ThreadEntry
+//      The operating system starts a new thread in one of the small functions below,
+//      whose form it dictates; they call this function, which runs the user's one.
+
+void TR_ThreadEntry (CThread* aThread)
+    {
+    aThread->pFunction (aThread->pArgument);
+    }
+
+#if defined (__WIN32__)
+    static DWORD WINAPI Win32ThreadStart (LPVOID aThread)
+        {
+        TR_ThreadEntry ((CThread*)aThread);
+        return (0);
+        }
+#endif
+
+#if defined (TR_POSIX_THREADS)
+    extern "C" void* PosixThreadStart (void* aThread)
+        {
+        TR_ThreadEntry ((CThread*)aThread);
+        return (NULL);
+        }
+#endif
+
+
+//-------------------------------------------------------------------------------------
+//  Constructor and destructor:  CThread
+//      The constructor just saves the function and argument; the thread isn't created
+//      until Start() is called.  The destructor makes sure the thread has finished.
+
+CThread::CThread (TR_ThreadFunction aFunction, void* aArgument)
+    {
+    pFunction = aFunction;
+    pArgument = aArgument;
+    pHandle = NULL;
+    Running = FALSE;
+    }
+
+CThread::~CThread (void)
+    {
+    Join ();
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  Start
+//      This function creates the thread, which begins running the function at once.
+//      If there are no threads on this system, it's an error to try to start one.
+
+void CThread::Start (void)
+    {
+    if (Running == TRUE)
+        return;
+
+    #if defined (__WIN32__)
+        DWORD ThreadID;
+        if ((pHandle = (void*)CreateThread (NULL, 0, Win32ThreadStart, (LPVOID)this,
+                                            0, &ThreadID)) == NULL)
+            TR_Exit ("Unable to create a new thread");
+    #elif defined (TR_POSIX_THREADS)
+        pHandle = (void*)(new pthread_t);
+        if (pthread_create ((pthread_t*)pHandle, NULL, PosixThreadStart, (void*)this))
+            TR_Exit ("Unable to create a new thread");
+    #else
+        TR_Exit ("Threads are not available on this system");
+        return;
+    #endif
+
+    Running = TRUE;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  Join
+//      This function waits until the thread's function has returned, then cleans up.
+
+void CThread::Join (void)
+    {
+    if (Running == FALSE)
+        return;
+
+    #if defined (__WIN32__)
+        WaitForSingleObject ((HANDLE)pHandle, INFINITE);
+        CloseHandle ((HANDLE)pHandle);
+    #elif defined (TR_POSIX_THREADS)
+        pthread_join (*((pthread_t*)pHandle), NULL);
+        delete (pthread_t*)pHandle;
+    #endif
+
+    pHandle = NULL;
+    Running = FALSE;
+    }
@@ -0,0 +1,102 @@
+//*************************************************************************************
+//  TR4_thrd.hpp
+//      This is the header for a few small operating-system thread classes: a thread,
+//      a mutual-exclusion lock, and a barrier.  They are used by the parallel
+//      external-simulation mode (TR_TIME_EXTSIM), which runs each process in its own
+//      thread.  These are real operating-system threads, not the interrupt-driven
+//      "threads" of TR_THREAD_MULTI mode.
+//
+//      Win32 threads are used under Windows 95 and NT.  POSIX threads are used if
+//      TR_POSIX_THREADS is defined (it is by default on Unix systems).  If neither
+//      is available, TR_NO_THREADS is defined; the classes then do nothing, and
+//      anything which would have run in a thread must be run directly instead.
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//*************************************************************************************
+
+#ifndef TR4_THRD_HPP
+    #define  TR4_THRD_HPP                   //  Variable to prevent multiple inclusions
+
+//  Choose which kind of threads we can use
+#if !defined (__WIN32__) && !defined (TR_POSIX_THREADS) && defined (__unix__)
+    #define  TR_POSIX_THREADS
+#endif
+#if !defined (__WIN32__) && !defined (TR_POSIX_THREADS)
+    #define  TR_NO_THREADS
+#endif
+
+//  This is the type of function which is run in a thread; it's given one argument
+typedef void (*TR_ThreadFunction)(void*);
+
+
+//=====================================================================================
+//  Class: CMutex
+//      A mutex protects data which is shared between threads.  Only one thread at a
+//      time can hold the lock; others which call Lock() wait until it's released.
+//=====================================================================================
+
+class CMutex
+    {
+    private:
+        void* pHandle;                      //  Operating system's lock object
+
+    public:
+        CMutex (void);
+        ~CMutex (void);
+
+        void Lock (void);                   //  Wait for and take the lock
+        void Unlock (void);                 //  Release the lock for other threads
+    };
+
+
+//=====================================================================================
+//  Class: CBarrier
+//      A barrier holds back each thread which calls Wait() until the given number of
+//      threads have all called it; then they all go on together.  The barrier can be
+//      used over and over again, as at the end of every time window of a simulation.
+//=====================================================================================
+
+class CBarrier
+    {
+    private:
+        int NumThreads;                     //  How many threads must meet here
+        int Waiting;                        //  How many have arrived so far
+        int Phase;                          //  Changes each time the barrier opens
+        void* pHandle;                      //  Operating system's signaling objects
+
+    public:
+        CBarrier (int);                     //  Constructor is given thread count
+        ~CBarrier (void);
+
+        void Wait (void);                   //  Wait until all threads have arrived
+    };
+
+
+//=====================================================================================
+//  Class: CThread
+//      This class runs a function in a new thread.  The thread starts when Start() is
+//      called and runs until the function returns; Join() waits for it to finish.
+//=====================================================================================
+
+class CThread
+    {
+    private:
+        TR_ThreadFunction pFunction;        //  Function which the thread runs
+        void* pArgument;                    //  Argument given to that function
+        void* pHandle;                      //  Operating system's thread handle
+        boolean Running;                    //  TRUE between Start() and Join()
+
+    public:
+        CThread (TR_ThreadFunction, void*); //  Constructor given function to run
+        ~CThread (void);                    //  Destructor waits for thread to end
+
+        void Start (void);                  //  Create the thread and start it running
+        void Join (void);                   //  Wait until the thread has finished
+
+    //  The operating system calls this function, which calls the user's function
+    friend void TR_ThreadEntry (CThread*);
+    };
+
+#endif      //  End of multiple-inclusion protection
@@ -0,0 +1,237 @@
+//*************************************************************************************
+//  TR4_tque.cpp
+//      This file contains the implementation of the timeout queue, a binary heap of
+//      the times at which tasks' timeout transitions are due.  See TR4_tque.hpp.
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//*************************************************************************************
+
+#include <stdlib.h>
+#include <TranRun4.hpp>
+
+
+//=====================================================================================
+//  Class: CTimeoutQueue
+//      The entries are kept in an array as a binary heap:  the entries after entry N
+//      are entries 2N+1 and 2N+2, and no entry comes before the one above it.  Each
+//      task's TimeoutSlot says where its entry is, or is -1 if it has none.
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+//  Constructor:  CTimeoutQueue
+//      The queue starts out empty.  Memory is allocated when the first timeout is
+//      put in.
+
+CTimeoutQueue::CTimeoutQueue (void)
+    {
+    Entries = NULL;
+    NumEntries = 0;
+    ArraySize = 0;
+    pLock = NULL;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Destructor:  ~CTimeoutQueue
+
+CTimeoutQueue::~CTimeoutQueue (void)
+    {
+    DELETE_ARRAY Entries;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  Earlier
+//      Returns TRUE if the first entry's timeout ends before the second's.  Timeouts
+//      which end together are taken in order of the tasks' serial numbers.
+
+boolean CTimeoutQueue::Earlier (int aFirst, int aSecond)
+    {
+    if (Entries[aFirst].Due != Entries[aSecond].Due)
+        return ((Entries[aFirst].Due < Entries[aSecond].Due) ? TRUE : FALSE);
+
+    return ((Entries[aFirst].Serial < Entries[aSecond].Serial) ? TRUE : FALSE);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  Place
+//      Put an entry into the given slot and tell its task where it is.
+
+void CTimeoutQueue::Place (int aSlot, TimeoutEntry& aEntry)
+    {
+    Entries[aSlot] = aEntry;
+    aEntry.pTask->TimeoutSlot = aSlot;
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  MoveUp
+//      Move the entry in the given slot toward the front of the heap, past the
+//      entries above it whose timeouts end later.
+
+void CTimeoutQueue::MoveUp (int aSlot)
+    {
+    TimeoutEntry Moving = Entries[aSlot];   //  Entry which is being moved
+    int Above;                              //  Slot of the entry above it
+
+    while (aSlot > 0)
+        {
+        Above = (aSlot - 1) / 2;
+        Entries[aSlot] = Moving;
+        if (Earlier (aSlot, Above) == FALSE)
+            break;
+        Place (aSlot, Entries[Above]);
+        aSlot = Above;
+        }
+    Place (aSlot, Moving);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  MoveDown
+//      Move the entry in the given slot toward the back of the heap, past the entries
+//      below it whose timeouts end sooner.
+
+void CTimeoutQueue::MoveDown (int aSlot)
+    {
+    TimeoutEntry Moving = Entries[aSlot];   //  Entry which is being moved
+    int Below;                              //  Slot of the earlier entry below it
+
+    for (;;)
+        {
+        Below = 2 * aSlot + 1;
+        if (Below >= NumEntries)
+            break;
+        if ((Below + 1 < NumEntries) && (Earlier (Below + 1, Below) == TRUE))
+            Below++;
+        Entries[aSlot] = Moving;
+        if (Earlier (Below, aSlot) == FALSE)
+            break;
+        Place (aSlot, Entries[Below]);
+        aSlot = Below;
+        }
+    Place (aSlot, Moving);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Functions:  Arm and Disarm
+//      Arm() puts a task's timeout into the queue, ending at the given time, or moves
+//      it if it's already there.  Disarm() takes it out.  If the queue has been given
+//      a lock, it's held meanwhile.
+
+void CTimeoutQueue::Arm (CTask* aTask, real_time aDue)
+    {
+    if (pLock != NULL)
+        {
+        pLock->Lock ();
+        Put (aTask, aDue);
+        pLock->Unlock ();
+        }
+    else
+        Put (aTask, aDue);
+    }
+
+void CTimeoutQueue::Disarm (CTask* aTask)
+    {
+    if (pLock != NULL)
+        {
+        pLock->Lock ();
+        Take (aTask);
+        pLock->Unlock ();
+        }
+    else
+        Take (aTask);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  Put
+//      Put a task's timeout into the queue, ending at the given time.  If the task
+//      already has a timeout in the queue, it's moved to its new place instead.  The
+//      array is made twice as big when it's full.
+
+void CTimeoutQueue::Put (CTask* aTask, real_time aDue)
+    {
+    int Slot = aTask->TimeoutSlot;          //  Where the task's entry is, or -1
+    real_time OldDue;                       //  Time at which it used to end
+
+    if (Slot >= 0)
+        {
+        OldDue = Entries[Slot].Due;
+        Entries[Slot].Due = aDue;
+        if (aDue < OldDue)
+            MoveUp (Slot);
+        else
+            MoveDown (Slot);
+        return;
+        }
+
+    if (NumEntries >= ArraySize)
+        {
+        int NewSize = (ArraySize < 8) ? 8 : (ArraySize * 2);
+        TimeoutEntry* NewEntries = new TimeoutEntry[NewSize];
+        if (NewEntries == NULL)
+            {
+            TR_Exit ("Unable to allocate memory for %d timeouts", NewSize);
+            return;
+            }
+        for (int Index = 0; Index < NumEntries; Index++)
+            NewEntries[Index] = Entries[Index];
+        DELETE_ARRAY Entries;
+        Entries = NewEntries;
+        ArraySize = NewSize;
+        }
+
+    Slot = NumEntries++;
+    Entries[Slot].Due = aDue;
+    Entries[Slot].Serial = aTask->GetSerialNumber ();
+    Entries[Slot].pTask = aTask;
+    MoveUp (Slot);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  Take
+//      Take a task's timeout out of the queue.  The last entry is put in its place
+//      and moved up or down to where it belongs.
+
+void CTimeoutQueue::Take (CTask* aTask)
+    {
+    int Slot = aTask->TimeoutSlot;          //  Where the task's entry is
+
+    if (Slot < 0)
+        return;
+
+    aTask->TimeoutSlot = -1;
+    if (Slot == --NumEntries)
+        return;
+
+    Place (Slot, Entries[NumEntries]);
+    if ((Slot > 0) && (Earlier (Slot, (Slot - 1) / 2) == TRUE))
+        MoveUp (Slot);
+    else
+        MoveDown (Slot);
+    }
+
+
+//-------------------------------------------------------------------------------------
+//  Function:  FireDue
+//      The process calls this function once per sweep.  Each task whose timeout has
+//      ended by the given time is taken out of the queue and woken, earliest first.
+//      When none has ended, this is one comparison.
+
+void CTimeoutQueue::FireDue (real_time aNow)
+    {
+    CTask* pTask;                           //  Task whose timeout has ended
+
+    while ((NumEntries > 0) && (Entries[0].Due <= aNow))
+        {
+        pTask = Entries[0].pTask;
+        Take (pTask);
+        pTask->FireTimeout ();
+        }
+    }
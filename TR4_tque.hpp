@@ -0,0 +1,78 @@
+//*************************************************************************************
+//  TR4_tque.hpp
+//      This is the header for the timeout queue, which each process uses to run its
+//      states' timeouts.  A state may be given a timeout transition (see
+//      CState::SetTimeoutTransition()):  if the task is still in the state a given
+//      time after entering it, it goes to the given state.  CState::WaitForTimeout()
+//      gives a timeout which just wakes an event-only state.  Rather than have every
+//      such state read the clock on every scan, the task puts the time at which its
+//      earliest timeout ends into its process's queue when it enters a state, and
+//      takes it out when it leaves.  The process looks at the front of the queue once
+//      per sweep, a single comparison, and wakes each task whose time has come.
+//
+//      The queue is a binary heap of entries, one for each task which has a timeout
+//      running, ordered by the time and then by the task's serial number so that
+//      timeouts which end together always fire in the same order.  Each task keeps
+//      the place of its entry in the heap, so it can be moved or taken out without
+//      searching.  Putting in, moving, and taking out an entry all take time which
+//      grows with the logarithm of the number of tasks.
+//
+//      When the process's tasks are run in several threads by a parallel sweep, the
+//      sweep gives the queue a lock which is taken while an entry is put in or out.
+//
+//  Copyright (c) 1994-1997, D.M.Auslander and J.R.Ridgely
+//      May be used and distributed for any non-commercial purposes as long as this
+//      copyright notice is included.
+//*************************************************************************************
+
+#ifndef TR4_TQUE_HPP
+    #define  TR4_TQUE_HPP                   //  Variable to prevent multiple inclusions
+
+//  One entry in the queue:  a task and the time at which its timeout ends
+struct TimeoutEntry
+    {
+    real_time Due;                  //  Time at which the timeout ends
+    int Serial;                     //  Task's serial number, to break ties
+    CTask* pTask;                   //  Task whose state has the timeout
+    };
+
+
+//=====================================================================================
+//  Class: CTimeoutQueue
+//      A queue of timeouts sorted by the time at which they end.  A task has at most
+//      one entry in its process's queue.
+//=====================================================================================
+
+class CTimeoutQueue
+    {
+    private:
+        TimeoutEntry* Entries;              //  The heap; the earliest entry is first
+        int NumEntries;                     //  Number of entries in the heap
+        int ArraySize;                      //  How many fit before it must grow
+        CMutex* pLock;                      //  Lock used by threads, or NULL
+
+        boolean Earlier (int, int);         //  Does one entry come before another?
+        void Place (int, TimeoutEntry&);    //  Put entry into a slot, noting where
+        void MoveUp (int);                  //  Move an entry toward the front
+        void MoveDown (int);                //  Move an entry toward the back
+        void Put (CTask*, real_time);       //  Put entry in or move it, unlocked
+        void Take (CTask*);                 //  Take entry out, unlocked
+
+    public:
+        CTimeoutQueue (void);               //  Constructor makes an empty queue
+        ~CTimeoutQueue (void);              //  Destructor frees the heap's memory
+
+        void Arm (CTask*, real_time);       //  Put a task's timeout in, or move it
+        void Disarm (CTask*);               //  Take a task's timeout out, if it's in
+        void FireDue (real_time);           //  Wake tasks whose timeouts have ended
+        real_time GetNextDue (void)         //  Find when the earliest timeout ends,
+            {                               //    or a very large number if none are
+            return ((NumEntries > 0) ? Entries[0].Due : (real_time)9E99);
+            }
+        int HowMany (void)                  //  Function returns the number of
+            { return (NumEntries); }        //    timeouts which are running
+        void SetLock (CMutex* aLock)        //  Give the queue a lock to use when
+            { pLock = aLock; }              //    tasks run in several threads
+    };
+
+#endif      //  End of multiple-inclusion protection